@@ -9,7 +9,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 01, 2026
- *      Last Modified on:    July 10, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #include "GameLayer.h"
@@ -26,6 +26,9 @@ namespace
 {
 	constexpr int KeyF1 = 290; // Toggle world and surface bounds.
 	constexpr int KeyF6 = 295; // Toggle the in-game debug statistics overlay.
+	constexpr int KeyF7 = 296; // Benchmark the frustum culling kernel from the current view.
+	constexpr int KeyF8 = 297; // Toggle software occlusion culling.
+	constexpr uint32_t CullBenchmarkIterations = 200;
 }
 
 GameLayer::GameLayer()
@@ -128,7 +131,36 @@ bool GameLayer::OnKeyPressed(FuturaLibrary::KeyPressedEvent& event)
 		case KeyF6:
 			m_DebugOverlayState.ShowStats = !m_DebugOverlayState.ShowStats;
 			return false;
+		case KeyF7:
+			RunCullBenchmark();
+			return false;
+		case KeyF8:
+		{
+			FuturaLibrary::OcclusionCullingSettings settings = FuturaLibrary::StaticWorldRenderer::GetOcclusionSettings();
+			settings.Enabled = !settings.Enabled;
+			FuturaLibrary::StaticWorldRenderer::SetOcclusionSettings(settings);
+			return false;
+		}
 		default:
 			return false;
 	}
 }
+
+void GameLayer::RunCullBenchmark()
+{
+	FuturaLibrary::Window& window = FuturaLibrary::Application::Get().GetWindow();
+	const glm::mat4 viewProjection = m_CameraController.GetCamera().GetViewProjectionMatrix(window.GetAspectRatio());
+	const FuturaLibrary::FrustumCullBenchmark benchmark = m_SceneWorld.BenchmarkSurfaceCulling(viewProjection, CullBenchmarkIterations);
+	m_DebugOverlayFrameData.CullBenchmark = benchmark;
+
+	const float testedSurfaces = static_cast<float>(benchmark.Surfaces) * static_cast<float>(benchmark.Iterations);
+	FT_INFO(
+		"Cull benchmark: {0} surfaces x {1} passes, SIMD {2:.1f} surfaces/us, scalar {3:.1f} surfaces/us, {4} visible, {5} mismatches.",
+		benchmark.Surfaces,
+		benchmark.Iterations,
+		benchmark.SimdMicroseconds > 0.0f ? testedSurfaces / benchmark.SimdMicroseconds : 0.0f,
+		benchmark.ScalarMicroseconds > 0.0f ? testedSurfaces / benchmark.ScalarMicroseconds : 0.0f,
+		benchmark.VisibleSurfaces,
+		benchmark.Mismatches
+	);
+}
@@ -9,7 +9,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 01, 2026
- *      Last Modified on:    July 01, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #pragma once
@@ -37,6 +37,7 @@ public:
 
 private:
 	bool OnKeyPressed(FuturaLibrary::KeyPressedEvent& event);
+	void RunCullBenchmark();
 
 	FuturaLibrary::Ref<FuturaLibrary::Material> m_DefaultMaterial;
 	SceneWorld m_SceneWorld;
@@ -5,7 +5,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 10, 2026
- *      Last Modified on:    July 10, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #include "SceneWorld.h"
@@ -15,13 +15,68 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <chrono>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace
 {
+	// Worlds added since the last top-level rebuild are scanned directly until they outnumber this or a quarter of the tree.
+	constexpr uint32_t MinUnindexedWorlds = 4;
+
+	bool BoundsOverlap(const FuturaLibrary::AxisAlignedBounds& a, const FuturaLibrary::AxisAlignedBounds& b)
+	{
+		return a.IsValid && b.IsValid &&
+			a.Min.x <= b.Max.x && a.Max.x >= b.Min.x &&
+			a.Min.y <= b.Max.y && a.Max.y >= b.Min.y &&
+			a.Min.z <= b.Max.z && a.Max.z >= b.Min.z;
+	}
+
+	glm::vec3 TransformPoint(const glm::mat4& transform, const glm::vec3& point)
+	{
+		return glm::vec3(transform * glm::vec4(point, 1.0f));
+	}
+
+	glm::vec3 TransformVector(const glm::mat4& transform, const glm::vec3& vector)
+	{
+		return glm::vec3(transform * glm::vec4(vector, 0.0f));
+	}
+
+	// Normals go through the inverse transpose so they stay perpendicular under non-uniform scale.
+	glm::vec3 TransformNormal(const glm::mat4& inverseTransform, const glm::vec3& normal)
+	{
+		const glm::vec3 transformedNormal = glm::transpose(glm::mat3(inverseTransform)) * normal;
+		const float length = glm::length(transformedNormal);
+		return length > 0.0f ? transformedNormal / length : normal;
+	}
+
+	// Largest factor the transform stretches a unit axis by. Exact for the rotation, translation and
+	// uniform scale that placements use, so a world-space radius maps to the same sphere locally.
+	float GetMaxAxisScale(const glm::mat4& transform)
+	{
+		return std::max(
+			glm::length(glm::vec3(transform[0])),
+			std::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2])))
+		);
+	}
+
+	// Moves a ray with a unit direction into an instance's space and returns how many local units one
+	// world unit along it covers, or 0 when the transform collapses it. Local distances divide by it.
+	float TransformRay(const glm::mat4& inverseTransform, const glm::vec3& origin, const glm::vec3& direction, glm::vec3& localOrigin, glm::vec3& localDirection)
+	{
+		localOrigin = TransformPoint(inverseTransform, origin);
+		localDirection = TransformVector(inverseTransform, direction);
+		const float localScale = glm::length(localDirection);
+		if (localScale <= 0.0f)
+			return 0.0f;
+
+		localDirection /= localScale;
+		return localScale;
+	}
+
 	std::string Trim(const std::string& value)
 	{
 		const size_t first = value.find_first_not_of(" \t\r\n");
@@ -56,6 +111,76 @@ namespace
 		return !stream.fail() && commaA == ',' && commaB == ',';
 	}
 
+	// Reads "x,y,z; x,y,z; ..." into output. Fails without touching output if any entry is malformed.
+	bool ReadVec3List(const std::unordered_map<std::string, std::string>& values, const std::string& key, std::vector<glm::vec3>& output)
+	{
+		const auto value = values.find(key);
+		if (value == values.end())
+			return false;
+
+		std::vector<glm::vec3> entries;
+		std::stringstream listStream(value->second);
+		std::string entry;
+		while (std::getline(listStream, entry, ';'))
+		{
+			if (Trim(entry).empty())
+				continue;
+
+			std::stringstream stream(entry);
+			glm::vec3 vector;
+			char commaA = '\0';
+			char commaB = '\0';
+			stream >> vector.x >> commaA >> vector.y >> commaB >> vector.z;
+			if (stream.fail() || commaA != ',' || commaB != ',')
+				return false;
+
+			entries.push_back(vector);
+		}
+
+		output = std::move(entries);
+		return true;
+	}
+
+	bool ReadBroadPhase(const std::unordered_map<std::string, std::string>& values, const std::string& key, FuturaLibrary::WorldBroadPhase& output)
+	{
+		const auto value = values.find(key);
+		if (value == values.end())
+			return false;
+
+		if (value->second == "grid")
+		{
+			output = FuturaLibrary::WorldBroadPhase::SpatialGrid;
+			return true;
+		}
+		if (value->second == "bvh")
+		{
+			output = FuturaLibrary::WorldBroadPhase::BoundingVolumeHierarchy;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool ReadSwitch(const std::unordered_map<std::string, std::string>& values, const std::string& key, bool& output)
+	{
+		const auto value = values.find(key);
+		if (value == values.end())
+			return false;
+
+		if (value->second == "on" || value->second == "true" || value->second == "1")
+		{
+			output = true;
+			return true;
+		}
+		if (value->second == "off" || value->second == "false" || value->second == "0")
+		{
+			output = false;
+			return true;
+		}
+
+		return false;
+	}
+
 	std::unordered_map<std::string, std::string> LoadKeyValueFile(const std::string& path)
 	{
 		std::unordered_map<std::string, std::string> values;
@@ -94,7 +219,7 @@ bool SceneWorld::LoadPreviewScene(const std::string& scenePath, const FuturaLibr
 {
 	FT_CORE_ASSERT(shader, "SceneWorld preview loading requires a shader!");
 
-	m_StaticWorlds.clear();
+	ClearStaticWorlds();
 
 	const std::string resolvedScenePath = FuturaLibrary::ResourceManager::ResolveAssetPath(scenePath);
 	std::unordered_map<std::string, std::string> values = LoadKeyValueFile(resolvedScenePath);
@@ -116,91 +241,523 @@ bool SceneWorld::LoadPreviewScene(const std::string& scenePath, const FuturaLibr
 	if (!ReadVec3(values, "preview_offset", offset))
 		FT_CORE_WARN("Scene file '{0}' is missing preview_offset. Using 0,0,0.", resolvedScenePath);
 
-	FuturaLibrary::WorldTransform worldTransform;
-	worldTransform.Matrix = glm::mat4(1.0f);
-	worldTransform.Matrix = glm::scale(worldTransform.Matrix, glm::vec3(scale));
-	worldTransform.Matrix = glm::translate(worldTransform.Matrix, offset);
+	FuturaLibrary::StaticWorldSettings worldSettings;
+	if (values.find("collision_broad_phase") != values.end() &&
+		!ReadBroadPhase(values, "collision_broad_phase", worldSettings.BroadPhase))
+		FT_CORE_WARN("Scene file '{0}' has an unknown collision_broad_phase. Expected grid or bvh; using grid.", resolvedScenePath);
+	if (values.find("collision_cell_size") != values.end() &&
+		(!ReadFloat(values, "collision_cell_size", worldSettings.GridCellSize) || worldSettings.GridCellSize < 0.0f))
+	{
+		FT_CORE_WARN("Scene file '{0}' has an invalid collision_cell_size. Sizing the grid from the triangles.", resolvedScenePath);
+		worldSettings.GridCellSize = 0.0f;
+	}
+	if (values.find("collision_weld_tolerance") != values.end() &&
+		(!ReadFloat(values, "collision_weld_tolerance", worldSettings.WeldTolerance) || worldSettings.WeldTolerance < 0.0f))
+	{
+		FT_CORE_WARN("Scene file '{0}' has an invalid collision_weld_tolerance. Using {1}.", resolvedScenePath, FuturaLibrary::StaticWorldSettings().WeldTolerance);
+		worldSettings.WeldTolerance = FuturaLibrary::StaticWorldSettings().WeldTolerance;
+	}
+	if (values.find("collision_simplify_tolerance") != values.end() &&
+		(!ReadFloat(values, "collision_simplify_tolerance", worldSettings.SimplifyTolerance) || worldSettings.SimplifyTolerance < 0.0f))
+	{
+		FT_CORE_WARN("Scene file '{0}' has an invalid collision_simplify_tolerance. Keeping the collision mesh unsimplified.", resolvedScenePath);
+		worldSettings.SimplifyTolerance = 0.0f;
+	}
+	if (values.find("collision_bsp") != values.end() &&
+		!ReadSwitch(values, "collision_bsp", worldSettings.BuildBsp))
+		FT_CORE_WARN("Scene file '{0}' has an unknown collision_bsp. Expected on or off; skipping the BSP.", resolvedScenePath);
+	if (values.find("collision_verify_build") != values.end() &&
+		!ReadSwitch(values, "collision_verify_build", worldSettings.VerifyBuild))
+		FT_CORE_WARN("Scene file '{0}' has an unknown collision_verify_build. Expected on or off; skipping the check.", resolvedScenePath);
+
+	std::vector<glm::vec3> offsets = { offset };
+	std::vector<glm::vec3> instanceOffsets;
+	if (values.find("preview_instance_offsets") != values.end())
+	{
+		if (ReadVec3List(values, "preview_instance_offsets", instanceOffsets))
+			offsets.insert(offsets.end(), instanceOffsets.begin(), instanceOffsets.end());
+		else
+			FT_CORE_WARN("Scene file '{0}' has malformed preview_instance_offsets. Expected x,y,z entries separated by ';'.", resolvedScenePath);
+	}
+
+	// Only the scale is baked into the collision geometry, which keeps the scene's collision tolerances
+	// in world units; every offset then places an instance of that one world.
+	FuturaLibrary::WorldTransform geometryTransform;
+	geometryTransform.Matrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale));
 
 	FuturaLibrary::Ref<FuturaLibrary::Model> model = FuturaLibrary::ResourceManager::LoadModel(modelName->second, modelPath->second, shader);
-	m_StaticWorlds.push_back(FuturaLibrary::StaticWorld::CreateFromModel(model, worldTransform));
+	FuturaLibrary::Ref<FuturaLibrary::StaticWorld> world = FuturaLibrary::StaticWorld::CreateFromModel(model, geometryTransform, worldSettings);
+	for (const glm::vec3& instanceOffset : offsets)
+	{
+		FuturaLibrary::WorldTransform instanceTransform;
+		instanceTransform.Matrix = glm::translate(glm::mat4(1.0f), instanceOffset * scale);
+		AddStaticWorld(world, instanceTransform);
+	}
 	return true;
 }
 
+uint32_t SceneWorld::AddStaticWorld(const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world, const FuturaLibrary::WorldTransform& transform)
+{
+	if (!world)
+		return 0;
+
+	StaticWorldInstance instance;
+	instance.World = world;
+	instance.Transform = transform.Matrix;
+	instance.InverseTransform = glm::inverse(transform.Matrix);
+	instance.IsIdentity = transform.Matrix == glm::mat4(1.0f);
+	instance.Id = m_NextInstanceId++;
+	m_WorldInstances.push_back(instance);
+	m_WorldBounds.push_back(FuturaLibrary::TransformBounds(world->GetWorldBounds(), instance.Transform));
+
+	// Streaming one chunk at a time would otherwise rebuild the tree on every add.
+	const uint32_t unindexedWorldCount = static_cast<uint32_t>(m_WorldInstances.size()) - m_IndexedWorldCount;
+	if (unindexedWorldCount > std::max(MinUnindexedWorlds, m_IndexedWorldCount / 4))
+		RebuildWorldBVH();
+	UpdateAccelerationStats();
+	return instance.Id;
+}
+
+void SceneWorld::RemoveStaticWorldInstance(uint32_t instanceId)
+{
+	const auto slot = std::find_if(m_WorldInstances.begin(), m_WorldInstances.end(), [instanceId](const StaticWorldInstance& instance)
+	{
+		return instance.World && instance.Id == instanceId;
+	});
+	if (slot == m_WorldInstances.end())
+		return;
+
+	const uint32_t slotIndex = static_cast<uint32_t>(slot - m_WorldInstances.begin());
+	RemoveInstanceSlot(slotIndex);
+	UpdateWorldBVHAfterRemoval(slotIndex < m_IndexedWorldCount);
+	UpdateAccelerationStats();
+}
+
+void SceneWorld::RemoveStaticWorld(const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world)
+{
+	if (!world)
+		return;
+
+	bool removedAny = false;
+	bool removedIndexedSlot = false;
+	for (uint32_t slotIndex = 0; slotIndex < m_WorldInstances.size(); slotIndex++)
+	{
+		if (m_WorldInstances[slotIndex].World != world)
+			continue;
+
+		RemoveInstanceSlot(slotIndex);
+		removedAny = true;
+		removedIndexedSlot = removedIndexedSlot || slotIndex < m_IndexedWorldCount;
+	}
+
+	if (!removedAny)
+		return;
+
+	UpdateWorldBVHAfterRemoval(removedIndexedSlot);
+	UpdateAccelerationStats();
+}
+
+void SceneWorld::RemoveInstanceSlot(uint32_t slotIndex)
+{
+	m_WorldInstances[slotIndex].World.reset();
+	m_WorldBounds[slotIndex] = {};
+	m_RemovedWorldCount++;
+}
+
+void SceneWorld::UpdateWorldBVHAfterRemoval(bool removedIndexedSlot)
+{
+	// Once half the slots are empty a rebuild is cheaper than walking the hollow tree.
+	if (m_RemovedWorldCount * 2 > m_WorldInstances.size())
+		RebuildWorldBVH();
+	else if (removedIndexedSlot)
+		m_WorldBVH.Refit(m_WorldBounds);
+}
+
+void SceneWorld::RefitStaticWorlds()
+{
+	// A world that was empty when the tree was built has no leaf, so gaining geometry needs a rebuild.
+	bool needsRebuild = false;
+	for (uint32_t worldIndex = 0; worldIndex < m_WorldInstances.size(); worldIndex++)
+	{
+		const StaticWorldInstance& instance = m_WorldInstances[worldIndex];
+		if (!instance.World)
+			continue;
+
+		// Streaming has settled, so a BSP left stale by Finalize is compiled here instead of by the first query.
+		instance.World->UpdateBsp();
+		const FuturaLibrary::AxisAlignedBounds bounds = FuturaLibrary::TransformBounds(instance.World->GetWorldBounds(), instance.Transform);
+		needsRebuild = needsRebuild || (worldIndex < m_IndexedWorldCount && bounds.IsValid && !m_WorldBounds[worldIndex].IsValid);
+		m_WorldBounds[worldIndex] = bounds;
+	}
+
+	if (needsRebuild)
+		RebuildWorldBVH();
+	else
+		m_WorldBVH.Refit(m_WorldBounds);
+	UpdateAccelerationStats();
+}
+
+void SceneWorld::ClearStaticWorlds()
+{
+	m_WorldInstances.clear();
+	m_WorldBounds.clear();
+	m_WorldBVH.Clear();
+	m_IndexedWorldCount = 0;
+	m_RemovedWorldCount = 0;
+	m_AccelerationStats = {};
+}
+
+void SceneWorld::RebuildWorldBVH()
+{
+	// Compacting keeps the surviving instances in their original order, which batched movement depends on.
+	size_t keptCount = 0;
+	for (size_t worldIndex = 0; worldIndex < m_WorldInstances.size(); worldIndex++)
+	{
+		if (!m_WorldInstances[worldIndex].World)
+			continue;
+
+		m_WorldInstances[keptCount] = m_WorldInstances[worldIndex];
+		m_WorldBounds[keptCount] = m_WorldBounds[worldIndex];
+		keptCount++;
+	}
+	m_WorldInstances.resize(keptCount);
+	m_WorldBounds.resize(keptCount);
+	m_RemovedWorldCount = 0;
+
+	// Every world runs its own broad phase, so one world per leaf keeps the top level as selective as possible.
+	FuturaLibrary::BVHBuildSettings settings;
+	settings.MaxLeafPrimitives = 1;
+	m_WorldBVH.Build(m_WorldBounds, settings);
+	m_IndexedWorldCount = static_cast<uint32_t>(keptCount);
+}
+
+void SceneWorld::QueryWorlds(const FuturaLibrary::AxisAlignedBounds& bounds, std::vector<uint32_t>& worlds) const
+{
+	m_WorldBVH.QueryOverlaps(bounds, worlds);
+	for (uint32_t worldIndex = m_IndexedWorldCount; worldIndex < m_WorldInstances.size(); worldIndex++)
+	{
+		if (BoundsOverlap(m_WorldBounds[worldIndex], bounds))
+			worlds.push_back(worldIndex);
+	}
+
+	worlds.erase(std::remove_if(worlds.begin(), worlds.end(), [this](uint32_t worldIndex)
+	{
+		const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world = m_WorldInstances[worldIndex].World;
+		return !world || !world->HasCollisionMesh();
+	}), worlds.end());
+	std::sort(worlds.begin(), worlds.end());
+}
+
 void SceneWorld::Submit(const FuturaLibrary::Ref<FuturaLibrary::Material>& fallbackMaterial) const
 {
-	for (const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world : m_StaticWorlds)
-		FuturaLibrary::Renderer::Submit(world, fallbackMaterial);
+	m_WorldDraws.clear();
+	for (const StaticWorldInstance& instance : m_WorldInstances)
+	{
+		if (instance.World)
+			m_WorldDraws.push_back({ instance.World, instance.Transform });
+	}
+
+	FuturaLibrary::Renderer::SubmitStaticWorlds(m_WorldDraws, fallbackMaterial);
+	m_WorldDraws.clear();
 }
 
 void SceneWorld::DrawDebug(const FuturaLibrary::DebugWorldDrawSettings& settings) const
 {
-	for (const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world : m_StaticWorlds)
+	for (const StaticWorldInstance& instance : m_WorldInstances)
+	{
+		if (!instance.World)
+			continue;
+
+		FuturaLibrary::DebugRenderer::DrawStaticWorld(*instance.World, settings, instance.Transform);
+	}
+}
+
+FuturaLibrary::FrustumCullBenchmark SceneWorld::BenchmarkSurfaceCulling(const glm::mat4& viewProjection, uint32_t iterations) const
+{
+	FuturaLibrary::FrustumCullBenchmark total;
+	total.Iterations = iterations;
+	for (const StaticWorldInstance& instance : m_WorldInstances)
 	{
-		if (!world)
+		if (!instance.World)
 			continue;
 
-		FuturaLibrary::DebugRenderer::DrawStaticWorld(*world, settings);
+		const FuturaLibrary::Frustum frustum = FuturaLibrary::ExtractFrustum(viewProjection * instance.Transform);
+		const FuturaLibrary::FrustumCullBenchmark benchmark = FuturaLibrary::BenchmarkFrustumCulling(frustum, instance.World->GetSurfaceBounds(), iterations);
+		total.Surfaces += benchmark.Surfaces;
+		total.VisibleSurfaces += benchmark.VisibleSurfaces;
+		total.Mismatches += benchmark.Mismatches;
+		total.SimdMicroseconds += benchmark.SimdMicroseconds;
+		total.ScalarMicroseconds += benchmark.ScalarMicroseconds;
 	}
+
+	return total;
 }
 
 FuturaLibrary::WorldRaycastHit SceneWorld::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
 {
 	FuturaLibrary::WorldRaycastHit closestHit;
-	float closestDistance = maxDistance;
+	if (glm::dot(direction, direction) <= 0.0f)
+		return closestHit;
 
-	for (const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world : m_StaticWorlds)
+	const glm::vec3 rayDirection = glm::normalize(direction);
+	float closestDistance = maxDistance;
+	const auto testWorld = [&](uint32_t worldIndex)
 	{
-		if (!world || !world->HasCollisionMesh())
-			continue;
+		const StaticWorldInstance& instance = m_WorldInstances[worldIndex];
+		if (!instance.World || !instance.World->HasCollisionMesh())
+			return;
+
+		FuturaLibrary::WorldRaycastHit hit;
+		if (instance.IsIdentity)
+		{
+			hit = instance.World->Raycast(origin, rayDirection, closestDistance);
+		}
+		else
+		{
+			glm::vec3 localOrigin;
+			glm::vec3 localDirection;
+			const float localScale = TransformRay(instance.InverseTransform, origin, rayDirection, localOrigin, localDirection);
+			if (localScale <= 0.0f)
+				return;
+
+			hit = instance.World->Raycast(localOrigin, localDirection, closestDistance * localScale);
+			hit.Distance /= localScale;
+			hit.Position = TransformPoint(instance.Transform, hit.Position);
+			hit.Normal = TransformNormal(instance.InverseTransform, hit.Normal);
+		}
 
-		FuturaLibrary::WorldRaycastHit hit = world->Raycast(origin, direction, closestDistance);
 		if (!hit.Hit)
-			continue;
+			return;
 
 		closestHit = hit;
 		closestDistance = hit.Distance;
-	}
+	};
+
+	// Worlds arrive front to back, and shrinking the traversal distance skips every world behind a hit.
+	m_WorldBVH.TraverseRay(origin, rayDirection, closestDistance, [&](uint32_t worldIndex, float& rayDistance)
+	{
+		testWorld(worldIndex);
+		rayDistance = closestDistance;
+		return false;
+	});
+	for (uint32_t worldIndex = m_IndexedWorldCount; worldIndex < m_WorldInstances.size(); worldIndex++)
+		testWorld(worldIndex);
 
 	return closestHit;
 }
 
+bool SceneWorld::Occluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+{
+	// Counters accumulate until the next camera movement query resets the frame's collision stats.
+	if (glm::dot(direction, direction) <= 0.0f)
+		return false;
+
+	const glm::vec3 rayDirection = glm::normalize(direction);
+	const auto testWorld = [&](uint32_t worldIndex)
+	{
+		const StaticWorldInstance& instance = m_WorldInstances[worldIndex];
+		if (!instance.World || !instance.World->HasCollisionMesh())
+			return false;
+
+		m_CollisionStats.CandidateWorlds++;
+		if (instance.IsIdentity)
+			return instance.World->Occluded(origin, rayDirection, maxDistance, &m_CollisionStats);
+
+		glm::vec3 localOrigin;
+		glm::vec3 localDirection;
+		const float localScale = TransformRay(instance.InverseTransform, origin, rayDirection, localOrigin, localDirection);
+		return localScale > 0.0f && instance.World->Occluded(localOrigin, localDirection, maxDistance * localScale, &m_CollisionStats);
+	};
+
+	bool occluded = false;
+	m_WorldBVH.TraverseRay(origin, rayDirection, maxDistance, [&](uint32_t worldIndex, float&)
+	{
+		occluded = testWorld(worldIndex);
+		return occluded;
+	});
+	for (uint32_t worldIndex = m_IndexedWorldCount; !occluded && worldIndex < m_WorldInstances.size(); worldIndex++)
+		occluded = testWorld(worldIndex);
+
+	return occluded;
+}
+
 glm::vec3 SceneWorld::ResolveCameraMovement(const glm::vec3& cameraPosition, const glm::vec3& desiredDelta) const
 {
 	const auto startTime = std::chrono::steady_clock::now();
 	m_CollisionStats = {};
 
-	// minimal: camera position is treated as eye height above a standing AABB; upgrade when player physics owns body state.
-	const glm::vec3 collisionCenter = cameraPosition + glm::vec3(0.0f, -0.8f, 0.0f);
-	const glm::vec3 halfExtents = glm::vec3(0.35f, 0.8f, 0.35f);
-	glm::vec3 resolvedDelta = desiredDelta;
-
-	for (const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world : m_StaticWorlds)
+	// minimal: camera position is treated as eye height above a standing capsule; upgrade when player physics owns body state.
+	// The capsule is 1.6 units tall with a 0.35 radius, so slopes and diagonal walls slide instead of blocking on their bounds.
+	const glm::vec3 cameraCenter = cameraPosition + glm::vec3(0.0f, -0.8f, 0.0f);
+	const float capsuleRadius = 0.35f;
+	const glm::vec3 capsuleHalfSegment = glm::vec3(0.0f, 0.8f - capsuleRadius, 0.0f);
+
+	// Collide and slide: sweep the remaining delta, stop at the earliest contact across every world,
+	// then continue along the contact plane. Each iteration removes one blocked direction, so a few suffice.
+	constexpr int MaxSlideIterations = 4;
+	glm::vec3 collisionCenter = cameraCenter;
+	glm::vec3 remainingDelta = desiredDelta;
+	for (int iteration = 0; iteration < MaxSlideIterations && glm::dot(remainingDelta, remainingDelta) > 0.0f; iteration++)
 	{
-		if (world && world->HasCollisionMesh())
-			resolvedDelta = world->ResolveAABBMovement(collisionCenter, halfExtents, resolvedDelta, &m_CollisionStats);
+		const glm::vec3 capsuleExtent = glm::abs(capsuleHalfSegment) + glm::vec3(capsuleRadius);
+		FuturaLibrary::AxisAlignedBounds sweepBounds;
+		sweepBounds.Min = glm::min(collisionCenter, collisionCenter + remainingDelta) - capsuleExtent;
+		sweepBounds.Max = glm::max(collisionCenter, collisionCenter + remainingDelta) + capsuleExtent;
+		sweepBounds.IsValid = true;
+		QueryWorlds(sweepBounds, m_WorldCandidates);
+		m_CollisionStats.CandidateWorlds += static_cast<uint32_t>(m_WorldCandidates.size());
+
+		FuturaLibrary::WorldSweepHit closestHit;
+		for (uint32_t worldIndex : m_WorldCandidates)
+		{
+			const StaticWorldInstance& instance = m_WorldInstances[worldIndex];
+			if (instance.IsIdentity)
+			{
+				const FuturaLibrary::WorldSweepHit hit = instance.World->SweepCapsule(
+					collisionCenter - capsuleHalfSegment,
+					collisionCenter + capsuleHalfSegment,
+					capsuleRadius,
+					remainingDelta,
+					&m_CollisionStats
+				);
+				if (hit.Hit && (!closestHit.Hit || hit.Time < closestHit.Time))
+					closestHit = hit;
+				continue;
+			}
+
+			// Time is a fraction of the delta, so it carries over between spaces unchanged.
+			FuturaLibrary::WorldSweepHit hit = instance.World->SweepCapsule(
+				TransformPoint(instance.InverseTransform, collisionCenter - capsuleHalfSegment),
+				TransformPoint(instance.InverseTransform, collisionCenter + capsuleHalfSegment),
+				capsuleRadius * GetMaxAxisScale(instance.InverseTransform),
+				TransformVector(instance.InverseTransform, remainingDelta),
+				&m_CollisionStats
+			);
+			hit.Normal = TransformNormal(instance.InverseTransform, hit.Normal);
+			hit.RemainingDelta = TransformVector(instance.Transform, hit.RemainingDelta);
+			if (hit.Hit && (!closestHit.Hit || hit.Time < closestHit.Time))
+				closestHit = hit;
+		}
+
+		if (!closestHit.Hit)
+		{
+			collisionCenter += remainingDelta;
+			break;
+		}
+
+		collisionCenter += remainingDelta * closestHit.Time;
+		remainingDelta = closestHit.RemainingDelta;
 	}
 
+	const glm::vec3 resolvedDelta = collisionCenter - cameraCenter;
+
 	const auto endTime = std::chrono::steady_clock::now();
 	m_CollisionStats.CollisionTimeMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
 	return resolvedDelta;
 }
 
-FuturaLibrary::WorldAccelerationStats SceneWorld::GetAccelerationStats() const
+void SceneWorld::ResolveAABBMovementBatch(
+	const std::vector<glm::vec3>& centers,
+	const std::vector<glm::vec3>& halfExtents,
+	const std::vector<glm::vec3>& desiredDeltas,
+	std::vector<glm::vec3>& resolvedDeltas) const
 {
+	// Counters add to the frame's collision stats like Occluded; the camera query resets them.
+	const auto startTime = std::chrono::steady_clock::now();
+	resolvedDeltas = desiredDeltas;
+
+	// Resolution only shortens or slides a delta, so a box of each mover grown by its desired
+	// distance in every direction covers whatever any world in the chain hands to the next.
+	FuturaLibrary::AxisAlignedBounds batchBounds;
+	for (size_t moverIndex = 0; moverIndex < centers.size(); moverIndex++)
+	{
+		const glm::vec3 reach = halfExtents[moverIndex] + glm::vec3(glm::length(desiredDeltas[moverIndex]));
+		batchBounds.Min = batchBounds.IsValid ? glm::min(batchBounds.Min, centers[moverIndex] - reach) : centers[moverIndex] - reach;
+		batchBounds.Max = batchBounds.IsValid ? glm::max(batchBounds.Max, centers[moverIndex] + reach) : centers[moverIndex] + reach;
+		batchBounds.IsValid = true;
+	}
+	QueryWorlds(batchBounds, m_WorldCandidates);
+	m_CollisionStats.CandidateWorlds += static_cast<uint32_t>(m_WorldCandidates.size());
+
+	std::vector<glm::vec3> worldDeltas;
+	for (uint32_t worldIndex : m_WorldCandidates)
+	{
+		const StaticWorldInstance& instance = m_WorldInstances[worldIndex];
+		if (instance.IsIdentity)
+		{
+			instance.World->ResolveAABBMovementBatch(centers, halfExtents, resolvedDeltas, worldDeltas, &m_CollisionStats);
+			resolvedDeltas.swap(worldDeltas);
+			continue;
+		}
+
+		// A box stays a box under axis-aligned rotations; other rotations resolve its local-space
+		// bounds instead, which can only stop a mover early.
+		const glm::mat3 inverseBasis = glm::mat3(instance.InverseTransform);
+		const glm::mat3 absoluteInverseBasis(glm::abs(inverseBasis[0]), glm::abs(inverseBasis[1]), glm::abs(inverseBasis[2]));
+		m_InstanceCenters.resize(centers.size());
+		m_InstanceHalfExtents.resize(centers.size());
+		m_InstanceDeltas.resize(centers.size());
+		for (size_t moverIndex = 0; moverIndex < centers.size(); moverIndex++)
+		{
+			m_InstanceCenters[moverIndex] = TransformPoint(instance.InverseTransform, centers[moverIndex]);
+			m_InstanceHalfExtents[moverIndex] = absoluteInverseBasis * halfExtents[moverIndex];
+			m_InstanceDeltas[moverIndex] = inverseBasis * resolvedDeltas[moverIndex];
+		}
+
+		instance.World->ResolveAABBMovementBatch(m_InstanceCenters, m_InstanceHalfExtents, m_InstanceDeltas, worldDeltas, &m_CollisionStats);
+		const glm::mat3 basis = glm::mat3(instance.Transform);
+		for (size_t moverIndex = 0; moverIndex < centers.size(); moverIndex++)
+			resolvedDeltas[moverIndex] = basis * worldDeltas[moverIndex];
+	}
+
+	const auto endTime = std::chrono::steady_clock::now();
+	m_CollisionStats.CollisionTimeMs += std::chrono::duration<float, std::milli>(endTime - startTime).count();
+}
+
+void SceneWorld::UpdateAccelerationStats()
+{
+	// Instances share their world's geometry and broad phase, so each world is counted once.
 	FuturaLibrary::WorldAccelerationStats stats;
-	for (const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world : m_StaticWorlds)
+	std::unordered_set<const FuturaLibrary::StaticWorld*> countedWorlds;
+	for (const StaticWorldInstance& instance : m_WorldInstances)
 	{
-		if (!world)
+		if (!instance.World)
+			continue;
+
+		stats.WorldInstances++;
+		if (!countedWorlds.insert(instance.World.get()).second)
 			continue;
 
-		const FuturaLibrary::WorldAccelerationStats& worldStats = world->GetAccelerationStats();
+		const FuturaLibrary::WorldAccelerationStats& worldStats = instance.World->GetAccelerationStats();
 		if (stats.CellSize == 0.0f)
 			stats.CellSize = worldStats.CellSize;
 
+		stats.BroadPhase = worldStats.BroadPhase;
+		stats.GridLevels = std::max(stats.GridLevels, worldStats.GridLevels);
 		stats.OccupiedCells += worldStats.OccupiedCells;
+		stats.GridMemoryBytes += worldStats.GridMemoryBytes;
+		stats.UnpackedGridMemoryBytes += worldStats.UnpackedGridMemoryBytes;
 		stats.IndexedSurfaces += worldStats.IndexedSurfaces;
 		stats.IndexedTriangles += worldStats.IndexedTriangles;
+		stats.SourceTriangles += worldStats.SourceTriangles;
+		stats.MergedTriangles += worldStats.MergedTriangles;
+		stats.SliverTriangles += worldStats.SliverTriangles;
+		stats.CollisionVertices += worldStats.CollisionVertices;
+		stats.CollisionMemoryBytes += worldStats.CollisionMemoryBytes;
+		stats.UncompressedCollisionMemoryBytes += worldStats.UncompressedCollisionMemoryBytes;
+		stats.BVHNodes += worldStats.BVHNodes;
+		stats.BVHLeaves += worldStats.BVHLeaves;
+		stats.BVHMaxDepth = std::max(stats.BVHMaxDepth, worldStats.BVHMaxDepth);
+		stats.BuildTimeMs += worldStats.BuildTimeMs;
+		stats.LoadedFromCache = stats.LoadedFromCache || worldStats.LoadedFromCache;
+		stats.BspNodes += worldStats.BspNodes;
+		stats.BspLeaves += worldStats.BspLeaves;
+		stats.BspSolidLeaves += worldStats.BspSolidLeaves;
+		stats.BspMaxDepth = std::max(stats.BspMaxDepth, worldStats.BspMaxDepth);
+		stats.BspBuildTimeMs += worldStats.BspBuildTimeMs;
+		stats.BspLoadedFromCache = stats.BspLoadedFromCache || worldStats.BspLoadedFromCache;
 	}
 
-	return stats;
+	stats.UniqueWorlds = static_cast<uint32_t>(countedWorlds.size());
+	m_AccelerationStats = stats;
 }
@@ -5,7 +5,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 10, 2026
- *      Last Modified on:    July 10, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #pragma once
@@ -14,6 +14,8 @@
 #include "FuturaLibrary/graphics/g_Shader.h"
 #include "FuturaLibrary/renderer/r_DebugRenderer.h"
 #include "FuturaLibrary/renderer/r_Material.h"
+#include "FuturaLibrary/renderer/r_StaticWorldRenderer.h"
+#include "FuturaLibrary/resources/r_BoundingVolumeHierarchy.h"
 #include "FuturaLibrary/resources/r_StaticWorld.h"
 
 #include <glm/glm.hpp>
@@ -25,16 +27,72 @@ class SceneWorld
 {
 public:
 	bool LoadPreviewScene(const std::string& scenePath, const FuturaLibrary::Ref<FuturaLibrary::Shader>& shader);
+	// Streams chunk worlds in and out. Queries only visit worlds whose bounds overlap them; removing a
+	// world refits the top-level BVH, and added worlds are scanned directly until enough pile up for a rebuild.
+	// Adding the same world again places another instance of its geometry, and the returned id removes
+	// just that instance. Build shared worlds with an identity transform and place them here instead.
+	uint32_t AddStaticWorld(const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world, const FuturaLibrary::WorldTransform& transform = {});
+	void RemoveStaticWorldInstance(uint32_t instanceId);
+	// Removes every instance of the world.
+	void RemoveStaticWorld(const FuturaLibrary::Ref<FuturaLibrary::StaticWorld>& world);
+	// Call after worlds grow through AddModels/Finalize so the top-level bounds, BSPs and stats cover the new geometry.
+	void RefitStaticWorlds();
 	void Submit(const FuturaLibrary::Ref<FuturaLibrary::Material>& fallbackMaterial) const;
 	void DrawDebug(const FuturaLibrary::DebugWorldDrawSettings& settings) const;
+	// Times the SIMD frustum kernel against the scalar box test over every instance's surfaces as seen
+	// from viewProjection, and counts any surface the two disagree on.
+	FuturaLibrary::FrustumCullBenchmark BenchmarkSurfaceCulling(const glm::mat4& viewProjection, uint32_t iterations) const;
 	FuturaLibrary::WorldRaycastHit Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+	bool Occluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
 	glm::vec3 ResolveCameraMovement(const glm::vec3& cameraPosition, const glm::vec3& desiredDelta) const;
+	// Per-tick movement for many agent boxes; each world sees the deltas left by the previous one.
+	void ResolveAABBMovementBatch(
+		const std::vector<glm::vec3>& centers,
+		const std::vector<glm::vec3>& halfExtents,
+		const std::vector<glm::vec3>& desiredDeltas,
+		std::vector<glm::vec3>& resolvedDeltas) const;
 
-	bool IsEmpty() const { return m_StaticWorlds.empty(); }
+	bool IsEmpty() const { return m_WorldInstances.size() == m_RemovedWorldCount; }
 	const FuturaLibrary::CollisionQueryStats& GetCollisionStats() const { return m_CollisionStats; }
-	FuturaLibrary::WorldAccelerationStats GetAccelerationStats() const;
+	const FuturaLibrary::WorldAccelerationStats& GetAccelerationStats() const { return m_AccelerationStats; }
 
 private:
-	std::vector<FuturaLibrary::Ref<FuturaLibrary::StaticWorld>> m_StaticWorlds;
+	// One placement of a shared world. Its geometry stays indexed in the world's own space and queries
+	// move rays and shapes into that space, so collision memory grows with unique worlds, not placements.
+	struct StaticWorldInstance
+	{
+		FuturaLibrary::Ref<FuturaLibrary::StaticWorld> World;
+		glm::mat4 Transform = glm::mat4(1.0f);
+		glm::mat4 InverseTransform = glm::mat4(1.0f);
+		// Identity placements call straight into the world without changing space.
+		bool IsIdentity = true;
+		uint32_t Id = 0;
+	};
+
+	void ClearStaticWorlds();
+	// Empties one slot; the caller then refits or rebuilds once for the whole removal.
+	void RemoveInstanceSlot(uint32_t slotIndex);
+	void UpdateWorldBVHAfterRemoval(bool removedIndexedSlot);
+	void RebuildWorldBVH();
+	void UpdateAccelerationStats();
+	// Appends the collision-carrying worlds whose bounds overlap, in slot order, so results match a plain scan.
+	void QueryWorlds(const FuturaLibrary::AxisAlignedBounds& bounds, std::vector<uint32_t>& worlds) const;
+
+	// Removed instances leave an empty slot until the next rebuild compacts the list.
+	std::vector<StaticWorldInstance> m_WorldInstances;
+	std::vector<FuturaLibrary::AxisAlignedBounds> m_WorldBounds;
+	// Slots below m_IndexedWorldCount are in m_WorldBVH; later ones are tested one by one.
+	FuturaLibrary::BoundingVolumeHierarchy m_WorldBVH;
+	uint32_t m_IndexedWorldCount = 0;
+	uint32_t m_RemovedWorldCount = 0;
+	uint32_t m_NextInstanceId = 1;
+	FuturaLibrary::WorldAccelerationStats m_AccelerationStats;
+	mutable std::vector<uint32_t> m_WorldCandidates;
+	// Filled per Submit so every instance is culled and built in one batch of jobs.
+	mutable std::vector<FuturaLibrary::StaticWorldDraw> m_WorldDraws;
+	// Movers moved into one instance's space for ResolveAABBMovementBatch.
+	mutable std::vector<glm::vec3> m_InstanceCenters;
+	mutable std::vector<glm::vec3> m_InstanceHalfExtents;
+	mutable std::vector<glm::vec3> m_InstanceDeltas;
 	mutable FuturaLibrary::CollisionQueryStats m_CollisionStats;
 };
@@ -5,12 +5,14 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 10, 2026
- *      Last Modified on:    July 10, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #include "pch.h"
 #include "r_DebugOverlay.h"
 
+#include "FuturaLibrary/utils/u_Simd.h"
+
 #include <imgui.h>
 
 namespace FuturaLibrary
@@ -35,12 +37,60 @@ namespace FuturaLibrary
 		ImGui::Text("Triangles: %u", frameData.Render.Triangles);
 		ImGui::Text("Surfaces: %u visible / %u total", frameData.Render.VisibleSurfaces, frameData.Render.TotalSurfaces);
 		ImGui::Text("Culled Surfaces: %u", frameData.Render.CulledSurfaces);
+		ImGui::Text("Cull Tests: %u cells, %u surfaces", frameData.Render.CullCellsTested, frameData.Render.CullSurfacesTested);
+		ImGui::Text("Occluded Surfaces: %u (%u occluders, %u triangles)", frameData.Render.OccludedSurfaces, frameData.Render.Occluders, frameData.Render.OccluderTriangles);
+		const FrustumCullBenchmark& benchmark = frameData.CullBenchmark;
+		if (benchmark.Iterations > 0 && benchmark.SimdMicroseconds > 0.0f && benchmark.ScalarMicroseconds > 0.0f)
+		{
+			const float testedSurfaces = static_cast<float>(benchmark.Surfaces) * static_cast<float>(benchmark.Iterations);
+			ImGui::Text("Cull Kernel (%u lanes): %.1f surfaces/us", SimdWidth, testedSurfaces / benchmark.SimdMicroseconds);
+			ImGui::Text("Cull Scalar: %.1f surfaces/us, %u mismatches", testedSurfaces / benchmark.ScalarMicroseconds, benchmark.Mismatches);
+		}
 
 		ImGui::SeparatorText("World Acceleration");
-		ImGui::Text("Grid Cell Size: %.2f", frameData.Acceleration.CellSize);
-		ImGui::Text("Occupied Cells: %u", frameData.Acceleration.OccupiedCells);
+		ImGui::Text("World Instances: %u (%u unique)", frameData.Acceleration.WorldInstances, frameData.Acceleration.UniqueWorlds);
+		if (frameData.Acceleration.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+		{
+			ImGui::Text("Broad Phase: SAH BVH");
+			ImGui::Text("BVH Nodes: %u (%u leaves)", frameData.Acceleration.BVHNodes, frameData.Acceleration.BVHLeaves);
+			ImGui::Text("BVH Max Depth: %u", frameData.Acceleration.BVHMaxDepth);
+		}
+		else
+		{
+			ImGui::Text("Broad Phase: Multi-Level Grid");
+			ImGui::Text("Grid Base Cell: %.4g (%u levels)", frameData.Acceleration.CellSize, frameData.Acceleration.GridLevels);
+			ImGui::Text("Occupied Cells: %u", frameData.Acceleration.OccupiedCells);
+			ImGui::Text(
+				"Grid Memory: %.1f KB (%.1f KB hashed)",
+				static_cast<float>(frameData.Acceleration.GridMemoryBytes) / 1024.0f,
+				static_cast<float>(frameData.Acceleration.UnpackedGridMemoryBytes) / 1024.0f
+			);
+		}
 		ImGui::Text("Indexed Surfaces: %u", frameData.Acceleration.IndexedSurfaces);
-		ImGui::Text("Indexed Triangles: %u", frameData.Acceleration.IndexedTriangles);
+		ImGui::Text("Indexed Triangles: %u (%u welded vertices)", frameData.Acceleration.IndexedTriangles, frameData.Acceleration.CollisionVertices);
+		ImGui::Text(
+			"Source Triangles: %u (%u merged, %u slivers)",
+			frameData.Acceleration.SourceTriangles,
+			frameData.Acceleration.MergedTriangles,
+			frameData.Acceleration.SliverTriangles
+		);
+		ImGui::Text(
+			"Collision Memory: %.1f KB (%.1f KB uncompressed)",
+			static_cast<float>(frameData.Acceleration.CollisionMemoryBytes) / 1024.0f,
+			static_cast<float>(frameData.Acceleration.UncompressedCollisionMemoryBytes) / 1024.0f
+		);
+		ImGui::Text("Build Time: %.2f ms%s", frameData.Acceleration.BuildTimeMs, frameData.Acceleration.LoadedFromCache ? " (cache)" : "");
+		if (frameData.Acceleration.BspLeaves > 0)
+		{
+			ImGui::Text(
+				"BSP: %u nodes, %u leaves (%u solid), depth %u",
+				frameData.Acceleration.BspNodes,
+				frameData.Acceleration.BspLeaves,
+				frameData.Acceleration.BspSolidLeaves,
+				frameData.Acceleration.BspMaxDepth
+			);
+			ImGui::Text("BSP Build Time: %.2f ms%s", frameData.Acceleration.BspBuildTimeMs, frameData.Acceleration.BspLoadedFromCache ? " (cache)" : "");
+		}
 
 		ImGui::SeparatorText("Debug Draw");
 		ImGui::Text("Lines: %u", frameData.DebugDraw.LineCount);
@@ -49,11 +99,17 @@ namespace FuturaLibrary
 
 		ImGui::SeparatorText("Physics");
 		ImGui::Text("Collision Time: %.3f ms", frameData.Collision.CollisionTimeMs);
+		ImGui::Text("Candidate Worlds: %u", frameData.Collision.CandidateWorlds);
 		ImGui::Text("Broad-Phase Queries: %u", frameData.Collision.BroadPhaseQueries);
+		ImGui::Text("Query Cache: %u hits / %u misses", frameData.Collision.QueryCacheHits, frameData.Collision.QueryCacheMisses);
 		ImGui::Text("Candidate Surfaces: %u", frameData.Collision.CandidateSurfaces);
 		ImGui::Text("Candidate Triangles: %u", frameData.Collision.CandidateTriangles);
-		ImGui::Text("Narrow-Phase Tests: %u", frameData.Collision.NarrowPhaseTests);
+		ImGui::Text("Narrow-Phase Tests: %u (%u SIMD batches)", frameData.Collision.NarrowPhaseTests, frameData.Collision.NarrowPhaseBatches);
 		ImGui::Text("Contacts Generated: %u", frameData.Collision.ContactsGenerated);
+		ImGui::Text("Sweep Queries: %u (%u closest-feature tests)", frameData.Collision.SweepQueries, frameData.Collision.ClosestFeatureTests);
+		ImGui::Text("Movement Batches: %u (%u movers, %.3f ms)", frameData.Collision.MovementBatches, frameData.Collision.BatchedMovers, frameData.Collision.MovementBatchTimeMs);
+		ImGui::Text("Occlusion Queries: %u (%u occluded)", frameData.Collision.OcclusionQueries, frameData.Collision.OccludedRays);
+		ImGui::Text("Occlusion Tests: %u", frameData.Collision.OcclusionTests);
 
 		ImGui::SeparatorText("World Debug");
 		ImGui::Checkbox("Bounds (F1)", &state.DrawSettings.DrawBounds);
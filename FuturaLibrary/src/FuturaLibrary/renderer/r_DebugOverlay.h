@@ -5,13 +5,14 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 10, 2026
- *      Last Modified on:    July 10, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #pragma once
 
 #include "FuturaLibrary/core/c_core.h"
 #include "FuturaLibrary/renderer/r_DebugRenderer.h"
+#include "FuturaLibrary/renderer/r_Frustum.h"
 #include "FuturaLibrary/renderer/r_Renderer.h"
 #include "FuturaLibrary/resources/r_StaticWorld.h"
 
@@ -31,6 +32,8 @@ namespace FuturaLibrary
 		DebugDrawStats DebugDraw;
 		CollisionQueryStats Collision;
 		WorldAccelerationStats Acceleration;
+		// Filled on request rather than every frame; Iterations stays zero until the first run.
+		FrustumCullBenchmark CullBenchmark;
 	};
 
 	class FT_API DebugOverlay
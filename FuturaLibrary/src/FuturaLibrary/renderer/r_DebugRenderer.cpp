@@ -5,7 +5,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 05, 2026
- *      Last Modified on:    July 05, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #include "pch.h"
@@ -128,22 +128,22 @@ namespace FuturaLibrary
 		DrawAABB(center - halfExtents, center + halfExtents, color);
 	}
 
-	void DebugRenderer::DrawStaticWorld(const StaticWorld& world, const DebugWorldDrawSettings& settings)
+	void DebugRenderer::DrawStaticWorld(const StaticWorld& world, const DebugWorldDrawSettings& settings, const glm::mat4& instanceTransform)
 	{
 		if (settings.DrawBounds)
 		{
-			const AxisAlignedBounds& worldBounds = world.GetWorldBounds();
+			const AxisAlignedBounds worldBounds = TransformBounds(world.GetWorldBounds(), instanceTransform);
 			if (worldBounds.IsValid)
 				DrawAABB(worldBounds.Min, worldBounds.Max, glm::vec4(0.1f, 0.75f, 1.0f, 1.0f));
 
 			const std::vector<WorldSurface>& surfaces = world.GetSurfaces();
 			for (uint32_t i = 0; i < surfaces.size(); i++)
 			{
-				const WorldSurface& surface = surfaces[i];
-				if (!surface.WorldBounds.IsValid)
+				const AxisAlignedBounds surfaceBounds = TransformBounds(surfaces[i].WorldBounds, instanceTransform);
+				if (!surfaceBounds.IsValid)
 					continue;
 
-				DrawAABB(surface.WorldBounds.Min, surface.WorldBounds.Max, glm::vec4(0.25f, 1.0f, 0.35f, 0.85f));
+				DrawAABB(surfaceBounds.Min, surfaceBounds.Max, glm::vec4(0.25f, 1.0f, 0.35f, 0.85f));
 			}
 		}
 	}
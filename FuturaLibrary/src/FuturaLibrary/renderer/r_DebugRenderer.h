@@ -5,7 +5,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 05, 2026
- *      Last Modified on:    July 05, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #pragma once
@@ -42,7 +42,7 @@ namespace FuturaLibrary
 		static void DrawLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color);
 		static void DrawAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color);
 		static void DrawBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec4& color);
-		static void DrawStaticWorld(const StaticWorld& world, const DebugWorldDrawSettings& settings);
+		static void DrawStaticWorld(const StaticWorld& world, const DebugWorldDrawSettings& settings, const glm::mat4& instanceTransform = glm::mat4(1.0f));
 
 		static const DebugDrawStats& GetStats();
 		static bool IsInitialized();
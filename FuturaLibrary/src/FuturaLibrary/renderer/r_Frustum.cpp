@@ -0,0 +1,418 @@
+/**
+ *  @file r_Frustum.cpp
+ *
+ *  @brief Implements frustum plane extraction, box classification, and the SIMD box kernel.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#include "pch.h"
+#include "r_Frustum.h"
+
+#include "FuturaLibrary/utils/u_Simd.h"
+
+namespace FuturaLibrary
+{
+	namespace
+	{
+		glm::vec4 GetMatrixRow(const glm::mat4& matrix, uint32_t row)
+		{
+			return { matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row] };
+		}
+
+		FrustumPlane NormalizePlane(const glm::vec4& plane)
+		{
+			const glm::vec3 normal = glm::vec3(plane);
+			const float length = glm::length(normal);
+			if (length == 0.0f)
+				return {};
+
+			return { normal / length, plane.w / length };
+		}
+
+		// Spelled out rather than glm::dot so the scalar and SIMD paths round identically.
+		float GetPlaneDistance(const FrustumPlane& plane, float x, float y, float z)
+		{
+			return plane.Normal.x * x + plane.Normal.y * y + plane.Normal.z * z + plane.Distance;
+		}
+
+		constexpr uint32_t AllLanesMask = (1u << SimdWidth) - 1u;
+
+		// Plane constants broadcast once per call rather than once per group of boxes.
+		struct SimdFrustum
+		{
+			SimdFloat NormalX[6];
+			SimdFloat NormalY[6];
+			SimdFloat NormalZ[6];
+			SimdFloat Distance[6];
+			bool PositiveX[6];
+			bool PositiveY[6];
+			bool PositiveZ[6];
+		};
+
+		SimdFrustum MakeSimdFrustum(const Frustum& frustum)
+		{
+			SimdFrustum simdFrustum;
+			for (uint32_t i = 0; i < 6; i++)
+			{
+				const FrustumPlane& plane = frustum.Planes[i];
+				simdFrustum.NormalX[i] = SimdSet(plane.Normal.x);
+				simdFrustum.NormalY[i] = SimdSet(plane.Normal.y);
+				simdFrustum.NormalZ[i] = SimdSet(plane.Normal.z);
+				simdFrustum.Distance[i] = SimdSet(plane.Distance);
+				simdFrustum.PositiveX[i] = plane.Normal.x >= 0.0f;
+				simdFrustum.PositiveY[i] = plane.Normal.y >= 0.0f;
+				simdFrustum.PositiveZ[i] = plane.Normal.z >= 0.0f;
+			}
+			return simdFrustum;
+		}
+
+		// Lane bits of the boxes no plane rejects. The normal's signs are shared by every lane, so
+		// the positive vertex is picked per plane instead of blended per lane.
+		uint32_t TestBoxes(
+			const SimdFrustum& frustum,
+			SimdFloat minX, SimdFloat minY, SimdFloat minZ,
+			SimdFloat maxX, SimdFloat maxY, SimdFloat maxZ)
+		{
+			const SimdFloat zero = SimdSet(0.0f);
+			SimdFloat outside = SimdSetBits(0u);
+			for (uint32_t i = 0; i < 6; i++)
+			{
+				const SimdFloat x = frustum.PositiveX[i] ? maxX : minX;
+				const SimdFloat y = frustum.PositiveY[i] ? maxY : minY;
+				const SimdFloat z = frustum.PositiveZ[i] ? maxZ : minZ;
+				const SimdFloat distance = frustum.NormalX[i] * x + frustum.NormalY[i] * y + frustum.NormalZ[i] * z + frustum.Distance[i];
+				outside = SimdOr(outside, SimdLess(distance, zero));
+			}
+			return ~SimdMoveMask(outside) & AllLanesMask;
+		}
+
+		uint32_t TestGatheredBoxes(const SimdFrustum& frustum, const BoundsArrays& bounds, const uint32_t* lanes)
+		{
+			return TestBoxes(
+				frustum,
+				SimdGather(bounds.MinX.data(), lanes),
+				SimdGather(bounds.MinY.data(), lanes),
+				SimdGather(bounds.MinZ.data(), lanes),
+				SimdGather(bounds.MaxX.data(), lanes),
+				SimdGather(bounds.MaxY.data(), lanes),
+				SimdGather(bounds.MaxZ.data(), lanes)
+			);
+		}
+
+		// A partial last group repeats its final index in the spare lanes, then masks them off.
+		uint32_t TestBoxTail(const SimdFrustum& frustum, const BoundsArrays& bounds, const uint32_t* indices, uint32_t count, uint32_t* lanes)
+		{
+			for (uint32_t lane = 0; lane < SimdWidth; lane++)
+				lanes[lane] = indices[std::min(lane, count - 1)];
+
+			return TestGatheredBoxes(frustum, bounds, lanes) & ((1u << count) - 1u);
+		}
+
+		uint32_t* WriteVisibleLanes(uint32_t laneBits, const uint32_t* lanes, uint32_t* output)
+		{
+			while (laneBits != 0)
+			{
+				*output++ = lanes[std::countr_zero(laneBits)];
+				laneBits &= laneBits - 1u;
+			}
+			return output;
+		}
+
+		uint32_t* WriteVisibleRange(uint32_t laneBits, uint32_t first, uint32_t* output)
+		{
+			while (laneBits != 0)
+			{
+				*output++ = first + static_cast<uint32_t>(std::countr_zero(laneBits));
+				laneBits &= laneBits - 1u;
+			}
+			return output;
+		}
+
+		// Both lists are ascending, so one merge walk counts the boxes only one side kept.
+		uint32_t CountMismatches(const std::vector<uint32_t>& simdVisible, const std::vector<uint32_t>& scalarVisible)
+		{
+			uint32_t mismatches = 0;
+			size_t simdIndex = 0;
+			size_t scalarIndex = 0;
+			while (simdIndex < simdVisible.size() || scalarIndex < scalarVisible.size())
+			{
+				if (scalarIndex == scalarVisible.size() || (simdIndex < simdVisible.size() && simdVisible[simdIndex] < scalarVisible[scalarIndex]))
+				{
+					mismatches++;
+					simdIndex++;
+				}
+				else if (simdIndex == simdVisible.size() || scalarVisible[scalarIndex] < simdVisible[simdIndex])
+				{
+					mismatches++;
+					scalarIndex++;
+				}
+				else
+				{
+					simdIndex++;
+					scalarIndex++;
+				}
+			}
+			return mismatches;
+		}
+	}
+
+	Frustum ExtractFrustum(const glm::mat4& viewProjection)
+	{
+		const glm::vec4 row0 = GetMatrixRow(viewProjection, 0);
+		const glm::vec4 row1 = GetMatrixRow(viewProjection, 1);
+		const glm::vec4 row2 = GetMatrixRow(viewProjection, 2);
+		const glm::vec4 row3 = GetMatrixRow(viewProjection, 3);
+
+		Frustum frustum;
+		frustum.Planes[0] = NormalizePlane(row3 + row0);
+		frustum.Planes[1] = NormalizePlane(row3 - row0);
+		frustum.Planes[2] = NormalizePlane(row3 + row1);
+		frustum.Planes[3] = NormalizePlane(row3 - row1);
+		frustum.Planes[4] = NormalizePlane(row3 + row2);
+		frustum.Planes[5] = NormalizePlane(row3 - row2);
+		return frustum;
+	}
+
+	FrustumTest ClassifyBounds(const Frustum& frustum, const glm::vec3& min, const glm::vec3& max)
+	{
+		FrustumTest result = FrustumTest::Inside;
+		for (const FrustumPlane& plane : frustum.Planes)
+		{
+			// The corner furthest along the normal decides outside; the nearest one decides inside.
+			const glm::vec3 positiveVertex =
+			{
+				plane.Normal.x >= 0.0f ? max.x : min.x,
+				plane.Normal.y >= 0.0f ? max.y : min.y,
+				plane.Normal.z >= 0.0f ? max.z : min.z
+			};
+			if (GetPlaneDistance(plane, positiveVertex.x, positiveVertex.y, positiveVertex.z) < 0.0f)
+				return FrustumTest::Outside;
+
+			const glm::vec3 negativeVertex =
+			{
+				plane.Normal.x >= 0.0f ? min.x : max.x,
+				plane.Normal.y >= 0.0f ? min.y : max.y,
+				plane.Normal.z >= 0.0f ? min.z : max.z
+			};
+			if (GetPlaneDistance(plane, negativeVertex.x, negativeVertex.y, negativeVertex.z) < 0.0f)
+				result = FrustumTest::Intersecting;
+		}
+
+		return result;
+	}
+
+	bool IsVisible(const Frustum& frustum, const AxisAlignedBounds& bounds)
+	{
+		if (!bounds.IsValid)
+			return true;
+
+		return ClassifyBounds(frustum, bounds.Min, bounds.Max) != FrustumTest::Outside;
+	}
+
+	void CullBoundsRange(const Frustum& frustum, const BoundsArrays& bounds, uint32_t first, uint32_t count, std::vector<uint32_t>& visible)
+	{
+		FT_CORE_ASSERT(first + count <= bounds.GetCount(), "Frustum cull range is outside the bounds arrays!");
+		if (count == 0)
+			return;
+
+		// Size for the worst case and write through a cursor; the result is trimmed afterwards.
+		const SimdFrustum simdFrustum = MakeSimdFrustum(frustum);
+		const size_t start = visible.size();
+		visible.resize(start + count);
+		uint32_t* output = visible.data() + start;
+
+		uint32_t offset = 0;
+		for (; offset + SimdWidth <= count; offset += SimdWidth)
+		{
+			const uint32_t base = first + offset;
+			const uint32_t laneBits = TestBoxes(
+				simdFrustum,
+				SimdLoad(bounds.MinX.data() + base),
+				SimdLoad(bounds.MinY.data() + base),
+				SimdLoad(bounds.MinZ.data() + base),
+				SimdLoad(bounds.MaxX.data() + base),
+				SimdLoad(bounds.MaxY.data() + base),
+				SimdLoad(bounds.MaxZ.data() + base)
+			);
+			output = WriteVisibleRange(laneBits, base, output);
+		}
+
+		if (offset < count)
+		{
+			uint32_t tail[SimdWidth];
+			const uint32_t tailCount = count - offset;
+			for (uint32_t lane = 0; lane < tailCount; lane++)
+				tail[lane] = first + offset + lane;
+
+			uint32_t lanes[SimdWidth];
+			output = WriteVisibleLanes(TestBoxTail(simdFrustum, bounds, tail, tailCount, lanes), lanes, output);
+		}
+
+		visible.resize(static_cast<size_t>(output - visible.data()));
+	}
+
+	void CullBoundsIndexed(const Frustum& frustum, const BoundsArrays& bounds, const uint32_t* indices, uint32_t count, std::vector<uint32_t>& visible)
+	{
+		if (count == 0)
+			return;
+
+		const SimdFrustum simdFrustum = MakeSimdFrustum(frustum);
+		const size_t start = visible.size();
+		visible.resize(start + count);
+		uint32_t* output = visible.data() + start;
+
+		uint32_t offset = 0;
+		for (; offset + SimdWidth <= count; offset += SimdWidth)
+			output = WriteVisibleLanes(TestGatheredBoxes(simdFrustum, bounds, indices + offset), indices + offset, output);
+
+		if (offset < count)
+		{
+			uint32_t lanes[SimdWidth];
+			output = WriteVisibleLanes(TestBoxTail(simdFrustum, bounds, indices + offset, count - offset, lanes), lanes, output);
+		}
+
+		visible.resize(static_cast<size_t>(output - visible.data()));
+	}
+
+	uint32_t CullMarkedBoundsRange(
+		const Frustum& frustum,
+		const BoundsArrays& bounds,
+		const uint32_t* marks,
+		uint32_t acceptMark,
+		uint32_t testMark,
+		uint32_t first,
+		uint32_t count,
+		std::vector<uint32_t>& visible)
+	{
+		FT_CORE_ASSERT(first + count <= bounds.GetCount(), "Frustum cull range is outside the bounds arrays!");
+		if (count == 0)
+			return 0;
+
+		const SimdFrustum simdFrustum = MakeSimdFrustum(frustum);
+		const size_t start = visible.size();
+		visible.resize(start + count);
+		uint32_t* output = visible.data() + start;
+
+		// Groups without a box to test cost only the mark reads.
+		uint32_t testedCount = 0;
+		for (uint32_t offset = 0; offset < count; offset += SimdWidth)
+		{
+			const uint32_t base = first + offset;
+			const uint32_t laneCount = std::min(SimdWidth, count - offset);
+			uint32_t keepBits = 0;
+			uint32_t testBits = 0;
+			for (uint32_t lane = 0; lane < laneCount; lane++)
+			{
+				keepBits |= static_cast<uint32_t>(marks[base + lane] == acceptMark) << lane;
+				testBits |= static_cast<uint32_t>(marks[base + lane] == testMark) << lane;
+			}
+
+			if (testBits != 0)
+			{
+				testedCount += static_cast<uint32_t>(std::popcount(testBits));
+				uint32_t passBits = 0;
+				if (laneCount == SimdWidth)
+				{
+					passBits = TestBoxes(
+						simdFrustum,
+						SimdLoad(bounds.MinX.data() + base),
+						SimdLoad(bounds.MinY.data() + base),
+						SimdLoad(bounds.MinZ.data() + base),
+						SimdLoad(bounds.MaxX.data() + base),
+						SimdLoad(bounds.MaxY.data() + base),
+						SimdLoad(bounds.MaxZ.data() + base)
+					);
+				}
+				else
+				{
+					uint32_t tail[SimdWidth];
+					for (uint32_t lane = 0; lane < laneCount; lane++)
+						tail[lane] = base + lane;
+
+					uint32_t lanes[SimdWidth];
+					passBits = TestBoxTail(simdFrustum, bounds, tail, laneCount, lanes);
+				}
+
+				keepBits |= testBits & passBits;
+			}
+
+			output = WriteVisibleRange(keepBits, base, output);
+		}
+
+		visible.resize(static_cast<size_t>(output - visible.data()));
+		return testedCount;
+	}
+
+	FrustumCullBenchmark BenchmarkFrustumCulling(const Frustum& frustum, const BoundsArrays& bounds, uint32_t iterations)
+	{
+		FrustumCullBenchmark benchmark;
+		benchmark.Surfaces = bounds.GetCount();
+		benchmark.Iterations = iterations;
+		if (benchmark.Surfaces == 0 || iterations == 0)
+			return benchmark;
+
+		std::vector<uint32_t> simdVisible;
+		std::vector<uint32_t> scalarVisible;
+		simdVisible.reserve(benchmark.Surfaces);
+		scalarVisible.reserve(benchmark.Surfaces);
+
+		const auto simdStart = std::chrono::steady_clock::now();
+		for (uint32_t iteration = 0; iteration < iterations; iteration++)
+		{
+			simdVisible.clear();
+			CullBoundsRange(frustum, bounds, 0, benchmark.Surfaces, simdVisible);
+		}
+		const auto simdEnd = std::chrono::steady_clock::now();
+
+		for (uint32_t iteration = 0; iteration < iterations; iteration++)
+		{
+			scalarVisible.clear();
+			for (uint32_t i = 0; i < benchmark.Surfaces; i++)
+			{
+				const glm::vec3 min(bounds.MinX[i], bounds.MinY[i], bounds.MinZ[i]);
+				const glm::vec3 max(bounds.MaxX[i], bounds.MaxY[i], bounds.MaxZ[i]);
+				if (ClassifyBounds(frustum, min, max) != FrustumTest::Outside)
+					scalarVisible.push_back(i);
+			}
+		}
+		const auto scalarEnd = std::chrono::steady_clock::now();
+
+		benchmark.SimdMicroseconds = std::chrono::duration<float, std::micro>(simdEnd - simdStart).count();
+		benchmark.ScalarMicroseconds = std::chrono::duration<float, std::micro>(scalarEnd - simdEnd).count();
+		benchmark.VisibleSurfaces = static_cast<uint32_t>(simdVisible.size());
+
+		benchmark.Mismatches = CountMismatches(simdVisible, scalarVisible);
+
+		// The indexed and marked entry points go through the same comparison: the indexed pass walks the
+		// boxes backwards, and the marked pass cycles through skipped, accepted and tested boxes.
+		std::vector<uint32_t> indices(benchmark.Surfaces);
+		std::vector<uint32_t> marks(benchmark.Surfaces);
+		std::vector<uint32_t> scalarMarked;
+		for (uint32_t i = 0; i < benchmark.Surfaces; i++)
+		{
+			indices[i] = benchmark.Surfaces - 1 - i;
+			marks[i] = i % 3;
+		}
+		for (uint32_t i = 0, scalarIndex = 0; i < benchmark.Surfaces; i++)
+		{
+			const bool visible = scalarIndex < scalarVisible.size() && scalarVisible[scalarIndex] == i;
+			scalarIndex += visible ? 1 : 0;
+			if (marks[i] == 1 || (marks[i] == 2 && visible))
+				scalarMarked.push_back(i);
+		}
+
+		simdVisible.clear();
+		CullBoundsIndexed(frustum, bounds, indices.data(), benchmark.Surfaces, simdVisible);
+		std::reverse(simdVisible.begin(), simdVisible.end());
+		benchmark.Mismatches += CountMismatches(simdVisible, scalarVisible);
+
+		simdVisible.clear();
+		CullMarkedBoundsRange(frustum, bounds, marks.data(), 1, 2, 0, benchmark.Surfaces, simdVisible);
+		benchmark.Mismatches += CountMismatches(simdVisible, scalarMarked);
+
+		return benchmark;
+	}
+}
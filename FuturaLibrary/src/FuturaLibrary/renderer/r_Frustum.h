@@ -0,0 +1,115 @@
+/**
+ *  @file r_Frustum.h
+ *
+ *  @brief Declares view-frustum planes and the box tests shared by renderer and world culling.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include "FuturaLibrary/core/c_core.h"
+#include "FuturaLibrary/renderer/r_Mesh.h"
+
+#include <glm/glm.hpp>
+
+#include <cfloat>
+#include <vector>
+
+namespace FuturaLibrary
+{
+	// Points with dot(Normal, point) + Distance >= 0 are on the inner side of the plane.
+	struct FrustumPlane
+	{
+		glm::vec3 Normal = glm::vec3(0.0f);
+		float Distance = 0.0f;
+	};
+
+	struct Frustum
+	{
+		FrustumPlane Planes[6];
+	};
+
+	enum class FrustumTest
+	{
+		Outside,
+		Intersecting,
+		Inside
+	};
+
+	// Work done by one hierarchical frustum query: grid cells or BVH nodes classified against the
+	// planes, and surfaces whose own bounds still needed a test.
+	struct FrustumCullStats
+	{
+		uint32_t CellsTested = 0;
+		uint32_t SurfacesTested = 0;
+	};
+
+	// Box corners as six parallel arrays, so the SIMD kernel loads one coordinate of several boxes at
+	// once. Invalid bounds are stored as the largest finite box, which no plane rejects.
+	struct BoundsArrays
+	{
+		std::vector<float> MinX;
+		std::vector<float> MinY;
+		std::vector<float> MinZ;
+		std::vector<float> MaxX;
+		std::vector<float> MaxY;
+		std::vector<float> MaxZ;
+
+		uint32_t GetCount() const { return static_cast<uint32_t>(MinX.size()); }
+
+		void Push(const AxisAlignedBounds& bounds)
+		{
+			const glm::vec3 min = bounds.IsValid ? bounds.Min : glm::vec3(-FLT_MAX);
+			const glm::vec3 max = bounds.IsValid ? bounds.Max : glm::vec3(FLT_MAX);
+			MinX.push_back(min.x);
+			MinY.push_back(min.y);
+			MinZ.push_back(min.z);
+			MaxX.push_back(max.x);
+			MaxY.push_back(max.y);
+			MaxZ.push_back(max.z);
+		}
+	};
+
+	// Timings of the SIMD kernel against the per-box ClassifyBounds loop over the same boxes.
+	// Mismatches counts boxes the range, indexed and marked kernels disagree with ClassifyBounds on,
+	// summed over the three, and should stay zero.
+	struct FrustumCullBenchmark
+	{
+		uint32_t Surfaces = 0;
+		uint32_t VisibleSurfaces = 0;
+		uint32_t Iterations = 0;
+		uint32_t Mismatches = 0;
+		float SimdMicroseconds = 0.0f;
+		float ScalarMicroseconds = 0.0f;
+	};
+
+	// Planes come out in whatever space the matrix maps from, so viewProjection * model yields a
+	// model-space frustum that model-space bounds can be tested against directly.
+	FT_API Frustum ExtractFrustum(const glm::mat4& viewProjection);
+	// Conservative: boxes near a frustum corner can report Intersecting while lying outside.
+	FT_API FrustumTest ClassifyBounds(const Frustum& frustum, const glm::vec3& min, const glm::vec3& max);
+	// Invalid bounds are treated as visible, so surfaces without bounds are never dropped.
+	FT_API bool IsVisible(const Frustum& frustum, const AxisAlignedBounds& bounds);
+
+	// SimdWidth boxes per step against all six planes, with the same outside test and arithmetic as
+	// ClassifyBounds. Indices of boxes not rejected are appended to visible in the order tested.
+	FT_API void CullBoundsRange(const Frustum& frustum, const BoundsArrays& bounds, uint32_t first, uint32_t count, std::vector<uint32_t>& visible);
+	// Same test over boxes picked by index, for sparse candidate lists; lanes are gathered.
+	FT_API void CullBoundsIndexed(const Frustum& frustum, const BoundsArrays& bounds, const uint32_t* indices, uint32_t count, std::vector<uint32_t>& visible);
+	// Range pass driven by per-box marks: boxes marked acceptMark are kept untested, boxes marked
+	// testMark go through the kernel, and any other box is skipped. Output stays in box order.
+	// Returns how many boxes were tested.
+	FT_API uint32_t CullMarkedBoundsRange(
+		const Frustum& frustum,
+		const BoundsArrays& bounds,
+		const uint32_t* marks,
+		uint32_t acceptMark,
+		uint32_t testMark,
+		uint32_t first,
+		uint32_t count,
+		std::vector<uint32_t>& visible);
+	FT_API FrustumCullBenchmark BenchmarkFrustumCulling(const Frustum& frustum, const BoundsArrays& bounds, uint32_t iterations);
+}
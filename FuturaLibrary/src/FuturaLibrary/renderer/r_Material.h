@@ -44,6 +44,10 @@ namespace FuturaLibrary
 		void SetFloat4(const std::string& name, const glm::vec4& value);
 		void SetMat3(const std::string& name, const glm::mat3& value);
 		void SetMat4(const std::string& name, const glm::mat4& value);
+		// Materials that let what is behind them show through, such as glass or alpha-tested fences,
+		// are never used to hide other geometry.
+		void SetOpaque(bool opaque) { m_Opaque = opaque; }
+		bool IsOpaque() const { return m_Opaque; }
 
 		const Ref<Shader>& GetShader() const { return m_Shader; }
 		const std::vector<MaterialTexture>& GetTextures() const { return m_Textures; }
@@ -63,5 +67,6 @@ namespace FuturaLibrary
 		std::unordered_map<std::string, glm::vec4> m_Float4Uniforms;
 		std::unordered_map<std::string, glm::mat3> m_Mat3Uniforms;
 		std::unordered_map<std::string, glm::mat4> m_Mat4Uniforms;
+		bool m_Opaque = true;
 	};
 }
@@ -44,6 +44,42 @@ namespace FuturaLibrary
 		return bounds;
 	}
 
+	AxisAlignedBounds TransformBounds(const AxisAlignedBounds& bounds, const glm::mat4& transform)
+	{
+		AxisAlignedBounds transformedBounds;
+		if (!bounds.IsValid)
+			return transformedBounds;
+
+		const glm::vec3 corners[] =
+		{
+			{ bounds.Min.x, bounds.Min.y, bounds.Min.z },
+			{ bounds.Max.x, bounds.Min.y, bounds.Min.z },
+			{ bounds.Min.x, bounds.Max.y, bounds.Min.z },
+			{ bounds.Max.x, bounds.Max.y, bounds.Min.z },
+			{ bounds.Min.x, bounds.Min.y, bounds.Max.z },
+			{ bounds.Max.x, bounds.Min.y, bounds.Max.z },
+			{ bounds.Min.x, bounds.Max.y, bounds.Max.z },
+			{ bounds.Max.x, bounds.Max.y, bounds.Max.z }
+		};
+
+		for (const glm::vec3& corner : corners)
+		{
+			const glm::vec3 transformedCorner = glm::vec3(transform * glm::vec4(corner, 1.0f));
+			if (!transformedBounds.IsValid)
+			{
+				transformedBounds.Min = transformedCorner;
+				transformedBounds.Max = transformedCorner;
+				transformedBounds.IsValid = true;
+				continue;
+			}
+
+			transformedBounds.Min = glm::min(transformedBounds.Min, transformedCorner);
+			transformedBounds.Max = glm::max(transformedBounds.Max, transformedCorner);
+		}
+
+		return transformedBounds;
+	}
+
 	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
 		: m_LocalBounds(CalculateMeshBounds(vertices)), m_IndexCount(static_cast<uint32_t>(indices.size()))
 	{
@@ -29,6 +29,8 @@ namespace FuturaLibrary
 	};
 
 	FT_API AxisAlignedBounds CalculateMeshBounds(const std::vector<Vertex>& vertices);
+	// Bounds of the eight transformed corners, so rotated boxes grow to stay conservative.
+	FT_API AxisAlignedBounds TransformBounds(const AxisAlignedBounds& bounds, const glm::mat4& transform);
 
 	class FT_API Mesh
 	{
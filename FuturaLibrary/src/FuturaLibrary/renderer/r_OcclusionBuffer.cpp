@@ -0,0 +1,340 @@
+/**
+ *  @file r_OcclusionBuffer.cpp
+ *
+ *  @brief Implements the tiled software occlusion buffer.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#include "pch.h"
+#include "r_OcclusionBuffer.h"
+
+#include "FuturaLibrary/utils/u_ParallelFor.h"
+#include "FuturaLibrary/utils/u_Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace FuturaLibrary
+{
+	namespace
+	{
+		constexpr uint32_t TilePixels = OcclusionBuffer::TileWidth * OcclusionBuffer::TileHeight;
+		constexpr uint32_t FullTileMask = 0xffffffffu;
+		constexpr float FarDepth = 1.0f;
+		// Clip-space w below this is treated as touching the eye.
+		constexpr float MinClipW = 1e-5f;
+
+		static_assert(TilePixels == 32, "Tile coverage is one bit per pixel in a uint32_t.");
+		static_assert(TilePixels % SimdWidth == 0, "Tile pixels must split into whole SIMD groups.");
+
+		// Pixel centres relative to a tile's corner; bit i of a coverage mask is pixel i, row by row.
+		struct TilePixelOffsets
+		{
+			float X[TilePixels];
+			float Y[TilePixels];
+		};
+
+		const TilePixelOffsets& GetTilePixelOffsets()
+		{
+			static const TilePixelOffsets offsets = []()
+			{
+				TilePixelOffsets result;
+				for (uint32_t pixel = 0; pixel < TilePixels; pixel++)
+				{
+					result.X[pixel] = static_cast<float>(pixel % OcclusionBuffer::TileWidth) + 0.5f;
+					result.Y[pixel] = static_cast<float>(pixel / OcclusionBuffer::TileWidth) + 0.5f;
+				}
+				return result;
+			}();
+			return offsets;
+		}
+
+		glm::vec3 ToScreen(const glm::vec4& clip, float width, float height)
+		{
+			const float inverseW = 1.0f / clip.w;
+			return {
+				(clip.x * inverseW * 0.5f + 0.5f) * width,
+				(clip.y * inverseW * 0.5f + 0.5f) * height,
+				clip.z * inverseW
+			};
+		}
+	}
+
+	void OcclusionBuffer::Resize(uint32_t width, uint32_t height)
+	{
+		m_TilesX = std::max((width + TileWidth - 1) / TileWidth, 1u);
+		m_TilesY = std::max((height + TileHeight - 1) / TileHeight, 1u);
+		m_Width = m_TilesX * TileWidth;
+		m_Height = m_TilesY * TileHeight;
+
+		const size_t tileCount = static_cast<size_t>(m_TilesX) * m_TilesY;
+		m_ReferenceDepth.resize(tileCount);
+		m_WorkingDepth.resize(tileCount);
+		m_WorkingMask.resize(tileCount);
+		Clear();
+	}
+
+	void OcclusionBuffer::Clear()
+	{
+		std::fill(m_ReferenceDepth.begin(), m_ReferenceDepth.end(), FarDepth);
+		std::fill(m_WorkingDepth.begin(), m_WorkingDepth.end(), FarDepth);
+		std::fill(m_WorkingMask.begin(), m_WorkingMask.end(), 0u);
+		m_Triangles.clear();
+	}
+
+	void OcclusionBuffer::AddOccluderTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+	{
+		// Clip against the near plane, z + w >= 0. One plane turns a triangle into at most a quad.
+		const glm::vec4 input[3] = { a, b, c };
+		glm::vec4 clipped[4];
+		uint32_t clippedCount = 0;
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			const glm::vec4& current = input[i];
+			const glm::vec4& next = input[(i + 1) % 3];
+			const float currentDistance = current.z + current.w;
+			const float nextDistance = next.z + next.w;
+			if (currentDistance >= 0.0f)
+				clipped[clippedCount++] = current;
+			if ((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+				clipped[clippedCount++] = current + (next - current) * (currentDistance / (currentDistance - nextDistance));
+		}
+
+		if (clippedCount < 3)
+			return;
+
+		glm::vec3 screen[4];
+		for (uint32_t i = 0; i < clippedCount; i++)
+		{
+			if (clipped[i].w < MinClipW)
+				return;
+
+			screen[i] = ToScreen(clipped[i], static_cast<float>(m_Width), static_cast<float>(m_Height));
+		}
+
+		AddScreenTriangle(screen[0], screen[1], screen[2]);
+		if (clippedCount == 4)
+			AddScreenTriangle(screen[0], screen[2], screen[3]);
+	}
+
+	void OcclusionBuffer::AddScreenTriangle(glm::vec3 a, glm::vec3 b, glm::vec3 c)
+	{
+		// Occluders are drawn from both sides; wind every triangle the same way so inside is E >= 0.
+		float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (!(std::abs(area) > 0.0f))
+			return;
+		if (area < 0.0f)
+		{
+			std::swap(b, c);
+			area = -area;
+		}
+
+		const float minX = std::min(a.x, std::min(b.x, c.x));
+		const float minY = std::min(a.y, std::min(b.y, c.y));
+		const float maxX = std::max(a.x, std::max(b.x, c.x));
+		const float maxY = std::max(a.y, std::max(b.y, c.y));
+		if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(m_Width) || minY >= static_cast<float>(m_Height))
+			return;
+
+		ScreenTriangle triangle;
+		const glm::vec3 corners[3] = { a, b, c };
+		for (uint32_t edge = 0; edge < 3; edge++)
+		{
+			const glm::vec3& from = corners[edge];
+			const glm::vec3& to = corners[(edge + 1) % 3];
+			triangle.EdgeX[edge] = from.y - to.y;
+			triangle.EdgeY[edge] = to.x - from.x;
+			triangle.EdgeConstant[edge] = -(triangle.EdgeX[edge] * from.x + triangle.EdgeY[edge] * from.y);
+		}
+
+		triangle.DepthX = ((b.z - a.z) * (c.y - a.y) - (b.y - a.y) * (c.z - a.z)) / area;
+		triangle.DepthY = ((b.x - a.x) * (c.z - a.z) - (c.x - a.x) * (b.z - a.z)) / area;
+		triangle.DepthConstant = a.z - triangle.DepthX * a.x - triangle.DepthY * a.y;
+		triangle.MaxDepth = std::max(a.z, std::max(b.z, c.z));
+
+		const auto toTile = [](float pixel, uint32_t tileSize, uint32_t tileCount)
+		{
+			const float tile = std::floor(pixel / static_cast<float>(tileSize));
+			return static_cast<uint32_t>(std::clamp(tile, 0.0f, static_cast<float>(tileCount - 1)));
+		};
+		triangle.MinTileX = toTile(minX, TileWidth, m_TilesX);
+		triangle.MinTileY = toTile(minY, TileHeight, m_TilesY);
+		triangle.MaxTileX = toTile(maxX, TileWidth, m_TilesX);
+		triangle.MaxTileY = toTile(maxY, TileHeight, m_TilesY);
+		m_Triangles.push_back(triangle);
+	}
+
+	void OcclusionBuffer::Rasterize(uint32_t threadCount)
+	{
+		if (m_Triangles.empty())
+			return;
+
+		// Bands own whole tile rows, so no two threads ever update the same tile.
+		const uint32_t bandCount = GetParallelChunkCount(m_TilesY, 4, threadCount);
+		ParallelForChunks(m_TilesY, bandCount, [this](uint32_t, size_t begin, size_t end)
+		{
+			RasterizeTileRows(static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+		});
+	}
+
+	void OcclusionBuffer::RasterizeTileRows(uint32_t firstRow, uint32_t endRow)
+	{
+		const TilePixelOffsets& offsets = GetTilePixelOffsets();
+		const SimdFloat zero = SimdSet(0.0f);
+		for (const ScreenTriangle& triangle : m_Triangles)
+		{
+			const uint32_t rowBegin = std::max(firstRow, triangle.MinTileY);
+			const uint32_t rowEnd = std::min(endRow, triangle.MaxTileY + 1);
+			if (rowBegin >= rowEnd)
+				continue;
+
+			SimdFloat edgeX[3];
+			SimdFloat edgeY[3];
+			for (uint32_t edge = 0; edge < 3; edge++)
+			{
+				edgeX[edge] = SimdSet(triangle.EdgeX[edge]);
+				edgeY[edge] = SimdSet(triangle.EdgeY[edge]);
+			}
+
+			for (uint32_t tileY = rowBegin; tileY < rowEnd; tileY++)
+			{
+				const float cornerY = static_cast<float>(tileY * TileHeight);
+				for (uint32_t tileX = triangle.MinTileX; tileX <= triangle.MaxTileX; tileX++)
+				{
+					const float cornerX = static_cast<float>(tileX * TileWidth);
+
+					// Edge functions at SimdWidth pixel centres per step; a pixel is covered when all three pass.
+					uint32_t coverage = 0;
+					for (uint32_t pixel = 0; pixel < TilePixels; pixel += SimdWidth)
+					{
+						const SimdFloat pixelX = SimdLoad(offsets.X + pixel);
+						const SimdFloat pixelY = SimdLoad(offsets.Y + pixel);
+						SimdFloat inside = SimdSetBits(FullTileMask);
+						for (uint32_t edge = 0; edge < 3; edge++)
+						{
+							const float atCorner = triangle.EdgeX[edge] * cornerX + triangle.EdgeY[edge] * cornerY + triangle.EdgeConstant[edge];
+							const SimdFloat value = SimdSet(atCorner) + edgeX[edge] * pixelX + edgeY[edge] * pixelY;
+							inside = SimdAnd(inside, SimdGreaterEqual(value, zero));
+						}
+						coverage |= SimdMoveMask(inside) << pixel;
+					}
+
+					if (coverage == 0)
+						continue;
+
+					// The depth plane peaks at a corner of the tile's pixel centres; the triangle never
+					// reaches past its farthest vertex.
+					const float x0 = triangle.DepthX * (cornerX + 0.5f);
+					const float x1 = triangle.DepthX * (cornerX + static_cast<float>(TileWidth) - 0.5f);
+					const float y0 = triangle.DepthY * (cornerY + 0.5f);
+					const float y1 = triangle.DepthY * (cornerY + static_cast<float>(TileHeight) - 0.5f);
+					const float depth = std::min(triangle.DepthConstant + std::max(x0, x1) + std::max(y0, y1), triangle.MaxDepth);
+					UpdateTile(tileY * m_TilesX + tileX, coverage, depth);
+				}
+			}
+		}
+	}
+
+	void OcclusionBuffer::UpdateTile(uint32_t tileIndex, uint32_t coverage, float depth)
+	{
+		float& referenceDepth = m_ReferenceDepth[tileIndex];
+		float& workingDepth = m_WorkingDepth[tileIndex];
+		uint32_t& workingMask = m_WorkingMask[tileIndex];
+		if (!(depth < referenceDepth))
+			return;
+
+		// Masked occlusion culling's merge rule: a triangle much nearer than the working layer starts a
+		// new layer instead of being merged at the working layer's farther depth. Dropping coverage only
+		// ever makes the buffer less aggressive, so the result stays conservative.
+		if (workingMask == 0 || workingDepth - depth > referenceDepth - workingDepth)
+		{
+			workingDepth = depth;
+			workingMask = coverage;
+		}
+		else
+		{
+			workingDepth = std::max(workingDepth, depth);
+			workingMask |= coverage;
+		}
+
+		if (workingMask == FullTileMask)
+		{
+			referenceDepth = std::min(referenceDepth, workingDepth);
+			workingDepth = FarDepth;
+			workingMask = 0;
+		}
+	}
+
+	bool OcclusionBuffer::ProjectBounds(const glm::mat4& localToClip, const glm::vec3& min, const glm::vec3& max, OcclusionRect& rect) const
+	{
+		rect.MinX = std::numeric_limits<float>::max();
+		rect.MinY = std::numeric_limits<float>::max();
+		rect.MaxX = -std::numeric_limits<float>::max();
+		rect.MaxY = -std::numeric_limits<float>::max();
+		rect.NearestDepth = std::numeric_limits<float>::max();
+		for (uint32_t corner = 0; corner < 8; corner++)
+		{
+			const glm::vec4 position(
+				(corner & 1) ? max.x : min.x,
+				(corner & 2) ? max.y : min.y,
+				(corner & 4) ? max.z : min.z,
+				1.0f
+			);
+			const glm::vec4 clip = localToClip * position;
+			if (clip.z + clip.w < 0.0f || clip.w < MinClipW)
+				return false;
+
+			const glm::vec3 screen = ToScreen(clip, static_cast<float>(m_Width), static_cast<float>(m_Height));
+			rect.MinX = std::min(rect.MinX, screen.x);
+			rect.MinY = std::min(rect.MinY, screen.y);
+			rect.MaxX = std::max(rect.MaxX, screen.x);
+			rect.MaxY = std::max(rect.MaxY, screen.y);
+			rect.NearestDepth = std::min(rect.NearestDepth, screen.z);
+		}
+
+		return std::isfinite(rect.MinX) && std::isfinite(rect.MinY) && std::isfinite(rect.MaxX) && std::isfinite(rect.MaxY) && std::isfinite(rect.NearestDepth);
+	}
+
+	bool OcclusionBuffer::IsOccluded(const OcclusionRect& rect) const
+	{
+		if (m_ReferenceDepth.empty() || rect.MaxX < 0.0f || rect.MaxY < 0.0f || rect.MinX >= static_cast<float>(m_Width) || rect.MinY >= static_cast<float>(m_Height))
+			return false;
+
+		// Every tile the rectangle touches must be fully covered by something nearer than the box.
+		const float lastPixelX = static_cast<float>(m_Width - 1);
+		const float lastPixelY = static_cast<float>(m_Height - 1);
+		const uint32_t minTileX = static_cast<uint32_t>(std::max(rect.MinX, 0.0f)) / TileWidth;
+		const uint32_t minTileY = static_cast<uint32_t>(std::max(rect.MinY, 0.0f)) / TileHeight;
+		const uint32_t maxTileX = static_cast<uint32_t>(std::min(rect.MaxX, lastPixelX)) / TileWidth;
+		const uint32_t maxTileY = static_cast<uint32_t>(std::min(rect.MaxY, lastPixelY)) / TileHeight;
+		const SimdFloat nearestDepth = SimdSet(rect.NearestDepth);
+		for (uint32_t tileY = minTileY; tileY <= maxTileY; tileY++)
+		{
+			const float* row = m_ReferenceDepth.data() + static_cast<size_t>(tileY) * m_TilesX;
+			uint32_t tileX = minTileX;
+			for (; tileX + SimdWidth <= maxTileX + 1; tileX += SimdWidth)
+			{
+				if (SimdMoveMask(SimdLessEqual(nearestDepth, SimdLoad(row + tileX))) != 0)
+					return false;
+			}
+			for (; tileX <= maxTileX; tileX++)
+			{
+				if (rect.NearestDepth <= row[tileX])
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	float OcclusionBuffer::GetVisibleArea(const OcclusionRect& rect) const
+	{
+		const float width = std::min(rect.MaxX, static_cast<float>(m_Width)) - std::max(rect.MinX, 0.0f);
+		const float height = std::min(rect.MaxY, static_cast<float>(m_Height)) - std::max(rect.MinY, 0.0f);
+		return width > 0.0f && height > 0.0f ? width * height : 0.0f;
+	}
+}
@@ -0,0 +1,122 @@
+/**
+ *  @file r_OcclusionBuffer.h
+ *
+ *  @brief Declares a low-resolution CPU depth buffer for software occlusion culling.
+ *
+ *  Occluders are rasterized in the style of masked occlusion culling: the
+ *  screen is cut into 8x4 pixel tiles, and each tile keeps a coverage mask and
+ *  two conservative farthest depths instead of a depth per pixel. Boxes are
+ *  then tested against the tiles their screen rectangle touches. Everything
+ *  runs on the CPU, so no GPU or context is needed to exercise it.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include "FuturaLibrary/core/c_core.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace FuturaLibrary
+{
+	struct OcclusionCullingSettings
+	{
+		// Off by default so the rendered frame matches a frustum-only submit until a layer opts in.
+		bool Enabled = false;
+		// Buffer size in pixels, rounded up to whole tiles.
+		uint32_t Width = 256;
+		uint32_t Height = 128;
+		// The largest on-screen surfaces are drawn as occluders each frame, up to both limits.
+		uint32_t MaxOccluders = 48;
+		uint32_t MaxOccluderTriangles = 8192;
+		// Surfaces covering less than this fraction of the buffer are never picked as occluders.
+		float MinOccluderScreenArea = 0.01f;
+		// Threads splitting the buffer's tile rows while rasterizing; 0 uses every hardware core.
+		uint32_t ThreadCount = 0;
+	};
+
+	struct OcclusionCullStats
+	{
+		uint32_t Occluders = 0;
+		uint32_t OccluderTriangles = 0;
+		uint32_t SurfacesTested = 0;
+		uint32_t SurfacesOccluded = 0;
+	};
+
+	// Pixel rectangle a box covers and the NDC depth of its nearest point, -1 at the near plane.
+	struct OcclusionRect
+	{
+		float MinX = 0.0f;
+		float MinY = 0.0f;
+		float MaxX = 0.0f;
+		float MaxY = 0.0f;
+		float NearestDepth = 0.0f;
+	};
+
+	class FT_API OcclusionBuffer
+	{
+	public:
+		static constexpr uint32_t TileWidth = 8;
+		static constexpr uint32_t TileHeight = 4;
+
+		void Resize(uint32_t width, uint32_t height);
+		// Starts a frame: every tile is uncovered and the queued occluder triangles are dropped.
+		void Clear();
+		// Queues one occluder triangle given in clip space; parts in front of the near plane are clipped off.
+		void AddOccluderTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+		// Draws every queued triangle. Tile rows are split across threads and each thread walks the
+		// triangles in queue order, so the result never depends on thread timing.
+		void Rasterize(uint32_t threadCount = 0);
+
+		// False when the box reaches in front of the near plane; such boxes must be treated as visible.
+		bool ProjectBounds(const glm::mat4& localToClip, const glm::vec3& min, const glm::vec3& max, OcclusionRect& rect) const;
+		// True only when the rectangle's nearest depth is behind every tile it touches. Read-only, so
+		// any number of threads may test at once after Rasterize has returned.
+		bool IsOccluded(const OcclusionRect& rect) const;
+		// Rectangle area clipped to the buffer, in pixels.
+		float GetVisibleArea(const OcclusionRect& rect) const;
+
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+		uint32_t GetOccluderTriangleCount() const { return static_cast<uint32_t>(m_Triangles.size()); }
+
+	private:
+		// Edge functions and depth plane of one projected triangle, set up once and shared by every band.
+		struct ScreenTriangle
+		{
+			float EdgeX[3];
+			float EdgeY[3];
+			float EdgeConstant[3];
+			// depth(x, y) = DepthConstant + DepthX * x + DepthY * y, capped at MaxDepth.
+			float DepthConstant;
+			float DepthX;
+			float DepthY;
+			float MaxDepth;
+			uint32_t MinTileX;
+			uint32_t MinTileY;
+			uint32_t MaxTileX;
+			uint32_t MaxTileY;
+		};
+
+		void AddScreenTriangle(glm::vec3 a, glm::vec3 b, glm::vec3 c);
+		void RasterizeTileRows(uint32_t firstRow, uint32_t endRow);
+		void UpdateTile(uint32_t tileIndex, uint32_t coverage, float depth);
+
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		uint32_t m_TilesX = 0;
+		uint32_t m_TilesY = 0;
+		// Per tile: the farthest depth of the fully covered reference layer, then the farthest depth and
+		// coverage of the working layer still being filled in.
+		std::vector<float> m_ReferenceDepth;
+		std::vector<float> m_WorkingDepth;
+		std::vector<uint32_t> m_WorkingMask;
+		std::vector<ScreenTriangle> m_Triangles;
+	};
+}
@@ -8,7 +8,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               December 24, 2025
- *      Last Modified on:    July 05, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #include "pch.h"
@@ -91,10 +91,16 @@ namespace FuturaLibrary
 		Submit(submission.Material->GetShader(), submission.Mesh->GetVertexArray(), submission.Transform);
 	}
 
-	void Renderer::Submit(const Ref<StaticWorld>& world, const Ref<Material>& fallbackMaterial)
+	void Renderer::Submit(const Ref<StaticWorld>& world, const Ref<Material>& fallbackMaterial, const glm::mat4& instanceTransform)
 	{
 		FT_CORE_ASSERT(m_SceneData, "Renderer has not been initialized!");
-		StaticWorldRenderer::Submit(world, fallbackMaterial, m_SceneData->ViewProjectionMatrix);
+		StaticWorldRenderer::Submit(world, fallbackMaterial, m_SceneData->ViewProjectionMatrix, instanceTransform);
+	}
+
+	void Renderer::SubmitStaticWorlds(const std::vector<StaticWorldDraw>& draws, const Ref<Material>& fallbackMaterial)
+	{
+		FT_CORE_ASSERT(m_SceneData, "Renderer has not been initialized!");
+		StaticWorldRenderer::Submit(draws, fallbackMaterial, m_SceneData->ViewProjectionMatrix);
 	}
 
 	void Renderer::Submit(const Ref<Material>& material, const Ref<Mesh>& mesh, const glm::mat4& transform)
@@ -102,11 +108,21 @@ namespace FuturaLibrary
 		Submit({ material, mesh, transform });
 	}
 
-	void Renderer::RecordWorldSurfaceStats(uint32_t totalSurfaces, uint32_t visibleSurfaces)
+	void Renderer::RecordWorldSurfaceStats(uint32_t totalSurfaces, uint32_t visibleSurfaces, const FrustumCullStats& cullStats)
 	{
 		FT_CORE_ASSERT(m_SceneData, "Renderer has not been initialized!");
 		m_SceneData->Stats.TotalSurfaces += totalSurfaces;
 		m_SceneData->Stats.CulledSurfaces += totalSurfaces - visibleSurfaces;
+		m_SceneData->Stats.CullCellsTested += cullStats.CellsTested;
+		m_SceneData->Stats.CullSurfacesTested += cullStats.SurfacesTested;
+	}
+
+	void Renderer::RecordOcclusionStats(const OcclusionCullStats& occlusionStats)
+	{
+		FT_CORE_ASSERT(m_SceneData, "Renderer has not been initialized!");
+		m_SceneData->Stats.OccludedSurfaces += occlusionStats.SurfacesOccluded;
+		m_SceneData->Stats.Occluders += occlusionStats.Occluders;
+		m_SceneData->Stats.OccluderTriangles += occlusionStats.OccluderTriangles;
 	}
 
 	const RenderStats& Renderer::GetStats()
@@ -4,9 +4,11 @@
 
 #include "FuturaLibrary/graphics/g_Shader.h"
 #include "FuturaLibrary/graphics/g_VertexArray.h"
+#include "FuturaLibrary/renderer/r_Frustum.h"
 #include "FuturaLibrary/renderer/r_Material.h"
 #include "FuturaLibrary/renderer/r_Mesh.h"
 #include "FuturaLibrary/renderer/r_RenderCommand.h"
+#include "FuturaLibrary/renderer/r_StaticWorldRenderer.h"
 #include <glm/glm.hpp>
 
 namespace FuturaLibrary
@@ -34,6 +36,14 @@ namespace FuturaLibrary
 		uint32_t VisibleSurfaces = 0;
 		uint32_t TotalSurfaces = 0;
 		uint32_t CulledSurfaces = 0;
+		// Grid cells or BVH nodes classified against the frustum, and surfaces that still needed their own test.
+		uint32_t CullCellsTested = 0;
+		uint32_t CullSurfacesTested = 0;
+		// Frustum-visible surfaces hidden behind occluders in the software occlusion buffer; they are
+		// also counted in CulledSurfaces.
+		uint32_t OccludedSurfaces = 0;
+		uint32_t Occluders = 0;
+		uint32_t OccluderTriangles = 0;
 	};
 
 	class FT_API Renderer
@@ -43,10 +53,13 @@ namespace FuturaLibrary
 		static void BeginFrame(const RenderFrameState& frameState);
 		static void BeginScene(const glm::mat4& viewProjection);
 		static void EndScene(); 
-		static void Submit(const Ref<StaticWorld>& world, const Ref<Material>& fallbackMaterial);
+		static void Submit(const Ref<StaticWorld>& world, const Ref<Material>& fallbackMaterial, const glm::mat4& instanceTransform = glm::mat4(1.0f));
+		// Culling and submission building for all worlds run on worker jobs; draws stay on this thread.
+		static void SubmitStaticWorlds(const std::vector<StaticWorldDraw>& draws, const Ref<Material>& fallbackMaterial);
 		static void Submit(const RenderSubmission& submission);
 		static void Submit(const Ref<Material>& material, const Ref<Mesh>& mesh, const glm::mat4& transform);
-		static void RecordWorldSurfaceStats(uint32_t totalSurfaces, uint32_t visibleSurfaces);
+		static void RecordWorldSurfaceStats(uint32_t totalSurfaces, uint32_t visibleSurfaces, const FrustumCullStats& cullStats);
+		static void RecordOcclusionStats(const OcclusionCullStats& occlusionStats);
 		static const RenderStats& GetStats();
 
 	private: 
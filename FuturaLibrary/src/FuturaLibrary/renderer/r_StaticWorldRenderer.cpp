@@ -3,119 +3,323 @@
 
 #include "FuturaLibrary/renderer/r_Renderer.h"
 #include "FuturaLibrary/resources/r_StaticWorld.h"
+#include "FuturaLibrary/utils/u_ParallelFor.h"
 
 namespace FuturaLibrary
 {
 	namespace
 	{
-		struct FrustumPlane
+		// Below this many surfaces per job, starting a thread costs more than the work it takes over.
+		constexpr size_t MinSurfacesPerJob = 2048;
+
+		struct DrawCullState
 		{
-			glm::vec3 Normal = glm::vec3(0.0f);
-			float Distance = 0.0f;
+			WorldQueryContext Context;
+			Frustum ViewFrustum;
+			glm::mat4 LocalToClip = glm::mat4(1.0f);
+			// Zero when the whole world is outside the frustum.
+			uint32_t SurfaceCount = 0;
+			// Where this draw's surfaces start in the range the jobs split.
+			uint32_t FirstJobSurface = 0;
+			FrustumCullStats CullStats;
 		};
 
-		struct Frustum
+		// A surface that passed the frustum, with its screen rectangle when occlusion culling is on.
+		struct FrustumVisibleSurface
 		{
-			FrustumPlane Planes[6];
+			uint32_t DrawIndex = 0;
+			uint32_t SurfaceIndex = 0;
+			bool HasRect = false;
+			OcclusionRect Rect;
 		};
 
-		glm::vec4 GetMatrixRow(const glm::mat4& matrix, uint32_t row)
+		struct OccluderCandidate
 		{
-			return { matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row] };
-		}
+			float ScreenArea = 0.0f;
+			uint32_t DrawIndex = 0;
+			uint32_t SurfaceIndex = 0;
+		};
 
-		FrustumPlane NormalizePlane(const glm::vec4& plane)
+		// One job's slice of the visible draws' surface ranges laid end to end.
+		struct SubmissionJob
 		{
-			const glm::vec3 normal = glm::vec3(plane);
-			const float length = glm::length(normal);
-			if (length == 0.0f)
-				return {};
+			std::vector<uint32_t> VisibleSurfaces;
+			std::vector<FrustumVisibleSurface> FrustumVisible;
+			std::vector<OccluderCandidate> OccluderCandidates;
+			std::vector<StaticWorldSurfaceSubmission> Submissions;
+			FrustumCullStats CullStats;
+			OcclusionCullStats OcclusionStats;
+		};
 
-			return { normal / length, plane.w / length };
+		// Reused across frames. Submit runs on the render thread and each job writes only its own entry.
+		std::vector<DrawCullState> s_DrawStates;
+		std::vector<SubmissionJob> s_Jobs;
+		std::vector<StaticWorldDraw> s_SingleDraw;
+		std::vector<OccluderCandidate> s_OccluderCandidates;
+		OcclusionCullingSettings s_OcclusionSettings;
+		OcclusionBuffer s_OcclusionBuffer;
+
+		// Biggest on screen first; draw and surface order break ties so the pick never varies between runs.
+		bool IsBetterOccluder(const OccluderCandidate& a, const OccluderCandidate& b)
+		{
+			if (a.ScreenArea != b.ScreenArea)
+				return a.ScreenArea > b.ScreenArea;
+			if (a.DrawIndex != b.DrawIndex)
+				return a.DrawIndex < b.DrawIndex;
+			return a.SurfaceIndex < b.SurfaceIndex;
 		}
 
-		Frustum ExtractFrustum(const glm::mat4& viewProjection)
-		{
-			const glm::vec4 row0 = GetMatrixRow(viewProjection, 0);
-			const glm::vec4 row1 = GetMatrixRow(viewProjection, 1);
-			const glm::vec4 row2 = GetMatrixRow(viewProjection, 2);
-			const glm::vec4 row3 = GetMatrixRow(viewProjection, 3);
-
-			Frustum frustum;
-			frustum.Planes[0] = NormalizePlane(row3 + row0);
-			frustum.Planes[1] = NormalizePlane(row3 - row0);
-			frustum.Planes[2] = NormalizePlane(row3 + row1);
-			frustum.Planes[3] = NormalizePlane(row3 - row1);
-			frustum.Planes[4] = NormalizePlane(row3 + row2);
-			frustum.Planes[5] = NormalizePlane(row3 - row2);
-			return frustum;
+		const Ref<Material>& ResolveSurfaceMaterial(const WorldSurface& surface, const std::vector<WorldMaterialRef>& materials, const Ref<Material>& fallbackMaterial)
+		{
+			if (surface.MaterialIndex < materials.size() && materials[surface.MaterialIndex].MaterialAsset)
+				return materials[surface.MaterialIndex].MaterialAsset;
+			return fallbackMaterial;
 		}
 
-		bool IsVisible(const AxisAlignedBounds& bounds, const Frustum& frustum)
+		// Clip-space offset that moves a point of the draw's world straight away from the camera by
+		// distance, in the world's own units. Perspective w grows with view depth; an orthographic
+		// projection has a constant w, so its depth row is used instead.
+		glm::vec4 GetDepthPushOffset(const glm::mat4& localToClip, float distance)
 		{
-			if (!bounds.IsValid)
-				return true;
+			glm::vec3 awayFromCamera(localToClip[0][3], localToClip[1][3], localToClip[2][3]);
+			if (glm::dot(awayFromCamera, awayFromCamera) <= 1e-12f)
+				awayFromCamera = glm::vec3(localToClip[0][2], localToClip[1][2], localToClip[2][2]);
+			if (distance <= 0.0f || glm::dot(awayFromCamera, awayFromCamera) <= 1e-12f)
+				return glm::vec4(0.0f);
 
-			for (const FrustumPlane& plane : frustum.Planes)
+			return localToClip * glm::vec4(glm::normalize(awayFromCamera) * distance, 0.0f);
+		}
+
+		// Draws the chosen occluders' collision triangles, which are already welded and, with
+		// StaticWorldSettings::SimplifyTolerance, simplified, so they double as occluder proxies.
+		// Every corner is pushed back by the world's collision error bound first, so rounding, welding
+		// and simplification can never put an occluder in front of the surface it stands in for.
+		void RasterizeOccluders(const std::vector<StaticWorldDraw>& draws, OcclusionCullStats& stats)
+		{
+			const OcclusionCullingSettings& settings = s_OcclusionSettings;
+			const size_t occluderCount = std::min<size_t>(s_OccluderCandidates.size(), settings.MaxOccluders);
+			std::partial_sort(s_OccluderCandidates.begin(), s_OccluderCandidates.begin() + occluderCount, s_OccluderCandidates.end(), IsBetterOccluder);
+
+			for (size_t i = 0; i < occluderCount; i++)
 			{
-				const glm::vec3 positiveVertex =
+				const OccluderCandidate& candidate = s_OccluderCandidates[i];
+				const StaticWorld& world = *draws[candidate.DrawIndex].World;
+				const SurfaceTriangleRange range = world.GetSurfaceTriangleRange(candidate.SurfaceIndex);
+				if (stats.OccluderTriangles + range.TriangleCount > settings.MaxOccluderTriangles)
+					continue;
+
+				const glm::mat4& localToClip = s_DrawStates[candidate.DrawIndex].LocalToClip;
+				const glm::vec4 depthPush = GetDepthPushOffset(localToClip, world.GetCollisionErrorBound());
+				for (uint32_t triangleIndex = range.FirstTriangle; triangleIndex < range.FirstTriangle + range.TriangleCount; triangleIndex++)
 				{
-					plane.Normal.x >= 0.0f ? bounds.Max.x : bounds.Min.x,
-					plane.Normal.y >= 0.0f ? bounds.Max.y : bounds.Min.y,
-					plane.Normal.z >= 0.0f ? bounds.Max.z : bounds.Min.z
-				};
+					glm::vec3 a;
+					glm::vec3 b;
+					glm::vec3 c;
+					world.GetCollisionTriangleCorners(triangleIndex, a, b, c);
+					s_OcclusionBuffer.AddOccluderTriangle(
+						localToClip * glm::vec4(a, 1.0f) + depthPush,
+						localToClip * glm::vec4(b, 1.0f) + depthPush,
+						localToClip * glm::vec4(c, 1.0f) + depthPush);
+				}
 
-				if (glm::dot(plane.Normal, positiveVertex) + plane.Distance < 0.0f)
-					return false;
+				stats.Occluders++;
+				stats.OccluderTriangles += range.TriangleCount;
 			}
 
-			return true;
+			s_OcclusionBuffer.Rasterize(settings.ThreadCount);
 		}
 
 		StaticWorldSurfaceSubmission CreateSubmission(
 			const WorldSurface& surface,
 			const std::vector<WorldMaterialRef>& materials,
-			const Ref<Material>& fallbackMaterial
+			const Ref<Material>& fallbackMaterial,
+			const glm::mat4& instanceTransform
 		)
 		{
 			StaticWorldSurfaceSubmission submission;
-			submission.Material = fallbackMaterial;
+			submission.Material = ResolveSurfaceMaterial(surface, materials, fallbackMaterial);
 			submission.Mesh = surface.MeshAsset;
-			submission.Transform = surface.Transform.Matrix;
+			submission.Transform = instanceTransform * surface.Transform.Matrix;
 			submission.SourceSurfaceIndex = surface.SourceSubmeshIndex;
-
-			if (surface.MaterialIndex < materials.size() && materials[surface.MaterialIndex].MaterialAsset)
-				submission.Material = materials[surface.MaterialIndex].MaterialAsset;
-
 			return submission;
 		}
 	}
 
-	void StaticWorldRenderer::Submit(const Ref<StaticWorld>& world, const Ref<Material>& fallbackMaterial, const glm::mat4& viewProjection)
+	void StaticWorldRenderer::Submit(const Ref<StaticWorld>& world, const Ref<Material>& fallbackMaterial, const glm::mat4& viewProjection, const glm::mat4& instanceTransform)
 	{
-		if (!world || world->IsEmpty())
-			return;
+		s_SingleDraw.resize(1);
+		s_SingleDraw[0] = { world, instanceTransform };
+		Submit(s_SingleDraw, fallbackMaterial, viewProjection);
+		s_SingleDraw[0].World.reset();
+	}
 
-		const Frustum frustum = ExtractFrustum(viewProjection);
-		const uint32_t totalSurfaces = static_cast<uint32_t>(world->GetSurfaces().size());
-		uint32_t visibleSurfaces = 0;
-		if (!IsVisible(world->GetWorldBounds(), frustum))
+	void StaticWorldRenderer::Submit(const std::vector<StaticWorldDraw>& draws, const Ref<Material>& fallbackMaterial, const glm::mat4& viewProjection)
+	{
+		if (s_DrawStates.size() < draws.size())
+			s_DrawStates.resize(draws.size());
+
+		// Planes taken from viewProjection * instanceTransform are already in the world's own space,
+		// so its cells and surface bounds are tested without transforming them out.
+		uint32_t totalSurfaces = 0;
+		uint32_t jobSurfaces = 0;
+		for (size_t drawIndex = 0; drawIndex < draws.size(); drawIndex++)
 		{
-			Renderer::RecordWorldSurfaceStats(totalSurfaces, visibleSurfaces);
-			return;
+			const StaticWorldDraw& draw = draws[drawIndex];
+			DrawCullState& state = s_DrawStates[drawIndex];
+			state.SurfaceCount = 0;
+			state.FirstJobSurface = jobSurfaces;
+			state.CullStats = {};
+			if (!draw.World || draw.World->IsEmpty())
+				continue;
+
+			const uint32_t surfaceCount = static_cast<uint32_t>(draw.World->GetSurfaces().size());
+			totalSurfaces += surfaceCount;
+			state.LocalToClip = viewProjection * draw.InstanceTransform;
+			state.ViewFrustum = ExtractFrustum(state.LocalToClip);
+			if (!IsVisible(state.ViewFrustum, draw.World->GetWorldBounds()))
+				continue;
+
+			state.SurfaceCount = surfaceCount;
+			jobSurfaces += surfaceCount;
 		}
 
-		const std::vector<WorldMaterialRef>& materials = world->GetMaterials();
-		for (const WorldSurface& surface : world->GetSurfaces())
+		// Each draw walks its world's cells once into its own context; draws are independent, so the
+		// walks run side by side. Draws of one shared world still get separate contexts.
+		const uint32_t markJobCount = std::min(GetParallelChunkCount(jobSurfaces, MinSurfacesPerJob), static_cast<uint32_t>(std::max<size_t>(draws.size(), 1)));
+		ParallelForChunks(draws.size(), markJobCount, [&](uint32_t, size_t begin, size_t end)
 		{
-			if (!IsVisible(surface.WorldBounds, frustum))
-				continue;
+			for (size_t drawIndex = begin; drawIndex < end; drawIndex++)
+			{
+				DrawCullState& state = s_DrawStates[drawIndex];
+				if (state.SurfaceCount > 0)
+					draws[drawIndex].World->MarkVisibleSurfaces(state.Context, state.ViewFrustum, &state.CullStats);
+			}
+		});
 
-			const StaticWorldSurfaceSubmission submission = CreateSubmission(surface, materials, fallbackMaterial);
-			Renderer::Submit({ submission.Material, submission.Mesh, submission.Transform });
-			visibleSurfaces++;
+		// Jobs split the visible draws' surface ranges laid end to end and test the marked surfaces. Job
+		// boundaries depend only on the surface counts and jobs are merged in job order, so the draw order
+		// is the same on every run and matches a serial submit.
+		const OcclusionCullingSettings& occlusionSettings = s_OcclusionSettings;
+		const bool useOcclusion = occlusionSettings.Enabled && jobSurfaces > 0;
+		if (useOcclusion)
+		{
+			if (s_OcclusionBuffer.GetWidth() != occlusionSettings.Width || s_OcclusionBuffer.GetHeight() != occlusionSettings.Height)
+				s_OcclusionBuffer.Resize(occlusionSettings.Width, occlusionSettings.Height);
+			s_OcclusionBuffer.Clear();
 		}
 
-		Renderer::RecordWorldSurfaceStats(totalSurfaces, visibleSurfaces);
+		const float minOccluderArea = occlusionSettings.MinOccluderScreenArea * static_cast<float>(s_OcclusionBuffer.GetWidth() * s_OcclusionBuffer.GetHeight());
+		const uint32_t jobCount = GetParallelChunkCount(jobSurfaces, MinSurfacesPerJob);
+		if (s_Jobs.size() < jobCount)
+			s_Jobs.resize(jobCount);
+
+		ParallelForChunks(jobSurfaces, jobCount, [&](uint32_t jobIndex, size_t begin, size_t end)
+		{
+			SubmissionJob& job = s_Jobs[jobIndex];
+			job.FrustumVisible.clear();
+			job.OccluderCandidates.clear();
+			job.CullStats = {};
+			for (size_t drawIndex = 0; drawIndex < draws.size(); drawIndex++)
+			{
+				const DrawCullState& state = s_DrawStates[drawIndex];
+				const size_t drawBegin = state.FirstJobSurface;
+				const size_t drawEnd = drawBegin + state.SurfaceCount;
+				if (drawEnd <= begin || drawBegin >= end)
+					continue;
+
+				const StaticWorld& world = *draws[drawIndex].World;
+				const uint32_t firstSurface = static_cast<uint32_t>(std::max(begin, drawBegin) - drawBegin);
+				const uint32_t endSurface = static_cast<uint32_t>(std::min(end, drawEnd) - drawBegin);
+				job.VisibleSurfaces.clear();
+				world.CollectVisibleSurfaces(state.Context, state.ViewFrustum, firstSurface, endSurface - firstSurface, job.VisibleSurfaces, &job.CullStats);
+
+				const std::vector<WorldSurface>& surfaces = world.GetSurfaces();
+				for (uint32_t surfaceIndex : job.VisibleSurfaces)
+				{
+					FrustumVisibleSurface visible;
+					visible.DrawIndex = static_cast<uint32_t>(drawIndex);
+					visible.SurfaceIndex = surfaceIndex;
+					if (useOcclusion)
+					{
+						// Boxes reaching past the near plane are never occluded, but fill the screen as occluders.
+						const AxisAlignedBounds& bounds = surfaces[surfaceIndex].WorldBounds;
+						visible.HasRect = bounds.IsValid && s_OcclusionBuffer.ProjectBounds(state.LocalToClip, bounds.Min, bounds.Max, visible.Rect);
+						const float screenArea = visible.HasRect
+							? s_OcclusionBuffer.GetVisibleArea(visible.Rect)
+							: static_cast<float>(s_OcclusionBuffer.GetWidth() * s_OcclusionBuffer.GetHeight());
+						const Ref<Material>& material = ResolveSurfaceMaterial(surfaces[surfaceIndex], world.GetMaterials(), fallbackMaterial);
+						if (bounds.IsValid && screenArea >= minOccluderArea && material && material->IsOpaque() &&
+							world.GetSurfaceTriangleRange(surfaceIndex).TriangleCount > 0)
+							job.OccluderCandidates.push_back({ screenArea, visible.DrawIndex, surfaceIndex });
+					}
+					job.FrustumVisible.push_back(visible);
+				}
+			}
+		});
+
+		OcclusionCullStats occlusionStats;
+		if (useOcclusion)
+		{
+			s_OccluderCandidates.clear();
+			for (uint32_t jobIndex = 0; jobIndex < jobCount; jobIndex++)
+				s_OccluderCandidates.insert(s_OccluderCandidates.end(), s_Jobs[jobIndex].OccluderCandidates.begin(), s_Jobs[jobIndex].OccluderCandidates.end());
+			RasterizeOccluders(draws, occlusionStats);
+		}
+
+		// Occlusion tests only read the buffer, so the same jobs test and build submissions side by side.
+		ParallelForChunks(jobCount, jobCount, [&](uint32_t jobIndex, size_t, size_t)
+		{
+			SubmissionJob& job = s_Jobs[jobIndex];
+			job.Submissions.clear();
+			job.OcclusionStats = {};
+			for (const FrustumVisibleSurface& visible : job.FrustumVisible)
+			{
+				if (visible.HasRect)
+				{
+					job.OcclusionStats.SurfacesTested++;
+					if (s_OcclusionBuffer.IsOccluded(visible.Rect))
+					{
+						job.OcclusionStats.SurfacesOccluded++;
+						continue;
+					}
+				}
+
+				const StaticWorldDraw& draw = draws[visible.DrawIndex];
+				job.Submissions.push_back(CreateSubmission(draw.World->GetSurfaces()[visible.SurfaceIndex], draw.World->GetMaterials(), fallbackMaterial, draw.InstanceTransform));
+			}
+		});
+
+		// Only the GL calls stay on this thread.
+		uint32_t visibleSurfaces = 0;
+		FrustumCullStats cullStats;
+		for (size_t drawIndex = 0; drawIndex < draws.size(); drawIndex++)
+			cullStats.CellsTested += s_DrawStates[drawIndex].CullStats.CellsTested;
+
+		for (uint32_t jobIndex = 0; jobIndex < jobCount; jobIndex++)
+		{
+			SubmissionJob& job = s_Jobs[jobIndex];
+			for (const StaticWorldSurfaceSubmission& submission : job.Submissions)
+				Renderer::Submit({ submission.Material, submission.Mesh, submission.Transform });
+
+			visibleSurfaces += static_cast<uint32_t>(job.Submissions.size());
+			cullStats.SurfacesTested += job.CullStats.SurfacesTested;
+			occlusionStats.SurfacesTested += job.OcclusionStats.SurfacesTested;
+			occlusionStats.SurfacesOccluded += job.OcclusionStats.SurfacesOccluded;
+			// Drop the references now rather than holding meshes and materials until the next frame.
+			job.Submissions.clear();
+		}
+
+		Renderer::RecordWorldSurfaceStats(totalSurfaces, visibleSurfaces, cullStats);
+		Renderer::RecordOcclusionStats(occlusionStats);
+	}
+
+	void StaticWorldRenderer::SetOcclusionSettings(const OcclusionCullingSettings& settings)
+	{
+		s_OcclusionSettings = settings;
+	}
+
+	const OcclusionCullingSettings& StaticWorldRenderer::GetOcclusionSettings()
+	{
+		return s_OcclusionSettings;
 	}
 }
@@ -5,7 +5,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 10, 2026
- *      Last Modified on:    July 10, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #pragma once
@@ -13,9 +13,12 @@
 #include "FuturaLibrary/core/c_core.h"
 #include "FuturaLibrary/renderer/r_Material.h"
 #include "FuturaLibrary/renderer/r_Mesh.h"
+#include "FuturaLibrary/renderer/r_OcclusionBuffer.h"
 
 #include <glm/glm.hpp>
 
+#include <vector>
+
 namespace FuturaLibrary
 {
 	class StaticWorld;
@@ -28,9 +31,24 @@ namespace FuturaLibrary
 		uint32_t SourceSurfaceIndex = 0;
 	};
 
+	// One placement of a world in a batched submit.
+	struct StaticWorldDraw
+	{
+		Ref<StaticWorld> World;
+		glm::mat4 InstanceTransform = glm::mat4(1.0f);
+	};
+
 	class FT_API StaticWorldRenderer
 	{
 	public:
-		static void Submit(const Ref<StaticWorld>& world, const Ref<Material>& fallbackMaterial, const glm::mat4& viewProjection);
+		// instanceTransform places a shared world; surfaces are drawn and culled at instanceTransform * their own transform.
+		static void Submit(const Ref<StaticWorld>& world, const Ref<Material>& fallbackMaterial, const glm::mat4& viewProjection, const glm::mat4& instanceTransform = glm::mat4(1.0f));
+		// Culls every draw and builds its submissions on worker jobs, then issues the draws on the calling
+		// thread in draw order and surface order, the same order as submitting the draws one by one.
+		// With occlusion culling on, the largest surfaces that pass the frustum are rasterized into a CPU
+		// occlusion buffer first and every other frustum-visible surface is tested against it.
+		static void Submit(const std::vector<StaticWorldDraw>& draws, const Ref<Material>& fallbackMaterial, const glm::mat4& viewProjection);
+		static void SetOcclusionSettings(const OcclusionCullingSettings& settings);
+		static const OcclusionCullingSettings& GetOcclusionSettings();
 	};
 }
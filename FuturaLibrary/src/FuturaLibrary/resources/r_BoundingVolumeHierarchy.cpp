@@ -0,0 +1,376 @@
+/**
+ *  @file r_BoundingVolumeHierarchy.cpp
+ *
+ *  @brief Implements binned SAH construction and box queries for BoundingVolumeHierarchy.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#include "pch.h"
+#include "r_BoundingVolumeHierarchy.h"
+
+#include <limits>
+
+namespace FuturaLibrary
+{
+	namespace
+	{
+		constexpr uint32_t MaxBinCount = 32;
+		constexpr uint32_t MaxBuildDepth = 60;
+
+		struct BuildBounds
+		{
+			glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+			glm::vec3 Max = glm::vec3(-std::numeric_limits<float>::max());
+
+			void Grow(const glm::vec3& point)
+			{
+				Min = glm::min(Min, point);
+				Max = glm::max(Max, point);
+			}
+
+			void Grow(const BuildBounds& bounds)
+			{
+				Min = glm::min(Min, bounds.Min);
+				Max = glm::max(Max, bounds.Max);
+			}
+
+			float SurfaceArea() const
+			{
+				const glm::vec3 extent = Max - Min;
+				if (extent.x < 0.0f || extent.y < 0.0f || extent.z < 0.0f)
+					return 0.0f;
+
+				return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+			}
+		};
+
+		struct BuildPrimitive
+		{
+			BuildBounds Bounds;
+			glm::vec3 Centroid = glm::vec3(0.0f);
+		};
+
+		struct BuildBin
+		{
+			BuildBounds Bounds;
+			uint32_t Count = 0;
+		};
+
+		struct BuildContext
+		{
+			std::vector<BVHNode>& Nodes;
+			std::vector<uint32_t>& PrimitiveIndices;
+			const std::vector<BuildPrimitive>& Primitives;
+			BVHBuildSettings Settings;
+			BVHBuildStats& Stats;
+		};
+
+		void UpdateNodeBounds(BVHNode& node, const BuildContext& context)
+		{
+			BuildBounds bounds;
+			for (uint32_t i = 0; i < node.PrimitiveCount; i++)
+				bounds.Grow(context.Primitives[context.PrimitiveIndices[node.LeftFirst + i]].Bounds);
+
+			node.Min = bounds.Min;
+			node.Max = bounds.Max;
+		}
+
+		bool FindSAHSplit(const BVHNode& node, const BuildContext& context, int& splitAxis, float& splitPosition, float& splitCost)
+		{
+			BuildBounds centroidBounds;
+			for (uint32_t i = 0; i < node.PrimitiveCount; i++)
+				centroidBounds.Grow(context.Primitives[context.PrimitiveIndices[node.LeftFirst + i]].Centroid);
+
+			splitCost = std::numeric_limits<float>::max();
+			const uint32_t binCount = std::clamp(context.Settings.BinCount, 2u, MaxBinCount);
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float boundsMin = centroidBounds.Min[axis];
+				const float boundsMax = centroidBounds.Max[axis];
+				if (boundsMax <= boundsMin)
+					continue;
+
+				BuildBin bins[MaxBinCount];
+				const float binScale = static_cast<float>(binCount) / (boundsMax - boundsMin);
+				for (uint32_t i = 0; i < node.PrimitiveCount; i++)
+				{
+					const BuildPrimitive& primitive = context.Primitives[context.PrimitiveIndices[node.LeftFirst + i]];
+					const uint32_t binIndex = std::min(binCount - 1, static_cast<uint32_t>((primitive.Centroid[axis] - boundsMin) * binScale));
+					bins[binIndex].Count++;
+					bins[binIndex].Bounds.Grow(primitive.Bounds);
+				}
+
+				// Sweep the bins from both sides so every split plane is evaluated in linear time.
+				float leftArea[MaxBinCount - 1];
+				float rightArea[MaxBinCount - 1];
+				uint32_t leftCount[MaxBinCount - 1];
+				uint32_t rightCount[MaxBinCount - 1];
+				BuildBounds leftBounds;
+				BuildBounds rightBounds;
+				uint32_t leftSum = 0;
+				uint32_t rightSum = 0;
+				for (uint32_t i = 0; i < binCount - 1; i++)
+				{
+					leftSum += bins[i].Count;
+					leftCount[i] = leftSum;
+					leftBounds.Grow(bins[i].Bounds);
+					leftArea[i] = leftBounds.SurfaceArea();
+
+					rightSum += bins[binCount - 1 - i].Count;
+					rightCount[binCount - 2 - i] = rightSum;
+					rightBounds.Grow(bins[binCount - 1 - i].Bounds);
+					rightArea[binCount - 2 - i] = rightBounds.SurfaceArea();
+				}
+
+				const float binWidth = (boundsMax - boundsMin) / static_cast<float>(binCount);
+				for (uint32_t i = 0; i < binCount - 1; i++)
+				{
+					if (leftCount[i] == 0 || rightCount[i] == 0)
+						continue;
+
+					const float cost = static_cast<float>(leftCount[i]) * leftArea[i] + static_cast<float>(rightCount[i]) * rightArea[i];
+					if (cost < splitCost)
+					{
+						splitAxis = axis;
+						splitPosition = boundsMin + binWidth * static_cast<float>(i + 1);
+						splitCost = cost;
+					}
+				}
+			}
+
+			return splitCost < std::numeric_limits<float>::max();
+		}
+
+		void Subdivide(uint32_t nodeIndex, uint32_t depth, BuildContext& context)
+		{
+			context.Stats.MaxDepth = std::max(context.Stats.MaxDepth, depth);
+
+			BVHNode& node = context.Nodes[nodeIndex];
+			if (node.PrimitiveCount <= context.Settings.MaxLeafPrimitives || depth >= MaxBuildDepth)
+			{
+				context.Stats.LeafCount++;
+				return;
+			}
+
+			int splitAxis = 0;
+			float splitPosition = 0.0f;
+			float splitCost = 0.0f;
+			if (!FindSAHSplit(node, context, splitAxis, splitPosition, splitCost))
+			{
+				context.Stats.LeafCount++;
+				return;
+			}
+
+			const glm::vec3 extent = node.Max - node.Min;
+			const float parentArea = 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+			const float leafCost = static_cast<float>(node.PrimitiveCount) * parentArea;
+			if (splitCost >= leafCost)
+			{
+				context.Stats.LeafCount++;
+				return;
+			}
+
+			uint32_t first = node.LeftFirst;
+			uint32_t last = node.LeftFirst + node.PrimitiveCount - 1;
+			while (first <= last)
+			{
+				if (context.Primitives[context.PrimitiveIndices[first]].Centroid[splitAxis] < splitPosition)
+				{
+					first++;
+				}
+				else
+				{
+					std::swap(context.PrimitiveIndices[first], context.PrimitiveIndices[last]);
+					if (last == 0)
+						break;
+					last--;
+				}
+			}
+
+			const uint32_t leftCount = first - node.LeftFirst;
+			if (leftCount == 0 || leftCount == node.PrimitiveCount)
+			{
+				context.Stats.LeafCount++;
+				return;
+			}
+
+			const uint32_t leftChildIndex = static_cast<uint32_t>(context.Nodes.size());
+			BVHNode leftChild;
+			leftChild.LeftFirst = node.LeftFirst;
+			leftChild.PrimitiveCount = leftCount;
+			BVHNode rightChild;
+			rightChild.LeftFirst = first;
+			rightChild.PrimitiveCount = node.PrimitiveCount - leftCount;
+
+			// Growing the node array invalidates the reference above, so finish writing the parent first.
+			node.LeftFirst = leftChildIndex;
+			node.PrimitiveCount = 0;
+			context.Nodes.push_back(leftChild);
+			context.Nodes.push_back(rightChild);
+
+			UpdateNodeBounds(context.Nodes[leftChildIndex], context);
+			UpdateNodeBounds(context.Nodes[leftChildIndex + 1], context);
+			Subdivide(leftChildIndex, depth + 1, context);
+			Subdivide(leftChildIndex + 1, depth + 1, context);
+		}
+	}
+
+	void BoundingVolumeHierarchy::Build(const std::vector<AxisAlignedBounds>& primitiveBounds, const BVHBuildSettings& settings)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		Clear();
+
+		std::vector<BuildPrimitive> primitives(primitiveBounds.size());
+		m_PrimitiveIndices.reserve(primitiveBounds.size());
+		for (uint32_t i = 0; i < primitiveBounds.size(); i++)
+		{
+			const AxisAlignedBounds& bounds = primitiveBounds[i];
+			if (!bounds.IsValid)
+				continue;
+
+			primitives[i].Bounds.Min = bounds.Min;
+			primitives[i].Bounds.Max = bounds.Max;
+			primitives[i].Centroid = (bounds.Min + bounds.Max) * 0.5f;
+			m_PrimitiveIndices.push_back(i);
+		}
+
+		if (m_PrimitiveIndices.empty())
+			return;
+
+		// A binary tree with N leaves has 2N - 1 nodes; reserving keeps Subdivide from reallocating.
+		m_Nodes.reserve(m_PrimitiveIndices.size() * 2);
+		BVHNode root;
+		root.LeftFirst = 0;
+		root.PrimitiveCount = static_cast<uint32_t>(m_PrimitiveIndices.size());
+		m_Nodes.push_back(root);
+
+		BuildContext context{ m_Nodes, m_PrimitiveIndices, primitives, settings, m_Stats };
+		context.Settings.MaxLeafPrimitives = std::max(context.Settings.MaxLeafPrimitives, 1u);
+		UpdateNodeBounds(m_Nodes[0], context);
+		Subdivide(0, 1, context);
+
+		m_Nodes.shrink_to_fit();
+		m_Stats.NodeCount = static_cast<uint32_t>(m_Nodes.size());
+
+		const auto endTime = std::chrono::steady_clock::now();
+		m_Stats.BuildTimeMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+	}
+
+	void BoundingVolumeHierarchy::Refit(const std::vector<AxisAlignedBounds>& primitiveBounds)
+	{
+		// Children are always appended after their parent, so a reverse walk visits them first.
+		for (size_t nodeIndex = m_Nodes.size(); nodeIndex-- > 0;)
+		{
+			BVHNode& node = m_Nodes[nodeIndex];
+			BuildBounds bounds;
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = 0; i < node.PrimitiveCount; i++)
+				{
+					const uint32_t primitiveIndex = m_PrimitiveIndices[node.LeftFirst + i];
+					if (primitiveIndex < primitiveBounds.size() && primitiveBounds[primitiveIndex].IsValid)
+						bounds.Grow(BuildBounds{ primitiveBounds[primitiveIndex].Min, primitiveBounds[primitiveIndex].Max });
+				}
+			}
+			else
+			{
+				// An emptied child keeps inverted bounds, which Grow leaves out of the union.
+				bounds.Grow(BuildBounds{ m_Nodes[node.LeftFirst].Min, m_Nodes[node.LeftFirst].Max });
+				bounds.Grow(BuildBounds{ m_Nodes[node.LeftFirst + 1].Min, m_Nodes[node.LeftFirst + 1].Max });
+			}
+
+			node.Min = bounds.Min;
+			node.Max = bounds.Max;
+		}
+	}
+
+	void BoundingVolumeHierarchy::Clear()
+	{
+		m_Nodes.clear();
+		m_PrimitiveIndices.clear();
+		m_Stats = {};
+	}
+
+	bool BoundingVolumeHierarchy::Write(BinaryWriter& writer) const
+	{
+		return writer.Write(m_Stats) &&
+			writer.WriteArray(m_Nodes) &&
+			writer.WriteArray(m_PrimitiveIndices);
+	}
+
+	bool BoundingVolumeHierarchy::Read(BinaryReader& reader, uint32_t primitiveCount)
+	{
+		Clear();
+		if (!reader.Read(m_Stats) ||
+			!reader.ReadArray(m_Nodes) ||
+			!reader.ReadArray(m_PrimitiveIndices))
+		{
+			Clear();
+			return false;
+		}
+
+		bool valid = m_PrimitiveIndices.size() <= primitiveCount;
+		for (uint32_t primitiveIndex : m_PrimitiveIndices)
+			valid = valid && primitiveIndex < primitiveCount;
+
+		// Build always appends both children after their parent, so every link must point forward
+		// and every node except the root must be reached exactly once.
+		std::vector<uint32_t> nodeDepths(m_Nodes.size(), 0);
+		std::vector<uint8_t> reached(m_Nodes.size(), 0);
+		for (uint32_t nodeIndex = 0; valid && nodeIndex < m_Nodes.size(); nodeIndex++)
+		{
+			const BVHNode& node = m_Nodes[nodeIndex];
+			if (nodeIndex > 0 && !reached[nodeIndex])
+				valid = false;
+			else if (node.IsLeaf())
+				valid = static_cast<uint64_t>(node.LeftFirst) + node.PrimitiveCount <= m_PrimitiveIndices.size();
+			else if (node.LeftFirst <= nodeIndex || static_cast<uint64_t>(node.LeftFirst) + 1 >= m_Nodes.size() ||
+				reached[node.LeftFirst] || reached[node.LeftFirst + 1] || nodeDepths[nodeIndex] + 1 > MaxBuildDepth)
+				valid = false;
+			else
+			{
+				reached[node.LeftFirst] = reached[node.LeftFirst + 1] = 1;
+				nodeDepths[node.LeftFirst] = nodeDepths[node.LeftFirst + 1] = nodeDepths[nodeIndex] + 1;
+			}
+		}
+
+		if (!valid)
+			Clear();
+		return valid;
+	}
+
+	void BoundingVolumeHierarchy::QueryOverlaps(const AxisAlignedBounds& bounds, std::vector<uint32_t>& primitives) const
+	{
+		primitives.clear();
+		if (!bounds.IsValid || m_Nodes.empty())
+			return;
+
+		uint32_t stack[MaxTraversalDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const BVHNode& node = m_Nodes[stack[--stackSize]];
+			if (node.Min.x > bounds.Max.x || node.Max.x < bounds.Min.x ||
+				node.Min.y > bounds.Max.y || node.Max.y < bounds.Min.y ||
+				node.Min.z > bounds.Max.z || node.Max.z < bounds.Min.z)
+				continue;
+
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = 0; i < node.PrimitiveCount; i++)
+					primitives.push_back(m_PrimitiveIndices[node.LeftFirst + i]);
+
+				continue;
+			}
+
+			stack[stackSize++] = node.LeftFirst + 1;
+			stack[stackSize++] = node.LeftFirst;
+		}
+	}
+}
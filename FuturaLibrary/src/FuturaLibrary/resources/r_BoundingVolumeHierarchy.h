@@ -0,0 +1,196 @@
+/**
+ *  @file r_BoundingVolumeHierarchy.h
+ *
+ *  @brief Declares a binned surface-area-heuristic BVH over axis-aligned primitive bounds.
+ *
+ *  The hierarchy only knows about primitive bounds. Callers such as StaticWorld
+ *  keep ownership of the primitives and run their own narrow phase from the
+ *  traversal callbacks.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include "FuturaLibrary/core/c_core.h"
+#include "FuturaLibrary/renderer/r_Mesh.h"
+#include "FuturaLibrary/utils/u_BinaryStream.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace FuturaLibrary
+{
+	// Interior nodes store their left child in LeftFirst and the right child at LeftFirst + 1.
+	// Leaves store the first entry in the primitive index list and a non-zero PrimitiveCount.
+	struct BVHNode
+	{
+		glm::vec3 Min = glm::vec3(0.0f);
+		uint32_t LeftFirst = 0;
+		glm::vec3 Max = glm::vec3(0.0f);
+		uint32_t PrimitiveCount = 0;
+
+		bool IsLeaf() const { return PrimitiveCount > 0; }
+	};
+
+	struct BVHBuildSettings
+	{
+		uint32_t MaxLeafPrimitives = 4;
+		uint32_t BinCount = 16;
+	};
+
+	struct BVHBuildStats
+	{
+		uint32_t NodeCount = 0;
+		uint32_t LeafCount = 0;
+		uint32_t MaxDepth = 0;
+		float BuildTimeMs = 0.0f;
+	};
+
+	class FT_API BoundingVolumeHierarchy
+	{
+	public:
+		void Build(const std::vector<AxisAlignedBounds>& primitiveBounds, const BVHBuildSettings& settings = {});
+		// Recomputes node bounds bottom-up from new primitive bounds without changing the tree shape.
+		// Primitives whose bounds became invalid stay in their leaves but no longer widen them.
+		void Refit(const std::vector<AxisAlignedBounds>& primitiveBounds);
+		void Clear();
+		bool Write(BinaryWriter& writer) const;
+		// Restores a hierarchy saved by Write. The node links, leaf ranges and depth are validated
+		// against primitiveCount, so a corrupt file fails here instead of during traversal.
+		bool Read(BinaryReader& reader, uint32_t primitiveCount);
+
+		bool IsEmpty() const { return m_Nodes.empty(); }
+		const std::vector<BVHNode>& GetNodes() const { return m_Nodes; }
+		const std::vector<uint32_t>& GetPrimitiveIndices() const { return m_PrimitiveIndices; }
+		const BVHBuildStats& GetStats() const { return m_Stats; }
+
+		void QueryOverlaps(const AxisAlignedBounds& bounds, std::vector<uint32_t>& primitives) const;
+
+		// Visits leaf primitives front to back along the ray. The callback receives the primitive
+		// index and the current maximum distance, which it may shrink after a closer hit.
+		// Returning true from the callback stops the traversal.
+		template <typename PrimitiveFunction>
+		void TraverseRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, PrimitiveFunction&& primitiveFunction) const;
+
+		// Zero components are nudged to a tiny signed value so slab tests never compute 0 * inf.
+		static glm::vec3 CalculateInverseDirection(const glm::vec3& direction);
+
+	private:
+		static constexpr uint32_t MaxTraversalDepth = 64;
+
+		static bool RayIntersectsNode(const BVHNode& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& entryDistance);
+
+		std::vector<BVHNode> m_Nodes;
+		std::vector<uint32_t> m_PrimitiveIndices;
+		BVHBuildStats m_Stats;
+	};
+
+	inline glm::vec3 BoundingVolumeHierarchy::CalculateInverseDirection(const glm::vec3& direction)
+	{
+		constexpr float MinComponent = 1.0e-20f;
+		glm::vec3 inverseDirection;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const float component = direction[axis];
+			if (std::abs(component) < MinComponent)
+				inverseDirection[axis] = 1.0f / (component < 0.0f ? -MinComponent : MinComponent);
+			else
+				inverseDirection[axis] = 1.0f / component;
+		}
+
+		return inverseDirection;
+	}
+
+	inline bool BoundingVolumeHierarchy::RayIntersectsNode(
+		const BVHNode& node,
+		const glm::vec3& origin,
+		const glm::vec3& inverseDirection,
+		float maxDistance,
+		float& entryDistance)
+	{
+		const glm::vec3 t0 = (node.Min - origin) * inverseDirection;
+		const glm::vec3 t1 = (node.Max - origin) * inverseDirection;
+		const glm::vec3 tNear = glm::min(t0, t1);
+		const glm::vec3 tFar = glm::max(t0, t1);
+
+		entryDistance = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		const float exitDistance = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+		return entryDistance <= exitDistance;
+	}
+
+	template <typename PrimitiveFunction>
+	void BoundingVolumeHierarchy::TraverseRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, PrimitiveFunction&& primitiveFunction) const
+	{
+		if (m_Nodes.empty() || maxDistance <= 0.0f)
+			return;
+
+		const glm::vec3 inverseDirection = CalculateInverseDirection(direction);
+
+		float entryDistance = 0.0f;
+		if (!RayIntersectsNode(m_Nodes[0], origin, inverseDirection, maxDistance, entryDistance))
+			return;
+
+		struct StackEntry
+		{
+			uint32_t NodeIndex;
+			float EntryDistance;
+		};
+
+		StackEntry stack[MaxTraversalDepth];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = { 0, entryDistance };
+
+		while (stackSize > 0)
+		{
+			const StackEntry entry = stack[--stackSize];
+			if (entry.EntryDistance > maxDistance)
+				continue;
+
+			const BVHNode& node = m_Nodes[entry.NodeIndex];
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = 0; i < node.PrimitiveCount; i++)
+				{
+					if (primitiveFunction(m_PrimitiveIndices[node.LeftFirst + i], maxDistance))
+						return;
+				}
+
+				continue;
+			}
+
+			float leftDistance = 0.0f;
+			float rightDistance = 0.0f;
+			const bool hitLeft = RayIntersectsNode(m_Nodes[node.LeftFirst], origin, inverseDirection, maxDistance, leftDistance);
+			const bool hitRight = RayIntersectsNode(m_Nodes[node.LeftFirst + 1], origin, inverseDirection, maxDistance, rightDistance);
+
+			// Push the far child first so the near child is popped and tested first.
+			if (hitLeft && hitRight)
+			{
+				if (leftDistance <= rightDistance)
+				{
+					stack[stackSize++] = { node.LeftFirst + 1, rightDistance };
+					stack[stackSize++] = { node.LeftFirst, leftDistance };
+				}
+				else
+				{
+					stack[stackSize++] = { node.LeftFirst, leftDistance };
+					stack[stackSize++] = { node.LeftFirst + 1, rightDistance };
+				}
+			}
+			else if (hitLeft)
+			{
+				stack[stackSize++] = { node.LeftFirst, leftDistance };
+			}
+			else if (hitRight)
+			{
+				stack[stackSize++] = { node.LeftFirst + 1, rightDistance };
+			}
+		}
+	}
+}
@@ -0,0 +1,530 @@
+/**
+ *  @file r_BspTree.cpp
+ *
+ *  @brief Implements BSP compilation, validation and traversal for BspTree.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#include "pch.h"
+#include "r_BspTree.h"
+
+#include <cmath>
+#include <limits>
+
+namespace FuturaLibrary
+{
+	namespace
+	{
+		constexpr uint32_t NoPolygon = 0xffffffffu;
+		constexpr float MinTriangleArea = 1.0e-12f;
+
+		struct BuildPlane
+		{
+			glm::vec3 Normal = glm::vec3(0.0f);
+			float Distance = 0.0f;
+		};
+
+		// A convex fragment of one source triangle. Used fragments lie on a plane that already split
+		// one of their ancestors, so they are never picked again.
+		struct BuildPolygon
+		{
+			uint32_t FirstVertex = 0;
+			uint32_t VertexCount = 0;
+			uint32_t Triangle = 0;
+			bool Used = false;
+		};
+
+		enum class PolygonSide
+		{
+			Front,
+			Back,
+			On,
+			Spanning
+		};
+
+		struct BuildContext
+		{
+			std::vector<BspNode>& Nodes;
+			std::vector<BspLeaf>& Leaves;
+			std::vector<uint32_t>& LeafTriangles;
+			BspBuildStats& Stats;
+			BspBuildSettings Settings;
+			std::vector<BuildPlane> TrianglePlanes;
+			std::vector<glm::vec3> Vertices;
+			std::vector<BuildPolygon> Polygons;
+			std::vector<glm::vec3> ClipScratch;
+			std::vector<glm::vec3> FrontScratch;
+			std::vector<glm::vec3> BackScratch;
+			std::vector<uint32_t> TriangleScratch;
+		};
+
+		float GetPlaneDistance(const BuildPlane& plane, const glm::vec3& point)
+		{
+			return glm::dot(plane.Normal, point) - plane.Distance;
+		}
+
+		PolygonSide ClassifyPolygon(const BuildContext& context, const BuildPolygon& polygon, const BuildPlane& plane)
+		{
+			bool front = false;
+			bool back = false;
+			for (uint32_t i = 0; i < polygon.VertexCount; i++)
+			{
+				const float distance = GetPlaneDistance(plane, context.Vertices[polygon.FirstVertex + i]);
+				front = front || distance > context.Settings.PlaneEpsilon;
+				back = back || distance < -context.Settings.PlaneEpsilon;
+			}
+
+			if (front && back)
+				return PolygonSide::Spanning;
+			if (front)
+				return PolygonSide::Front;
+			return back ? PolygonSide::Back : PolygonSide::On;
+		}
+
+		uint32_t AddPolygon(BuildContext& context, const glm::vec3* vertices, uint32_t vertexCount, uint32_t triangle, bool used)
+		{
+			BuildPolygon polygon;
+			polygon.FirstVertex = static_cast<uint32_t>(context.Vertices.size());
+			polygon.VertexCount = vertexCount;
+			polygon.Triangle = triangle;
+			polygon.Used = used;
+			context.Vertices.insert(context.Vertices.end(), vertices, vertices + vertexCount);
+			context.Polygons.push_back(polygon);
+			return static_cast<uint32_t>(context.Polygons.size() - 1);
+		}
+
+		int GetVertexSide(const BuildContext& context, float distance)
+		{
+			if (distance > context.Settings.PlaneEpsilon)
+				return 1;
+			return distance < -context.Settings.PlaneEpsilon ? -1 : 0;
+		}
+
+		// Cuts a spanning fragment along the plane. Vertices within the epsilon go to both halves, so
+		// neither half gains a sliver edge across the plane.
+		void SplitPolygon(BuildContext& context, uint32_t polygonIndex, const BuildPlane& plane, uint32_t& frontPolygon, uint32_t& backPolygon)
+		{
+			// AddPolygon grows both arrays, so copy the fragment out before writing its halves.
+			const BuildPolygon polygon = context.Polygons[polygonIndex];
+			context.ClipScratch.assign(
+				context.Vertices.begin() + polygon.FirstVertex,
+				context.Vertices.begin() + polygon.FirstVertex + polygon.VertexCount
+			);
+			context.FrontScratch.clear();
+			context.BackScratch.clear();
+
+			for (uint32_t i = 0; i < polygon.VertexCount; i++)
+			{
+				const glm::vec3& current = context.ClipScratch[i];
+				const glm::vec3& next = context.ClipScratch[(i + 1) % polygon.VertexCount];
+				const float currentDistance = GetPlaneDistance(plane, current);
+				const float nextDistance = GetPlaneDistance(plane, next);
+				const int currentSide = GetVertexSide(context, currentDistance);
+				const int nextSide = GetVertexSide(context, nextDistance);
+
+				if (currentSide >= 0)
+					context.FrontScratch.push_back(current);
+				if (currentSide <= 0)
+					context.BackScratch.push_back(current);
+
+				if (currentSide * nextSide < 0)
+				{
+					const glm::vec3 crossing = current + (next - current) * (currentDistance / (currentDistance - nextDistance));
+					context.FrontScratch.push_back(crossing);
+					context.BackScratch.push_back(crossing);
+				}
+			}
+
+			frontPolygon = context.FrontScratch.size() >= 3
+				? AddPolygon(context, context.FrontScratch.data(), static_cast<uint32_t>(context.FrontScratch.size()), polygon.Triangle, polygon.Used)
+				: NoPolygon;
+			backPolygon = context.BackScratch.size() >= 3
+				? AddPolygon(context, context.BackScratch.data(), static_cast<uint32_t>(context.BackScratch.size()), polygon.Triangle, polygon.Used)
+				: NoPolygon;
+		}
+
+		// Scores candidate planes against the node's unused fragments and returns the position in
+		// polygons of the best unused one, or NoPolygon once every fragment has been used.
+		uint32_t ChooseSplitter(const BuildContext& context, const std::vector<uint32_t>& polygons)
+		{
+			std::vector<uint32_t> unused;
+			for (uint32_t i = 0; i < polygons.size(); i++)
+			{
+				if (!context.Polygons[polygons[i]].Used)
+					unused.push_back(i);
+			}
+
+			if (unused.empty())
+				return NoPolygon;
+
+			const uint32_t unusedCount = static_cast<uint32_t>(unused.size());
+			const uint32_t candidateCount = context.Settings.SplitCandidates == 0
+				? unusedCount
+				: std::min(context.Settings.SplitCandidates, unusedCount);
+
+			uint32_t bestPosition = NoPolygon;
+			float bestScore = std::numeric_limits<float>::max();
+			for (uint32_t candidate = 0; candidate < candidateCount; candidate++)
+			{
+				// Even spacing instead of random picks keeps the tree identical from one build to the next.
+				const uint32_t position = unused[static_cast<uint32_t>((static_cast<uint64_t>(candidate) * unusedCount) / candidateCount)];
+				const BuildPlane& plane = context.TrianglePlanes[context.Polygons[polygons[position]].Triangle];
+
+				// Used fragments never split again, so only the unused ones shape the tree below.
+				uint32_t frontCount = 0;
+				uint32_t backCount = 0;
+				uint32_t spanningCount = 0;
+				for (uint32_t unusedPosition : unused)
+				{
+					const BuildPolygon& polygon = context.Polygons[polygons[unusedPosition]];
+					switch (ClassifyPolygon(context, polygon, plane))
+					{
+						case PolygonSide::Front:
+							frontCount++;
+							break;
+						case PolygonSide::Back:
+							backCount++;
+							break;
+						case PolygonSide::On:
+							if (glm::dot(context.TrianglePlanes[polygon.Triangle].Normal, plane.Normal) > 0.0f)
+								frontCount++;
+							else
+								backCount++;
+							break;
+						case PolygonSide::Spanning:
+							spanningCount++;
+							break;
+					}
+				}
+
+				const float imbalance = static_cast<float>(frontCount > backCount ? frontCount - backCount : backCount - frontCount);
+				const float score = context.Settings.SplitWeight * static_cast<float>(spanningCount) + context.Settings.BalanceWeight * imbalance;
+				if (score < bestScore)
+				{
+					bestScore = score;
+					bestPosition = position;
+				}
+			}
+
+			return bestPosition;
+		}
+
+		uint32_t MakeLeaf(BuildContext& context, const std::vector<uint32_t>& polygons, bool solid)
+		{
+			BspLeaf leaf;
+			leaf.Min = glm::vec3(std::numeric_limits<float>::max());
+			leaf.Max = glm::vec3(-std::numeric_limits<float>::max());
+			leaf.Solid = solid ? 1u : 0u;
+			leaf.FirstTriangle = static_cast<uint32_t>(context.LeafTriangles.size());
+
+			context.TriangleScratch.clear();
+			for (uint32_t polygonIndex : polygons)
+			{
+				const BuildPolygon& polygon = context.Polygons[polygonIndex];
+				context.TriangleScratch.push_back(polygon.Triangle);
+				for (uint32_t i = 0; i < polygon.VertexCount; i++)
+				{
+					leaf.Min = glm::min(leaf.Min, context.Vertices[polygon.FirstVertex + i]);
+					leaf.Max = glm::max(leaf.Max, context.Vertices[polygon.FirstVertex + i]);
+				}
+			}
+
+			std::sort(context.TriangleScratch.begin(), context.TriangleScratch.end());
+			context.TriangleScratch.erase(std::unique(context.TriangleScratch.begin(), context.TriangleScratch.end()), context.TriangleScratch.end());
+			context.LeafTriangles.insert(context.LeafTriangles.end(), context.TriangleScratch.begin(), context.TriangleScratch.end());
+			leaf.TriangleCount = static_cast<uint32_t>(context.TriangleScratch.size());
+
+			context.Leaves.push_back(leaf);
+			context.Stats.LeafCount++;
+			if (solid)
+				context.Stats.SolidLeafCount++;
+			return BspTree::LeafLink | static_cast<uint32_t>(context.Leaves.size() - 1);
+		}
+
+		// Returns the link to the subtree built over polygons, which is released before recursing.
+		// Used fragments only ride along to the leaves they bound, for rendering; once no unused
+		// fragment is left, the region is solid exactly when it was reached through the back of its
+		// last plane.
+		uint32_t BuildNode(BuildContext& context, std::vector<uint32_t>& polygons, uint32_t depth, bool backSide)
+		{
+			context.Stats.MaxDepth = std::max(context.Stats.MaxDepth, depth);
+
+			const uint32_t splitterPosition = depth < context.Settings.MaxDepth ? ChooseSplitter(context, polygons) : NoPolygon;
+			if (splitterPosition == NoPolygon)
+			{
+				const bool unsplit = std::any_of(polygons.begin(), polygons.end(), [&context](uint32_t polygonIndex)
+				{
+					return !context.Polygons[polygonIndex].Used;
+				});
+				if (unsplit)
+					context.Stats.DepthLimitedLeaves++;
+				return MakeLeaf(context, polygons, backSide && !unsplit);
+			}
+
+			const uint32_t splitterPolygon = polygons[splitterPosition];
+			const BuildPlane plane = context.TrianglePlanes[context.Polygons[splitterPolygon].Triangle];
+
+			const uint32_t nodeIndex = static_cast<uint32_t>(context.Nodes.size());
+			BspNode node;
+			node.Normal = plane.Normal;
+			node.Distance = plane.Distance;
+			context.Nodes.push_back(node);
+			context.Stats.NodeCount++;
+
+			std::vector<uint32_t> frontPolygons;
+			std::vector<uint32_t> backPolygons;
+			for (uint32_t polygonIndex : polygons)
+			{
+				// The splitter lies on its own plane even if rounding pushed a clipped corner past the epsilon.
+				const PolygonSide side = polygonIndex == splitterPolygon
+					? PolygonSide::On
+					: ClassifyPolygon(context, context.Polygons[polygonIndex], plane);
+
+				switch (side)
+				{
+					case PolygonSide::Front:
+						frontPolygons.push_back(polygonIndex);
+						break;
+					case PolygonSide::Back:
+						backPolygons.push_back(polygonIndex);
+						break;
+					case PolygonSide::On:
+					{
+						BuildPolygon& polygon = context.Polygons[polygonIndex];
+						polygon.Used = true;
+						if (glm::dot(context.TrianglePlanes[polygon.Triangle].Normal, plane.Normal) > 0.0f)
+							frontPolygons.push_back(polygonIndex);
+						else
+							backPolygons.push_back(polygonIndex);
+						break;
+					}
+					case PolygonSide::Spanning:
+					{
+						uint32_t frontPolygon = NoPolygon;
+						uint32_t backPolygon = NoPolygon;
+						SplitPolygon(context, polygonIndex, plane, frontPolygon, backPolygon);
+						if (frontPolygon != NoPolygon)
+							frontPolygons.push_back(frontPolygon);
+						if (backPolygon != NoPolygon)
+							backPolygons.push_back(backPolygon);
+						context.Stats.SplitFragments++;
+						break;
+					}
+				}
+			}
+
+			std::vector<uint32_t>().swap(polygons);
+			const uint32_t frontLink = BuildNode(context, frontPolygons, depth + 1, false);
+			const uint32_t backLink = BuildNode(context, backPolygons, depth + 1, true);
+
+			// Growing the node array invalidates references, so the children are written by index.
+			context.Nodes[nodeIndex].Children[0] = frontLink;
+			context.Nodes[nodeIndex].Children[1] = backLink;
+			return nodeIndex;
+		}
+	}
+
+	void BspTree::Build(const std::vector<glm::vec3>& corners, const BspBuildSettings& settings)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		Clear();
+
+		BuildContext context{ m_Nodes, m_Leaves, m_LeafTriangles, m_Stats, settings };
+		context.Settings.MaxDepth = std::min(context.Settings.MaxDepth, MaxTreeDepth);
+		context.Settings.PlaneEpsilon = std::max(context.Settings.PlaneEpsilon, 0.0f);
+
+		const uint32_t triangleCount = static_cast<uint32_t>(corners.size() / 3);
+		context.TrianglePlanes.resize(triangleCount);
+		std::vector<uint32_t> polygons;
+		polygons.reserve(triangleCount);
+		for (uint32_t triangleIndex = 0; triangleIndex < triangleCount; triangleIndex++)
+		{
+			const glm::vec3* triangle = &corners[triangleIndex * 3];
+			const glm::vec3 normal = glm::cross(triangle[1] - triangle[0], triangle[2] - triangle[0]);
+			const float length = glm::length(normal);
+			if (!(length * 0.5f > MinTriangleArea) || !std::isfinite(length))
+				continue;
+
+			BuildPlane& plane = context.TrianglePlanes[triangleIndex];
+			plane.Normal = normal / length;
+			plane.Distance = glm::dot(plane.Normal, triangle[0]);
+			polygons.push_back(AddPolygon(context, triangle, 3, triangleIndex, false));
+		}
+
+		if (polygons.empty())
+			return;
+
+		m_RootLink = BuildNode(context, polygons, 0, false);
+
+		const auto endTime = std::chrono::steady_clock::now();
+		m_Stats.BuildTimeMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+	}
+
+	void BspTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Leaves.clear();
+		m_LeafTriangles.clear();
+		m_RootLink = LeafLink;
+		m_Stats = {};
+	}
+
+	bool BspTree::Write(BinaryWriter& writer) const
+	{
+		return writer.Write(m_Stats) &&
+			writer.Write(m_RootLink) &&
+			writer.WriteArray(m_Nodes) &&
+			writer.WriteArray(m_Leaves) &&
+			writer.WriteArray(m_LeafTriangles);
+	}
+
+	bool BspTree::Read(BinaryReader& reader, uint32_t triangleCount)
+	{
+		Clear();
+		if (!reader.Read(m_Stats) ||
+			!reader.Read(m_RootLink) ||
+			!reader.ReadArray(m_Nodes) ||
+			!reader.ReadArray(m_Leaves) ||
+			!reader.ReadArray(m_LeafTriangles))
+		{
+			Clear();
+			return false;
+		}
+
+		bool valid = m_Nodes.size() < LeafLink && m_Leaves.size() < LeafLink;
+		for (uint32_t triangleIndex : m_LeafTriangles)
+			valid = valid && triangleIndex < triangleCount;
+
+		for (const BspLeaf& leaf : m_Leaves)
+			valid = valid && static_cast<uint64_t>(leaf.FirstTriangle) + leaf.TriangleCount <= m_LeafTriangles.size() && leaf.Solid <= 1;
+
+		// Build numbers a node before its children, so links between nodes must point forward, every
+		// node but the root and every leaf must be reached exactly once, and an empty tree has no nodes.
+		std::vector<uint32_t> nodeDepths(m_Nodes.size(), 0);
+		std::vector<uint8_t> reachedNodes(m_Nodes.size(), 0);
+		std::vector<uint8_t> reachedLeaves(m_Leaves.size(), 0);
+		if (m_Leaves.empty())
+			valid = valid && m_Nodes.empty() && m_RootLink == LeafLink;
+		else if (m_Nodes.empty())
+			valid = valid && m_Leaves.size() == 1 && m_RootLink == LeafLink;
+		else
+			valid = valid && m_RootLink == 0;
+
+		if (valid && !m_Leaves.empty() && m_Nodes.empty())
+			reachedLeaves[0] = 1;
+
+		for (uint32_t nodeIndex = 0; valid && nodeIndex < m_Nodes.size(); nodeIndex++)
+		{
+			const BspNode& node = m_Nodes[nodeIndex];
+			if ((nodeIndex > 0 && !reachedNodes[nodeIndex]) ||
+				nodeDepths[nodeIndex] >= MaxTreeDepth ||
+				!std::isfinite(node.Normal.x) || !std::isfinite(node.Normal.y) || !std::isfinite(node.Normal.z) ||
+				!std::isfinite(node.Distance))
+			{
+				valid = false;
+				break;
+			}
+
+			for (uint32_t child : node.Children)
+			{
+				if (child & LeafLink)
+				{
+					const uint32_t leafIndex = child & ~LeafLink;
+					valid = valid && leafIndex < m_Leaves.size() && !reachedLeaves[leafIndex];
+					if (valid)
+						reachedLeaves[leafIndex] = 1;
+				}
+				else
+				{
+					valid = valid && child > nodeIndex && child < m_Nodes.size() && !reachedNodes[child];
+					if (valid)
+					{
+						reachedNodes[child] = 1;
+						nodeDepths[child] = nodeDepths[nodeIndex] + 1;
+					}
+				}
+			}
+		}
+
+		for (uint8_t reached : reachedLeaves)
+			valid = valid && reached;
+
+		if (!valid)
+			Clear();
+		return valid;
+	}
+
+	bool BspTree::IsPointSolid(const glm::vec3& point) const
+	{
+		if (m_Leaves.empty())
+			return false;
+
+		uint32_t link = m_RootLink;
+		while (!(link & LeafLink))
+		{
+			const BspNode& node = m_Nodes[link];
+			link = node.Children[glm::dot(node.Normal, point) - node.Distance >= 0.0f ? 0 : 1];
+		}
+
+		return m_Leaves[link & ~LeafLink].Solid != 0;
+	}
+
+	BspTraceResult BspTree::Trace(const glm::vec3& start, const glm::vec3& end) const
+	{
+		BspTraceResult result;
+		result.Position = end;
+		if (m_Leaves.empty())
+			return result;
+
+		TraceLink(m_RootLink, 0.0f, 1.0f, start, end, glm::vec3(0.0f), result);
+		if (result.Hit)
+			result.Position = start + (end - start) * result.Fraction;
+		return result;
+	}
+
+	// Walks the part of the segment between startFraction and endFraction through the subtree at link,
+	// nearest part first. entryNormal is the plane the segment crossed to get here, zero at the start.
+	bool BspTree::TraceLink(
+		uint32_t link,
+		float startFraction,
+		float endFraction,
+		const glm::vec3& start,
+		const glm::vec3& end,
+		const glm::vec3& entryNormal,
+		BspTraceResult& result) const
+	{
+		if (link & LeafLink)
+		{
+			if (!m_Leaves[link & ~LeafLink].Solid)
+				return false;
+
+			result.Hit = true;
+			result.StartSolid = entryNormal == glm::vec3(0.0f);
+			result.Fraction = startFraction;
+			result.Normal = result.StartSolid ? glm::vec3(0.0f, 1.0f, 0.0f) : entryNormal;
+			return true;
+		}
+
+		const BspNode& node = m_Nodes[link];
+		const float startDistance = glm::dot(node.Normal, start) - node.Distance;
+		const float endDistance = glm::dot(node.Normal, end) - node.Distance;
+		if (startDistance >= 0.0f && endDistance >= 0.0f)
+			return TraceLink(node.Children[0], startFraction, endFraction, start, end, entryNormal, result);
+		if (startDistance < 0.0f && endDistance < 0.0f)
+			return TraceLink(node.Children[1], startFraction, endFraction, start, end, entryNormal, result);
+
+		const float t = startDistance / (startDistance - endDistance);
+		const float crossingFraction = startFraction + (endFraction - startFraction) * t;
+		const glm::vec3 crossing = start + (end - start) * t;
+		const uint32_t nearSide = startDistance >= 0.0f ? 0 : 1;
+		if (TraceLink(node.Children[nearSide], startFraction, crossingFraction, start, crossing, entryNormal, result))
+			return true;
+
+		// Entering the far side through this plane; the surface there faces back toward the start.
+		const glm::vec3 crossingNormal = nearSide == 0 ? node.Normal : -node.Normal;
+		return TraceLink(node.Children[nearSide ^ 1], crossingFraction, endFraction, crossing, end, crossingNormal, result);
+	}
+}
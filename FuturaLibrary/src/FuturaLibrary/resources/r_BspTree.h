@@ -0,0 +1,160 @@
+/**
+ *  @file r_BspTree.h
+ *
+ *  @brief Declares a solid-leaf BSP tree compiled from collision triangles.
+ *
+ *  Every triangle plane becomes a splitter somewhere in the tree, and triangles
+ *  are clipped into fragments wherever a splitter cuts them. Leaves are convex
+ *  regions: empty leaves hold the fragments that bound them, and a region
+ *  behind every face around it is solid. Solidity follows the triangle winding,
+ *  so open meshes read as solid behind their open faces.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include "FuturaLibrary/core/c_core.h"
+#include "FuturaLibrary/utils/u_BinaryStream.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace FuturaLibrary
+{
+	// Children[0] is the front side of the plane and Children[1] the back. A child link with
+	// BspTree::LeafLink set indexes the leaf array; otherwise it indexes the node array.
+	struct BspNode
+	{
+		glm::vec3 Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+		float Distance = 0.0f;
+		uint32_t Children[2] = {};
+	};
+
+	// Triangles are the source triangles of the fragments bounding the leaf, sorted and unique.
+	// Min and Max cover those fragments and stay inverted for leaves without any.
+	struct BspLeaf
+	{
+		glm::vec3 Min = glm::vec3(0.0f);
+		uint32_t FirstTriangle = 0;
+		glm::vec3 Max = glm::vec3(0.0f);
+		uint32_t TriangleCount = 0;
+		uint32_t Solid = 0;
+	};
+
+	struct BspBuildSettings
+	{
+		// Unused triangle planes scored at each node, spread evenly over the node's fragments; 0 scores every one.
+		uint32_t SplitCandidates = 32;
+		// A plane scores SplitWeight per fragment it cuts plus BalanceWeight per fragment of imbalance
+		// between its sides; the lowest score splits the node. Raise SplitWeight for fewer fragments,
+		// BalanceWeight for a shallower tree.
+		float SplitWeight = 8.0f;
+		float BalanceWeight = 1.0f;
+		// Points this close to a plane count as on it.
+		float PlaneEpsilon = 0.001f;
+		// Planes on any root-to-leaf path, capped at BspTree::MaxTreeDepth. Regions still holding
+		// unsplit fragments at the limit become empty leaves.
+		uint32_t MaxDepth = 96;
+	};
+
+	struct BspBuildStats
+	{
+		uint32_t NodeCount = 0;
+		uint32_t LeafCount = 0;
+		uint32_t SolidLeafCount = 0;
+		uint32_t MaxDepth = 0;
+		// Fragments cut in two by a splitter, and leaves closed by MaxDepth with planes left unsplit.
+		uint32_t SplitFragments = 0;
+		uint32_t DepthLimitedLeaves = 0;
+		float BuildTimeMs = 0.0f;
+	};
+
+	struct BspTraceResult
+	{
+		bool Hit = false;
+		// The start point is already inside a solid leaf; Fraction is then 0 and Normal is meaningless.
+		bool StartSolid = false;
+		float Fraction = 1.0f;
+		glm::vec3 Position = glm::vec3(0.0f);
+		// Normal of the plane where the segment first enters solid, facing back toward the start.
+		glm::vec3 Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+	};
+
+	class FT_API BspTree
+	{
+	public:
+		static constexpr uint32_t LeafLink = 0x80000000u;
+		static constexpr uint32_t MaxTreeDepth = 128;
+
+		// Corners holds three points per triangle; triangle indices in the leaves refer to that order.
+		// Degenerate triangles are left out.
+		void Build(const std::vector<glm::vec3>& corners, const BspBuildSettings& settings = {});
+		void Clear();
+		bool Write(BinaryWriter& writer) const;
+		// Restores a tree saved by Write. Links, leaf ranges and depth are validated against
+		// triangleCount, so a corrupt file fails here instead of during traversal.
+		bool Read(BinaryReader& reader, uint32_t triangleCount);
+
+		bool IsEmpty() const { return m_Leaves.empty(); }
+		const std::vector<BspNode>& GetNodes() const { return m_Nodes; }
+		const std::vector<BspLeaf>& GetLeaves() const { return m_Leaves; }
+		const std::vector<uint32_t>& GetLeafTriangles() const { return m_LeafTriangles; }
+		const BspBuildStats& GetStats() const { return m_Stats; }
+
+		// Points on a plane belong to its front side. An empty tree has no solid space.
+		bool IsPointSolid(const glm::vec3& point) const;
+		// First entry into solid space along the segment from start to end.
+		BspTraceResult Trace(const glm::vec3& start, const glm::vec3& end) const;
+
+		// Visits the leaves that hold triangles, nearest the eye first: the side of each plane the eye
+		// is on is walked before the other, so a leaf can never be hidden by one visited after it.
+		// Returning true from the callback stops the traversal.
+		template <typename LeafFunction>
+		void TraverseFrontToBack(const glm::vec3& eye, LeafFunction&& leafFunction) const;
+
+	private:
+		bool TraceLink(uint32_t link, float startFraction, float endFraction, const glm::vec3& start, const glm::vec3& end, const glm::vec3& entryNormal, BspTraceResult& result) const;
+
+		std::vector<BspNode> m_Nodes;
+		std::vector<BspLeaf> m_Leaves;
+		std::vector<uint32_t> m_LeafTriangles;
+		uint32_t m_RootLink = LeafLink;
+		BspBuildStats m_Stats;
+	};
+
+	template <typename LeafFunction>
+	void BspTree::TraverseFrontToBack(const glm::vec3& eye, LeafFunction&& leafFunction) const
+	{
+		if (m_Leaves.empty())
+			return;
+
+		// Each level pops one link and pushes two, so the stack never holds more than depth + 1 links.
+		uint32_t stack[MaxTreeDepth + 1];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = m_RootLink;
+
+		while (stackSize > 0)
+		{
+			const uint32_t link = stack[--stackSize];
+			if (link & LeafLink)
+			{
+				const BspLeaf& leaf = m_Leaves[link & ~LeafLink];
+				if (leaf.TriangleCount > 0 && leafFunction(leaf))
+					return;
+
+				continue;
+			}
+
+			const BspNode& node = m_Nodes[link];
+			const bool eyeInFront = glm::dot(node.Normal, eye) - node.Distance >= 0.0f;
+
+			// Push the far side first so the eye's side is popped and visited first.
+			stack[stackSize++] = node.Children[eyeInFront ? 1 : 0];
+			stack[stackSize++] = node.Children[eyeInFront ? 0 : 1];
+		}
+	}
+}
@@ -5,7 +5,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 05, 2026
- *      Last Modified on:    July 05, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #pragma once
@@ -32,8 +32,11 @@ namespace FuturaLibrary
 		explicit Model(const std::string& sourcePath);
 
 		void AddSubmesh(const ModelSubmesh& submesh);
+		// Fingerprint of the source files this model was imported from; 0 when it was built in code.
+		void SetSourceFingerprint(uint64_t fingerprint) { m_SourceFingerprint = fingerprint; }
 
 		const std::string& GetSourcePath() const { return m_SourcePath; }
+		uint64_t GetSourceFingerprint() const { return m_SourceFingerprint; }
 		const std::vector<ModelSubmesh>& GetSubmeshes() const { return m_Submeshes; }
 		const AxisAlignedBounds& GetLocalBounds() const { return m_LocalBounds; }
 		bool IsEmpty() const { return m_Submeshes.empty(); }
@@ -42,5 +45,6 @@ namespace FuturaLibrary
 		std::string m_SourcePath;
 		std::vector<ModelSubmesh> m_Submeshes;
 		AxisAlignedBounds m_LocalBounds;
+		uint64_t m_SourceFingerprint = 0;
 	};
 }
@@ -0,0 +1,336 @@
+/**
+ *  @file r_PackedSpatialGrid.cpp
+ *
+ *  @brief Implements Morton keys, counting-sort packing, and cell lookup for PackedSpatialGrid.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#include "pch.h"
+#include "r_PackedSpatialGrid.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace FuturaLibrary
+{
+	namespace
+	{
+		constexpr int64_t CoordinateBias = -static_cast<int64_t>(PackedSpatialGrid::MinCellCoordinate);
+
+		uint64_t SpreadBits(uint64_t value)
+		{
+			value &= 0x1fffff;
+			value = (value | (value << 32)) & 0x1f00000000ffffull;
+			value = (value | (value << 16)) & 0x1f0000ff0000ffull;
+			value = (value | (value << 8)) & 0x100f00f00f00f00full;
+			value = (value | (value << 4)) & 0x10c30c30c30c30c3ull;
+			value = (value | (value << 2)) & 0x1249249249249249ull;
+			return value;
+		}
+
+		uint64_t CompactBits(uint64_t value)
+		{
+			value &= 0x1249249249249249ull;
+			value = (value | (value >> 2)) & 0x10c30c30c30c30c3ull;
+			value = (value | (value >> 4)) & 0x100f00f00f00f00full;
+			value = (value | (value >> 8)) & 0x1f0000ff0000ffull;
+			value = (value | (value >> 16)) & 0x1f00000000ffffull;
+			value = (value | (value >> 32)) & 0x1fffff;
+			return value;
+		}
+
+		bool IsValidOffsetTable(const std::vector<uint32_t>& offsets, size_t cellCount, size_t entryCount)
+		{
+			// Cleared grids have no offset table at all; merged empty grids keep the leading zero.
+			if (cellCount == 0)
+				return entryCount == 0 && (offsets.empty() || (offsets.size() == 1 && offsets[0] == 0));
+			if (offsets.size() != cellCount + 1 || offsets.front() != 0 || offsets.back() != entryCount)
+				return false;
+
+			return std::is_sorted(offsets.begin(), offsets.end());
+		}
+
+		bool AllIndicesBelow(const std::vector<uint32_t>& indices, uint32_t limit)
+		{
+			return std::all_of(indices.begin(), indices.end(), [limit](uint32_t index) { return index < limit; });
+		}
+
+		void AppendUniqueSurface(std::vector<uint32_t>& surfaces, size_t firstSurface, uint32_t surfaceIndex)
+		{
+			if (std::find(surfaces.begin() + firstSurface, surfaces.end(), surfaceIndex) == surfaces.end())
+				surfaces.push_back(surfaceIndex);
+		}
+	}
+
+	uint64_t PackedSpatialGrid::MakeCellKey(int32_t x, int32_t y, int32_t z)
+	{
+		const uint64_t biasedX = static_cast<uint64_t>(static_cast<int64_t>(x) + CoordinateBias);
+		const uint64_t biasedY = static_cast<uint64_t>(static_cast<int64_t>(y) + CoordinateBias);
+		const uint64_t biasedZ = static_cast<uint64_t>(static_cast<int64_t>(z) + CoordinateBias);
+		return SpreadBits(biasedX) | (SpreadBits(biasedY) << 1) | (SpreadBits(biasedZ) << 2);
+	}
+
+	void PackedSpatialGrid::DecodeCellKey(uint64_t cellKey, int32_t& x, int32_t& y, int32_t& z)
+	{
+		x = static_cast<int32_t>(static_cast<int64_t>(CompactBits(cellKey)) - CoordinateBias);
+		y = static_cast<int32_t>(static_cast<int64_t>(CompactBits(cellKey >> 1)) - CoordinateBias);
+		z = static_cast<int32_t>(static_cast<int64_t>(CompactBits(cellKey >> 2)) - CoordinateBias);
+	}
+
+	void PackedSpatialGrid::Build(const std::vector<SpatialGridEntry>& entries)
+	{
+		Clear();
+		if (entries.empty())
+			return;
+
+		// Give every distinct cell a dense id in first-seen order, then rank the ids by Morton key.
+		std::unordered_map<uint64_t, uint32_t> cellIds;
+		std::vector<uint32_t> entryCells(entries.size());
+		for (size_t entryIndex = 0; entryIndex < entries.size(); entryIndex++)
+		{
+			const auto [cell, inserted] = cellIds.try_emplace(entries[entryIndex].CellKey, static_cast<uint32_t>(m_CellKeys.size()));
+			if (inserted)
+				m_CellKeys.push_back(entries[entryIndex].CellKey);
+			entryCells[entryIndex] = cell->second;
+		}
+
+		const uint32_t cellCount = static_cast<uint32_t>(m_CellKeys.size());
+		std::vector<uint32_t> sortedCells(cellCount);
+		for (uint32_t cellId = 0; cellId < cellCount; cellId++)
+			sortedCells[cellId] = cellId;
+		std::sort(sortedCells.begin(), sortedCells.end(), [this](uint32_t a, uint32_t b) { return m_CellKeys[a] < m_CellKeys[b]; });
+
+		std::vector<uint32_t> cellRanks(cellCount);
+		std::vector<uint64_t> sortedKeys(cellCount);
+		for (uint32_t rank = 0; rank < cellCount; rank++)
+		{
+			cellRanks[sortedCells[rank]] = rank;
+			sortedKeys[rank] = m_CellKeys[sortedCells[rank]];
+		}
+		m_CellKeys = std::move(sortedKeys);
+
+		// Counting scatter: a stable pass over the entries keeps each cell in the callers' entry order.
+		m_TriangleOffsets.assign(cellCount + 1, 0);
+		for (uint32_t& cell : entryCells)
+		{
+			cell = cellRanks[cell];
+			m_TriangleOffsets[cell + 1]++;
+		}
+		for (uint32_t cell = 0; cell < cellCount; cell++)
+			m_TriangleOffsets[cell + 1] += m_TriangleOffsets[cell];
+
+		std::vector<uint32_t> cursors(m_TriangleOffsets.begin(), m_TriangleOffsets.end() - 1);
+		std::vector<uint32_t> entrySurfaces(entries.size());
+		m_Triangles.resize(entries.size());
+		for (size_t entryIndex = 0; entryIndex < entries.size(); entryIndex++)
+		{
+			const uint32_t slot = cursors[entryCells[entryIndex]]++;
+			m_Triangles[slot] = entries[entryIndex].TriangleIndex;
+			entrySurfaces[slot] = entries[entryIndex].SurfaceIndex;
+		}
+
+		m_SurfaceOffsets.reserve(cellCount + 1);
+		m_SurfaceOffsets.push_back(0);
+		for (uint32_t cell = 0; cell < cellCount; cell++)
+		{
+			const size_t firstSurface = m_Surfaces.size();
+			for (uint32_t slot = m_TriangleOffsets[cell]; slot < m_TriangleOffsets[cell + 1]; slot++)
+				AppendUniqueSurface(m_Surfaces, firstSurface, entrySurfaces[slot]);
+			m_SurfaceOffsets.push_back(static_cast<uint32_t>(m_Surfaces.size()));
+		}
+		m_Surfaces.shrink_to_fit();
+	}
+
+	void PackedSpatialGrid::Merge(const std::vector<const PackedSpatialGrid*>& additions)
+	{
+		struct AddedCell
+		{
+			uint64_t CellKey = 0;
+			uint32_t AdditionIndex = 0;
+			uint32_t CellIndex = 0;
+		};
+
+		size_t addedCellCount = 0;
+		size_t triangleCount = m_Triangles.size();
+		size_t surfaceCount = m_Surfaces.size();
+		for (const PackedSpatialGrid* addition : additions)
+		{
+			addedCellCount += addition->m_CellKeys.size();
+			triangleCount += addition->m_Triangles.size();
+			surfaceCount += addition->m_Surfaces.size();
+		}
+		if (addedCellCount == 0)
+			return;
+
+		// This grid's keys are already sorted, so only the added cells need sorting before one linear merge.
+		std::vector<AddedCell> addedCells;
+		addedCells.reserve(addedCellCount);
+		for (uint32_t additionIndex = 0; additionIndex < additions.size(); additionIndex++)
+		{
+			const PackedSpatialGrid& addition = *additions[additionIndex];
+			for (uint32_t cellIndex = 0; cellIndex < addition.m_CellKeys.size(); cellIndex++)
+				addedCells.push_back({ addition.m_CellKeys[cellIndex], additionIndex, cellIndex });
+		}
+
+		std::sort(addedCells.begin(), addedCells.end(), [](const AddedCell& a, const AddedCell& b)
+		{
+			return a.CellKey != b.CellKey ? a.CellKey < b.CellKey : a.AdditionIndex < b.AdditionIndex;
+		});
+
+		const size_t cellCount = m_CellKeys.size() + addedCellCount;
+		std::vector<uint64_t> cellKeys;
+		std::vector<uint32_t> triangleOffsets;
+		std::vector<uint32_t> surfaceOffsets;
+		std::vector<uint32_t> triangles;
+		std::vector<uint32_t> surfaces;
+		cellKeys.reserve(cellCount);
+		triangleOffsets.reserve(cellCount + 1);
+		surfaceOffsets.reserve(cellCount + 1);
+		triangles.reserve(triangleCount);
+		surfaces.reserve(surfaceCount);
+		triangleOffsets.push_back(0);
+		surfaceOffsets.push_back(0);
+
+		// Runs of existing cells no addition touches are copied as blocks, their offsets shifted by
+		// whatever the merge has written ahead of them.
+		size_t existingCell = 0;
+		const auto copyExistingCells = [&](size_t endCell)
+		{
+			if (endCell == existingCell)
+				return;
+
+			const uint32_t triangleShift = static_cast<uint32_t>(triangles.size()) - m_TriangleOffsets[existingCell];
+			const uint32_t surfaceShift = static_cast<uint32_t>(surfaces.size()) - m_SurfaceOffsets[existingCell];
+			cellKeys.insert(cellKeys.end(), m_CellKeys.begin() + existingCell, m_CellKeys.begin() + endCell);
+			triangles.insert(triangles.end(), m_Triangles.begin() + m_TriangleOffsets[existingCell], m_Triangles.begin() + m_TriangleOffsets[endCell]);
+			surfaces.insert(surfaces.end(), m_Surfaces.begin() + m_SurfaceOffsets[existingCell], m_Surfaces.begin() + m_SurfaceOffsets[endCell]);
+			for (size_t cell = existingCell + 1; cell <= endCell; cell++)
+			{
+				triangleOffsets.push_back(m_TriangleOffsets[cell] + triangleShift);
+				surfaceOffsets.push_back(m_SurfaceOffsets[cell] + surfaceShift);
+			}
+			existingCell = endCell;
+		};
+
+		size_t addedIndex = 0;
+		while (addedIndex < addedCells.size())
+		{
+			const uint64_t cellKey = addedCells[addedIndex].CellKey;
+			copyExistingCells(std::lower_bound(m_CellKeys.begin() + existingCell, m_CellKeys.end(), cellKey) - m_CellKeys.begin());
+
+			const size_t firstSurface = surfaces.size();
+			if (existingCell < m_CellKeys.size() && m_CellKeys[existingCell] == cellKey)
+			{
+				const std::span<const uint32_t> cellTriangles = GetCellTriangles(static_cast<uint32_t>(existingCell));
+				const std::span<const uint32_t> cellSurfaces = GetCellSurfaces(static_cast<uint32_t>(existingCell));
+				triangles.insert(triangles.end(), cellTriangles.begin(), cellTriangles.end());
+				surfaces.insert(surfaces.end(), cellSurfaces.begin(), cellSurfaces.end());
+				existingCell++;
+			}
+
+			for (; addedIndex < addedCells.size() && addedCells[addedIndex].CellKey == cellKey; addedIndex++)
+			{
+				const PackedSpatialGrid& addition = *additions[addedCells[addedIndex].AdditionIndex];
+				const std::span<const uint32_t> cellTriangles = addition.GetCellTriangles(addedCells[addedIndex].CellIndex);
+				triangles.insert(triangles.end(), cellTriangles.begin(), cellTriangles.end());
+				for (uint32_t surfaceIndex : addition.GetCellSurfaces(addedCells[addedIndex].CellIndex))
+					AppendUniqueSurface(surfaces, firstSurface, surfaceIndex);
+			}
+
+			cellKeys.push_back(cellKey);
+			triangleOffsets.push_back(static_cast<uint32_t>(triangles.size()));
+			surfaceOffsets.push_back(static_cast<uint32_t>(surfaces.size()));
+		}
+		copyExistingCells(m_CellKeys.size());
+
+		m_CellKeys = std::move(cellKeys);
+		m_TriangleOffsets = std::move(triangleOffsets);
+		m_SurfaceOffsets = std::move(surfaceOffsets);
+		m_Triangles = std::move(triangles);
+		m_Surfaces = std::move(surfaces);
+	}
+
+	void PackedSpatialGrid::Clear()
+	{
+		m_CellKeys.clear();
+		m_TriangleOffsets.clear();
+		m_SurfaceOffsets.clear();
+		m_Triangles.clear();
+		m_Surfaces.clear();
+	}
+
+	bool PackedSpatialGrid::Write(BinaryWriter& writer) const
+	{
+		return writer.WriteArray(m_CellKeys) &&
+			writer.WriteArray(m_TriangleOffsets) &&
+			writer.WriteArray(m_SurfaceOffsets) &&
+			writer.WriteArray(m_Triangles) &&
+			writer.WriteArray(m_Surfaces);
+	}
+
+	bool PackedSpatialGrid::Read(BinaryReader& reader, uint32_t triangleCount, uint32_t surfaceCount)
+	{
+		Clear();
+		const bool valid =
+			reader.ReadArray(m_CellKeys) &&
+			reader.ReadArray(m_TriangleOffsets) &&
+			reader.ReadArray(m_SurfaceOffsets) &&
+			reader.ReadArray(m_Triangles) &&
+			reader.ReadArray(m_Surfaces) &&
+			std::adjacent_find(m_CellKeys.begin(), m_CellKeys.end(), std::greater_equal<uint64_t>()) == m_CellKeys.end() &&
+			IsValidOffsetTable(m_TriangleOffsets, m_CellKeys.size(), m_Triangles.size()) &&
+			IsValidOffsetTable(m_SurfaceOffsets, m_CellKeys.size(), m_Surfaces.size()) &&
+			AllIndicesBelow(m_Triangles, triangleCount) &&
+			AllIndicesBelow(m_Surfaces, surfaceCount);
+
+		if (!valid)
+			Clear();
+		return valid;
+	}
+
+	uint32_t PackedSpatialGrid::FindCell(uint64_t cellKey) const
+	{
+		const auto cell = std::lower_bound(m_CellKeys.begin(), m_CellKeys.end(), cellKey);
+		if (cell == m_CellKeys.end() || *cell != cellKey)
+			return InvalidCell;
+
+		return static_cast<uint32_t>(cell - m_CellKeys.begin());
+	}
+
+	uint32_t PackedSpatialGrid::LowerBoundCell(uint64_t cellKey) const
+	{
+		return static_cast<uint32_t>(std::lower_bound(m_CellKeys.begin(), m_CellKeys.end(), cellKey) - m_CellKeys.begin());
+	}
+
+	std::span<const uint32_t> PackedSpatialGrid::GetCellTriangles(uint32_t cellIndex) const
+	{
+		const uint32_t first = m_TriangleOffsets[cellIndex];
+		return { m_Triangles.data() + first, m_TriangleOffsets[cellIndex + 1] - first };
+	}
+
+	std::span<const uint32_t> PackedSpatialGrid::GetCellSurfaces(uint32_t cellIndex) const
+	{
+		const uint32_t first = m_SurfaceOffsets[cellIndex];
+		return { m_Surfaces.data() + first, m_SurfaceOffsets[cellIndex + 1] - first };
+	}
+
+	size_t PackedSpatialGrid::GetMemoryBytes() const
+	{
+		return m_CellKeys.capacity() * sizeof(uint64_t) +
+			(m_TriangleOffsets.capacity() + m_SurfaceOffsets.capacity() + m_Triangles.capacity() + m_Surfaces.capacity()) * sizeof(uint32_t);
+	}
+
+	size_t PackedSpatialGrid::EstimateHashMapBytes() const
+	{
+		// Each node holds a next pointer, the cached hash, the key and two vectors, and needs one bucket slot.
+		// Every node and every non-empty vector is its own heap block with allocator bookkeeping.
+		constexpr size_t AllocationOverhead = 16;
+		constexpr size_t NodeBytes = sizeof(void*) + sizeof(size_t) + sizeof(int64_t) + 2 * sizeof(std::vector<uint32_t>);
+		const size_t cellCount = m_CellKeys.size();
+		return cellCount * (NodeBytes + sizeof(void*) + 3 * AllocationOverhead) +
+			(m_Triangles.size() + m_Surfaces.size()) * sizeof(uint32_t);
+	}
+}
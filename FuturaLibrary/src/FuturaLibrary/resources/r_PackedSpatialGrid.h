@@ -0,0 +1,77 @@
+/**
+ *  @file r_PackedSpatialGrid.h
+ *
+ *  @brief Declares a frozen, CSR-packed uniform grid keyed by Morton-ordered cell coordinates.
+ *
+ *  Occupied cells are stored as one sorted key array plus offset tables into two
+ *  flat index arrays, so a lookup is a binary search with no per-cell allocations.
+ *  The grid stores indices only; StaticWorld owns the triangles and surfaces.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include "FuturaLibrary/core/c_core.h"
+#include "FuturaLibrary/utils/u_BinaryStream.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace FuturaLibrary
+{
+	struct SpatialGridEntry
+	{
+		uint64_t CellKey = 0;
+		uint32_t TriangleIndex = 0;
+		uint32_t SurfaceIndex = 0;
+	};
+
+	class FT_API PackedSpatialGrid
+	{
+	public:
+		static constexpr uint32_t InvalidCell = 0xffffffffu;
+		// Cell coordinates a key can hold; anything outside wraps onto another cell's key.
+		static constexpr int32_t MinCellCoordinate = -(1 << 20);
+		static constexpr int32_t MaxCellCoordinate = (1 << 20) - 1;
+
+		// Interleaves the low 21 bits of each biased coordinate, so nearby cells get nearby keys.
+		static uint64_t MakeCellKey(int32_t x, int32_t y, int32_t z);
+		static void DecodeCellKey(uint64_t cellKey, int32_t& x, int32_t& y, int32_t& z);
+
+		// Cells list their triangles in entry order, so pass entries in ascending triangle order.
+		void Build(const std::vector<SpatialGridEntry>& entries);
+		// Merges other grids into this one. Cells sharing a key keep this grid's indices first,
+		// then each addition's in order, which keeps incremental builds deterministic. Only the added
+		// cells are sorted; they are then merged with this grid's cells in one linear pass.
+		void Merge(const std::vector<const PackedSpatialGrid*>& additions);
+		void Clear();
+		bool Write(BinaryWriter& writer) const;
+		// Restores a grid saved by Write, checking key order, offset tables and index ranges.
+		bool Read(BinaryReader& reader, uint32_t triangleCount, uint32_t surfaceCount);
+
+		bool IsEmpty() const { return m_CellKeys.empty(); }
+		uint32_t GetCellCount() const { return static_cast<uint32_t>(m_CellKeys.size()); }
+		uint32_t FindCell(uint64_t cellKey) const;
+		// First cell whose key is not below cellKey, or GetCellCount(). Keys sharing their high bits form
+		// an octree node, so two of these bound every occupied cell inside that node.
+		uint32_t LowerBoundCell(uint64_t cellKey) const;
+		uint64_t GetCellKey(uint32_t cellIndex) const { return m_CellKeys[cellIndex]; }
+		std::span<const uint32_t> GetCellTriangles(uint32_t cellIndex) const;
+		std::span<const uint32_t> GetCellSurfaces(uint32_t cellIndex) const;
+
+		size_t GetMemoryBytes() const;
+		// Approximate footprint of the same cells stored as unordered_map<int64_t, cell> with two vectors per cell.
+		size_t EstimateHashMapBytes() const;
+
+	private:
+		std::vector<uint64_t> m_CellKeys;
+		std::vector<uint32_t> m_TriangleOffsets;
+		std::vector<uint32_t> m_SurfaceOffsets;
+		std::vector<uint32_t> m_Triangles;
+		std::vector<uint32_t> m_Surfaces;
+	};
+}
@@ -8,7 +8,7 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 01, 2026
- *      Last Modified on:    July 07, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #include "pch.h"
@@ -86,7 +86,7 @@ namespace FuturaLibrary
 
 #ifdef FT_ENABLE_ASSIMP
 		constexpr uint32_t ModelCacheMagic = 0x4C444D46; // FMDL
-		constexpr uint32_t ModelCacheFormatVersion = 1;
+		constexpr uint32_t ModelCacheFormatVersion = 2;
 		constexpr uint32_t EngineMeshFormatVersion = 2;
 		constexpr uint64_t MaxCachedStringLength = 1024 * 1024;
 		constexpr uint64_t MaxCachedElementCount = 100000000;
@@ -98,6 +98,7 @@ namespace FuturaLibrary
 			glm::vec4 AlbedoColor = glm::vec4(1.0f);
 			std::string AlbedoTexturePath;
 			std::string LightmapTexturePath;
+			bool Opaque = true;
 		};
 
 		struct CachedSubmeshData
@@ -492,7 +493,8 @@ namespace FuturaLibrary
 				if (!WriteString(output, material.Name) ||
 					!WriteVec4(output, material.AlbedoColor) ||
 					!WriteString(output, material.AlbedoTexturePath) ||
-					!WriteString(output, material.LightmapTexturePath))
+					!WriteString(output, material.LightmapTexturePath) ||
+					!WriteValue(output, static_cast<uint8_t>(material.Opaque ? 1 : 0)))
 					return false;
 			}
 
@@ -563,11 +565,14 @@ namespace FuturaLibrary
 
 			for (CachedMaterialData& material : modelData.Materials)
 			{
+				uint8_t opaque = 1;
 				if (!ReadString(input, material.Name) ||
 					!ReadVec4(input, material.AlbedoColor) ||
 					!ReadString(input, material.AlbedoTexturePath) ||
-					!ReadString(input, material.LightmapTexturePath))
+					!ReadString(input, material.LightmapTexturePath) ||
+					!ReadValue(input, opaque))
 					return false;
+				material.Opaque = opaque != 0;
 			}
 
 			for (CachedSubmeshData& submesh : modelData.Submeshes)
@@ -702,6 +707,7 @@ namespace FuturaLibrary
 		{
 			Ref<Material> material = CreateRef<Material>(shader);
 			material->SetFloat4("u_AlbedoColor", materialData.AlbedoColor);
+			material->SetOpaque(materialData.Opaque);
 
 			Ref<Texture2D> albedoTexture = LoadModelTexture(
 				modelDirectory,
@@ -739,6 +745,15 @@ namespace FuturaLibrary
 			if (aiGetMaterialColor(&assimpMaterial, AI_MATKEY_COLOR_DIFFUSE, &diffuseColor) == AI_SUCCESS)
 				materialData.AlbedoColor = { diffuseColor.r, diffuseColor.g, diffuseColor.b, diffuseColor.a };
 
+			// OBJ dissolve, an opacity map, or a translucent diffuse colour all let the scene behind show through.
+			float opacity = 1.0f;
+			if (aiGetMaterialFloat(&assimpMaterial, AI_MATKEY_OPACITY, &opacity) != AI_SUCCESS)
+				opacity = 1.0f;
+			materialData.Opaque =
+				opacity >= 1.0f &&
+				materialData.AlbedoColor.a >= 1.0f &&
+				assimpMaterial.GetTextureCount(aiTextureType_OPACITY) == 0;
+
 			return materialData;
 		}
 
@@ -790,6 +805,7 @@ namespace FuturaLibrary
 		)
 		{
 			Ref<Model> model = CreateRef<Model>(modelData.SourcePath);
+			model->SetSourceFingerprint(modelData.SourceFingerprint);
 			std::filesystem::path modelDirectory = std::filesystem::path(modelData.SourcePath).parent_path();
 
 			for (const CachedSubmeshData& cachedSubmesh : modelData.Submeshes)
@@ -1,17 +1,82 @@
 #include "pch.h"
 #include "r_StaticWorld.h"
 
+#include "FuturaLibrary/utils/u_BinaryStream.h"
+#include "FuturaLibrary/utils/u_MappedFile.h"
+#include "FuturaLibrary/utils/u_ParallelFor.h"
+#include "FuturaLibrary/utils/u_Simd.h"
+
 #include <glm/gtx/norm.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cfloat>
 #include <cmath>
+#include <iterator>
 #include <limits>
+#include <unordered_map>
 
 namespace FuturaLibrary
 {
+	// One SIMD register of rays in structure-of-arrays form. Unused lanes keep a negative
+	// MaxDistance, so every triangle test rejects them without extra masking.
+	struct WorldRayPacket
+	{
+		float OriginX[SimdWidth];
+		float OriginY[SimdWidth];
+		float OriginZ[SimdWidth];
+		float DirectionX[SimdWidth];
+		float DirectionY[SimdWidth];
+		float DirectionZ[SimdWidth];
+		float InverseDirectionX[SimdWidth];
+		float InverseDirectionY[SimdWidth];
+		float InverseDirectionZ[SimdWidth];
+		float MaxDistance[SimdWidth];
+		uint32_t HitTriangle[SimdWidth];
+		uint32_t RayIndex[SimdWidth];
+		uint32_t RayCount = 0;
+	};
+
 	namespace
 	{
 		constexpr float RayEpsilon = 0.000001f;
+		constexpr uint32_t NoTriangle = 0xffffffffu;
+		constexpr uint32_t NoVertex = 0xffffffffu;
+		constexpr uint32_t MaxSharedPacketCells = 64;
+		constexpr uint32_t MaxPacketTraversalDepth = 64;
+		constexpr size_t ExtractionJobIndices = 3 * 16384;
+		constexpr size_t MinGridTrianglesPerChunk = 4096;
+		constexpr size_t MaxCellSizeSamples = 65536;
+		constexpr float MaxGridCellsPerAxis = 262144.0f;
+		constexpr float MinGridCellSize = 0.0001f;
+		constexpr float SweepSkinFraction = 0.01f;
+		constexpr uint32_t MaxSweepAdvanceSteps = 32;
+		constexpr float GrazingApproachFraction = 0.0001f;
+		constexpr uint32_t MaxMovementBatchMovers = 64;
+		constexpr size_t MinMovementBatchesPerChunk = 4;
+		constexpr uint32_t MaxMovementBatchLevels = 32;
+		constexpr uint32_t WorldCacheMagic = 0x444C5746; // FWLD
+		constexpr uint32_t WorldCacheFormatVersion = 9;
+		constexpr uint32_t BspCacheMagic = 0x50534246; // FBSP
+		constexpr uint32_t BspCacheFormatVersion = 1;
+		constexpr uint32_t CollisionBlockTriangles = 256;
+		constexpr uint32_t CompactVertexWords = 2;
+		constexpr uint32_t CompactTriangleWords = 4;
+		constexpr uint32_t CollisionBlockWords = 7;
+		constexpr float MaxQuantizedCoordinate = 65535.0f;
+		constexpr float MortonSortCellsPerAxis = 1023.0f;
+		constexpr float CoplanarNormalCosine = 0.9995f;
+		// Passes apply only collapses whose neighbourhoods do not overlap, so a pass does less than a serial sweep.
+		constexpr uint32_t MaxSimplificationPasses = 64;
+		constexpr size_t MinSimplificationVerticesPerChunk = 4096;
+		// Morton keys hold 21 bits per axis, and each octree level pushes at most eight child ranges.
+		constexpr uint32_t MaxCullCellRanges = 8 * 22;
+		constexpr uint32_t MaxCullTraversalDepth = 64;
+
+		static_assert(sizeof(CompactWorldVertex) == CompactVertexWords * sizeof(uint32_t), "CompactWorldVertex must stay two packed words.");
+		static_assert(sizeof(CompactWorldTriangle) == CompactTriangleWords * sizeof(uint32_t), "CompactWorldTriangle must stay four packed words.");
+		static_assert(sizeof(CollisionTriangleBlock) == CollisionBlockWords * sizeof(uint32_t), "CollisionTriangleBlock must stay seven packed words.");
 
 		struct GridCoord
 		{
@@ -39,37 +104,6 @@ namespace FuturaLibrary
 			target.Max.z = std::max(target.Max.z, source.Max.z);
 		}
 
-		AxisAlignedBounds TransformBounds(const AxisAlignedBounds& bounds, const glm::mat4& transform)
-		{
-			AxisAlignedBounds transformedBounds;
-			if (!bounds.IsValid)
-				return transformedBounds;
-
-			const glm::vec3 corners[] =
-			{
-				{ bounds.Min.x, bounds.Min.y, bounds.Min.z },
-				{ bounds.Max.x, bounds.Min.y, bounds.Min.z },
-				{ bounds.Min.x, bounds.Max.y, bounds.Min.z },
-				{ bounds.Max.x, bounds.Max.y, bounds.Min.z },
-				{ bounds.Min.x, bounds.Min.y, bounds.Max.z },
-				{ bounds.Max.x, bounds.Min.y, bounds.Max.z },
-				{ bounds.Min.x, bounds.Max.y, bounds.Max.z },
-				{ bounds.Max.x, bounds.Max.y, bounds.Max.z }
-			};
-
-			for (const glm::vec3& corner : corners)
-			{
-				const glm::vec4 transformedCorner = transform * glm::vec4(corner, 1.0f);
-				AxisAlignedBounds cornerBounds;
-				cornerBounds.Min = glm::vec3(transformedCorner);
-				cornerBounds.Max = cornerBounds.Min;
-				cornerBounds.IsValid = true;
-				Encapsulate(transformedBounds, cornerBounds);
-			}
-
-			return transformedBounds;
-		}
-
 		AxisAlignedBounds CalculateTriangleBounds(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
 		{
 			AxisAlignedBounds bounds;
@@ -79,14 +113,68 @@ namespace FuturaLibrary
 			return bounds;
 		}
 
-		bool BoundsOverlap(const AxisAlignedBounds& a, const AxisAlignedBounds& b)
+		AxisAlignedBounds ToAxisAlignedBounds(const WorldTriangleBounds& bounds)
 		{
-			if (!a.IsValid || !b.IsValid)
-				return false;
+			AxisAlignedBounds axisAlignedBounds;
+			axisAlignedBounds.Min = glm::vec3(bounds.MinX, bounds.MinY, bounds.MinZ);
+			axisAlignedBounds.Max = glm::vec3(bounds.MaxX, bounds.MaxY, bounds.MaxZ);
+			axisAlignedBounds.IsValid = true;
+			return axisAlignedBounds;
+		}
+
+		// Smallest power of two that spans [minimum, maximum] in 65535 steps and stays at or above the float
+		// spacing at that distance from the origin, so every lattice point is exactly representable.
+		float ChooseQuantizationStep(float minimum, float maximum)
+		{
+			const double extent = static_cast<double>(maximum) - static_cast<double>(minimum);
+			const double reach = std::max(std::abs(static_cast<double>(minimum)), std::abs(static_cast<double>(maximum)));
+			const double required = std::max({ extent / (MaxQuantizedCoordinate - 1.0), std::ldexp(reach, -23), static_cast<double>(FLT_MIN) });
+
+			int exponent = 0;
+			std::frexp(required, &exponent);
+			return std::ldexp(1.0f, exponent);
+		}
+
+		uint16_t QuantizeCoordinate(float value, float origin, float step)
+		{
+			const double steps = std::round((static_cast<double>(value) - static_cast<double>(origin)) / static_cast<double>(step));
+			return static_cast<uint16_t>(std::clamp(steps, 0.0, static_cast<double>(MaxQuantizedCoordinate)));
+		}
+
+		// q * step and the sum are both exact, so scalar, SIMD, and fused multiply-add decodes all agree.
+		float DecodeCoordinate(uint16_t value, float origin, float step)
+		{
+			return origin + static_cast<float>(value) * step;
+		}
+
+		CompactWorldVertex QuantizeVertex(const glm::vec3& position, const CollisionTriangleBlock& block)
+		{
+			CompactWorldVertex vertex;
+			vertex.X = QuantizeCoordinate(position.x, block.OriginX, block.StepX);
+			vertex.Y = QuantizeCoordinate(position.y, block.OriginY, block.StepY);
+			vertex.Z = QuantizeCoordinate(position.z, block.OriginZ, block.StepZ);
+			return vertex;
+		}
 
-			return a.Min.x <= b.Max.x && a.Max.x >= b.Min.x &&
-				a.Min.y <= b.Max.y && a.Max.y >= b.Min.y &&
-				a.Min.z <= b.Max.z && a.Max.z >= b.Min.z;
+		glm::vec3 DecodeVertex(const CompactWorldVertex& vertex, const CollisionTriangleBlock& block)
+		{
+			return glm::vec3(
+				DecodeCoordinate(vertex.X, block.OriginX, block.StepX),
+				DecodeCoordinate(vertex.Y, block.OriginY, block.StepY),
+				DecodeCoordinate(vertex.Z, block.OriginZ, block.StepZ));
+		}
+
+		void DecodeCompactTriangle(
+			const CompactWorldTriangle& triangle,
+			const CollisionTriangleBlock& block,
+			const std::vector<CompactWorldVertex>& vertices,
+			glm::vec3& a,
+			glm::vec3& b,
+			glm::vec3& c)
+		{
+			a = DecodeVertex(vertices[triangle.Indices[0]], block);
+			b = DecodeVertex(vertices[triangle.Indices[1]], block);
+			c = DecodeVertex(vertices[triangle.Indices[2]], block);
 		}
 
 		AxisAlignedBounds MakeAABB(const glm::vec3& center, const glm::vec3& halfExtents)
@@ -98,6 +186,219 @@ namespace FuturaLibrary
 			return bounds;
 		}
 
+		// Slab sweep of a box centred at `center` along `delta` against one bounds record, done as a
+		// ray from the centre against the record grown by the half extents. Reports the entry time
+		// as a fraction of delta and the axis that was crossed last, which carries the contact normal.
+		bool SweepAABBIntersectsBounds(
+			const glm::vec3& center,
+			const glm::vec3& halfExtents,
+			const glm::vec3& delta,
+			const WorldTriangleBounds& bounds,
+			float maxTime,
+			float skin,
+			float& entryTime,
+			int& entryAxis)
+		{
+			const float boundsMin[3] = { bounds.MinX - halfExtents.x, bounds.MinY - halfExtents.y, bounds.MinZ - halfExtents.z };
+			const float boundsMax[3] = { bounds.MaxX + halfExtents.x, bounds.MaxY + halfExtents.y, bounds.MaxZ + halfExtents.z };
+
+			float nearTime = -std::numeric_limits<float>::max();
+			float farTime = std::numeric_limits<float>::max();
+			int nearAxis = -1;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (std::abs(delta[axis]) < RayEpsilon)
+				{
+					if (center[axis] < boundsMin[axis] || center[axis] > boundsMax[axis])
+						return false;
+					continue;
+				}
+
+				float t0 = (boundsMin[axis] - center[axis]) / delta[axis];
+				float t1 = (boundsMax[axis] - center[axis]) / delta[axis];
+				if (t0 > t1)
+					std::swap(t0, t1);
+
+				if (t0 > nearTime)
+				{
+					nearTime = t0;
+					nearAxis = axis;
+				}
+				farTime = std::min(farTime, t1);
+			}
+
+			if (nearAxis < 0 || nearTime > farTime || farTime < 0.0f || nearTime > maxTime)
+				return false;
+
+			// Starting inside the bounds: touching the entry face within the skin still blocks, deeper overlaps are let go.
+			if (nearTime < 0.0f)
+			{
+				if (-nearTime * std::abs(delta[nearAxis]) > skin)
+					return false;
+				nearTime = 0.0f;
+			}
+
+			entryTime = nearTime;
+			entryAxis = nearAxis;
+			return true;
+		}
+
+		// Closest point on triangle abc to p, by Voronoi region (Ericson, Real-Time Collision Detection 5.1.5).
+		glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+		{
+			const glm::vec3 ab = b - a;
+			const glm::vec3 ac = c - a;
+			const glm::vec3 ap = p - a;
+			const float d1 = glm::dot(ab, ap);
+			const float d2 = glm::dot(ac, ap);
+			if (d1 <= 0.0f && d2 <= 0.0f)
+				return a;
+
+			const glm::vec3 bp = p - b;
+			const float d3 = glm::dot(ab, bp);
+			const float d4 = glm::dot(ac, bp);
+			if (d3 >= 0.0f && d4 <= d3)
+				return b;
+
+			const float vc = d1 * d4 - d3 * d2;
+			if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+				return a + ab * (d1 / (d1 - d3));
+
+			const glm::vec3 cp = p - c;
+			const float d5 = glm::dot(ab, cp);
+			const float d6 = glm::dot(ac, cp);
+			if (d6 >= 0.0f && d5 <= d6)
+				return c;
+
+			const float vb = d5 * d2 - d1 * d6;
+			if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+				return a + ac * (d2 / (d2 - d6));
+
+			const float va = d3 * d6 - d5 * d4;
+			if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+				return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+			const float denominator = 1.0f / (va + vb + vc);
+			return a + ab * (vb * denominator) + ac * (vc * denominator);
+		}
+
+		// Closest points between segments p1q1 and p2q2 (Ericson 5.1.9). Returns the squared distance.
+		float ClosestPointsSegmentSegment(
+			const glm::vec3& p1,
+			const glm::vec3& q1,
+			const glm::vec3& p2,
+			const glm::vec3& q2,
+			glm::vec3& closest1,
+			glm::vec3& closest2)
+		{
+			const glm::vec3 d1 = q1 - p1;
+			const glm::vec3 d2 = q2 - p2;
+			const glm::vec3 r = p1 - p2;
+			const float a = glm::dot(d1, d1);
+			const float e = glm::dot(d2, d2);
+			const float f = glm::dot(d2, r);
+
+			float s = 0.0f;
+			float t = 0.0f;
+			if (a <= RayEpsilon && e <= RayEpsilon)
+			{
+				closest1 = p1;
+				closest2 = p2;
+				return glm::dot(r, r);
+			}
+
+			if (a <= RayEpsilon)
+			{
+				t = std::clamp(f / e, 0.0f, 1.0f);
+			}
+			else
+			{
+				const float c = glm::dot(d1, r);
+				if (e <= RayEpsilon)
+				{
+					s = std::clamp(-c / a, 0.0f, 1.0f);
+				}
+				else
+				{
+					const float b = glm::dot(d1, d2);
+					const float denominator = a * e - b * b;
+					s = denominator != 0.0f ? std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+					t = (b * s + f) / e;
+					if (t < 0.0f)
+					{
+						t = 0.0f;
+						s = std::clamp(-c / a, 0.0f, 1.0f);
+					}
+					else if (t > 1.0f)
+					{
+						t = 1.0f;
+						s = std::clamp((b - c) / a, 0.0f, 1.0f);
+					}
+				}
+			}
+
+			closest1 = p1 + d1 * s;
+			closest2 = p2 + d2 * t;
+			return glm::length2(closest1 - closest2);
+		}
+
+		// Closest points between segment pq and a triangle: zero when the segment pierces the triangle,
+		// otherwise the best of the two endpoints against the face and the segment against each edge.
+		float ClosestPointsSegmentTriangle(
+			const glm::vec3& p,
+			const glm::vec3& q,
+			const WorldTriangle& triangle,
+			glm::vec3& segmentPoint,
+			glm::vec3& trianglePoint)
+		{
+			const float distanceP = glm::dot(triangle.Normal, p - triangle.A);
+			const float distanceQ = glm::dot(triangle.Normal, q - triangle.A);
+			if ((distanceP < 0.0f) != (distanceQ < 0.0f))
+			{
+				// Edge-side tests rather than a closest-point comparison, which fails on large coordinates.
+				const glm::vec3 crossing = p + (q - p) * (distanceP / (distanceP - distanceQ));
+				if (glm::dot(glm::cross(triangle.B - triangle.A, crossing - triangle.A), triangle.Normal) >= 0.0f &&
+					glm::dot(glm::cross(triangle.C - triangle.B, crossing - triangle.B), triangle.Normal) >= 0.0f &&
+					glm::dot(glm::cross(triangle.A - triangle.C, crossing - triangle.C), triangle.Normal) >= 0.0f)
+				{
+					segmentPoint = crossing;
+					trianglePoint = crossing;
+					return 0.0f;
+				}
+			}
+
+			segmentPoint = p;
+			trianglePoint = ClosestPointOnTriangle(p, triangle.A, triangle.B, triangle.C);
+			float bestDistance = glm::length2(segmentPoint - trianglePoint);
+
+			auto consider = [&](const glm::vec3& candidateSegment, const glm::vec3& candidateTriangle, float distance)
+			{
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					segmentPoint = candidateSegment;
+					trianglePoint = candidateTriangle;
+				}
+			};
+
+			if (q != p)
+			{
+				const glm::vec3 closestQ = ClosestPointOnTriangle(q, triangle.A, triangle.B, triangle.C);
+				consider(q, closestQ, glm::length2(q - closestQ));
+
+				const glm::vec3* corners[] = { &triangle.A, &triangle.B, &triangle.C };
+				for (int edge = 0; edge < 3; edge++)
+				{
+					glm::vec3 closestSegment;
+					glm::vec3 closestEdge;
+					const float distance = ClosestPointsSegmentSegment(p, q, *corners[edge], *corners[(edge + 1) % 3], closestSegment, closestEdge);
+					consider(closestSegment, closestEdge, distance);
+				}
+			}
+
+			return bestDistance;
+		}
+
 		bool RayIntersectsTriangle(
 			const glm::vec3& origin,
 			const glm::vec3& direction,
@@ -127,22 +428,165 @@ namespace FuturaLibrary
 			return distance >= 0.0f && distance <= maxDistance;
 		}
 
-		bool AABBOverlapsAnyTriangleBounds(
+		void IntersectRayPacketTriangle(WorldRayPacket& packet, const WorldTriangle& triangle, uint32_t triangleIndex)
+		{
+			const glm::vec3 edge1 = triangle.B - triangle.A;
+			const glm::vec3 edge2 = triangle.C - triangle.A;
+			const SimdFloat edge1X = SimdSet(edge1.x);
+			const SimdFloat edge1Y = SimdSet(edge1.y);
+			const SimdFloat edge1Z = SimdSet(edge1.z);
+			const SimdFloat edge2X = SimdSet(edge2.x);
+			const SimdFloat edge2Y = SimdSet(edge2.y);
+			const SimdFloat edge2Z = SimdSet(edge2.z);
+			const SimdFloat zero = SimdSet(0.0f);
+			const SimdFloat one = SimdSet(1.0f);
+
+			// Same operation order as RayIntersectsTriangle so both paths agree bit for bit.
+			const SimdFloat directionX = SimdLoad(packet.DirectionX);
+			const SimdFloat directionY = SimdLoad(packet.DirectionY);
+			const SimdFloat directionZ = SimdLoad(packet.DirectionZ);
+			const SimdFloat pX = directionY * edge2Z - directionZ * edge2Y;
+			const SimdFloat pY = directionZ * edge2X - directionX * edge2Z;
+			const SimdFloat pZ = directionX * edge2Y - directionY * edge2X;
+			const SimdFloat determinant = edge1X * pX + edge1Y * pY + edge1Z * pZ;
+			SimdFloat valid = SimdGreaterEqual(SimdAbs(determinant), SimdSet(RayEpsilon));
+
+			const SimdFloat inverseDeterminant = one / determinant;
+			const SimdFloat tX = SimdLoad(packet.OriginX) - SimdSet(triangle.A.x);
+			const SimdFloat tY = SimdLoad(packet.OriginY) - SimdSet(triangle.A.y);
+			const SimdFloat tZ = SimdLoad(packet.OriginZ) - SimdSet(triangle.A.z);
+			const SimdFloat u = (tX * pX + tY * pY + tZ * pZ) * inverseDeterminant;
+			valid = SimdAnd(valid, SimdAnd(SimdGreaterEqual(u, zero), SimdLessEqual(u, one)));
+
+			const SimdFloat qX = tY * edge1Z - tZ * edge1Y;
+			const SimdFloat qY = tZ * edge1X - tX * edge1Z;
+			const SimdFloat qZ = tX * edge1Y - tY * edge1X;
+			const SimdFloat v = (directionX * qX + directionY * qY + directionZ * qZ) * inverseDeterminant;
+			valid = SimdAnd(valid, SimdAnd(SimdGreaterEqual(v, zero), SimdLessEqual(u + v, one)));
+
+			const SimdFloat distance = (edge2X * qX + edge2Y * qY + edge2Z * qZ) * inverseDeterminant;
+			const SimdFloat maxDistance = SimdLoad(packet.MaxDistance);
+			valid = SimdAnd(valid, SimdAnd(SimdGreaterEqual(distance, zero), SimdLessEqual(distance, maxDistance)));
+			if (SimdMoveMask(valid) == 0)
+				return;
+
+			SimdStore(packet.MaxDistance, SimdSelect(valid, distance, maxDistance));
+			const SimdFloat hitTriangle = SimdLoad(reinterpret_cast<const float*>(packet.HitTriangle));
+			SimdStore(reinterpret_cast<float*>(packet.HitTriangle), SimdSelect(valid, SimdSetBits(triangleIndex), hitTriangle));
+		}
+
+		bool RayPacketIntersectsNode(const WorldRayPacket& packet, const BVHNode& node)
+		{
+			const SimdFloat t0X = (SimdSet(node.Min.x) - SimdLoad(packet.OriginX)) * SimdLoad(packet.InverseDirectionX);
+			const SimdFloat t1X = (SimdSet(node.Max.x) - SimdLoad(packet.OriginX)) * SimdLoad(packet.InverseDirectionX);
+			const SimdFloat t0Y = (SimdSet(node.Min.y) - SimdLoad(packet.OriginY)) * SimdLoad(packet.InverseDirectionY);
+			const SimdFloat t1Y = (SimdSet(node.Max.y) - SimdLoad(packet.OriginY)) * SimdLoad(packet.InverseDirectionY);
+			const SimdFloat t0Z = (SimdSet(node.Min.z) - SimdLoad(packet.OriginZ)) * SimdLoad(packet.InverseDirectionZ);
+			const SimdFloat t1Z = (SimdSet(node.Max.z) - SimdLoad(packet.OriginZ)) * SimdLoad(packet.InverseDirectionZ);
+
+			const SimdFloat entry = SimdMax(SimdMax(SimdMin(t0X, t1X), SimdMin(t0Y, t1Y)), SimdMax(SimdMin(t0Z, t1Z), SimdSet(0.0f)));
+			const SimdFloat exit = SimdMin(SimdMin(SimdMax(t0X, t1X), SimdMax(t0Y, t1Y)), SimdMin(SimdMax(t0Z, t1Z), SimdLoad(packet.MaxDistance)));
+			return SimdMoveMask(SimdLessEqual(entry, exit)) != 0;
+		}
+
+		// Tests SimdWidth candidates per iteration. Each lane gathers its triangle's indices, the three
+		// vertices and its block's frame, decodes the nine coordinates, and takes their bounds, which match
+		// the scalar decode bit for bit. NarrowPhaseTests counts up to the first overlapping candidate, exactly as a
+		// one-at-a-time loop would, and NarrowPhaseBatches counts SIMD iterations.
+		bool AABBOverlapsAnyTriangle(
 			const AxisAlignedBounds& bounds,
-			const std::vector<WorldTriangle>& triangles,
+			const std::vector<CompactWorldVertex>& vertices,
+			const std::vector<CompactWorldTriangle>& triangles,
+			const std::vector<CollisionTriangleBlock>& blocks,
 			const std::vector<uint32_t>& candidates,
 			CollisionQueryStats* stats)
 		{
-			for (uint32_t triangleIndex : candidates)
+			if (!bounds.IsValid)
 			{
-				if (triangleIndex >= triangles.size())
-					continue;
+				if (stats)
+					stats->NarrowPhaseTests += static_cast<uint32_t>(candidates.size());
+				return false;
+			}
+
+			// Vertex words are read little-endian: X is the low half of the first word, Y the high half, Z the low half of the second.
+			const uint32_t* vertexBase = vertices.empty() ? nullptr : reinterpret_cast<const uint32_t*>(vertices.data());
+			const uint32_t* triangleBase = triangles.empty() ? nullptr : reinterpret_cast<const uint32_t*>(triangles.data());
+			const float* blockBase = blocks.empty() ? nullptr : &blocks[0].OriginX;
+			const SimdFloat boundsMinX = SimdSet(bounds.Min.x);
+			const SimdFloat boundsMinY = SimdSet(bounds.Min.y);
+			const SimdFloat boundsMinZ = SimdSet(bounds.Min.z);
+			const SimdFloat boundsMaxX = SimdSet(bounds.Max.x);
+			const SimdFloat boundsMaxY = SimdSet(bounds.Max.y);
+			const SimdFloat boundsMaxZ = SimdSet(bounds.Max.z);
+
+			size_t candidateIndex = 0;
+			for (; candidateIndex + SimdWidth <= candidates.size(); candidateIndex += SimdWidth)
+			{
+				const SimdGatherIndices indices = SimdLoadGatherIndices(candidates.data() + candidateIndex, CompactTriangleWords);
+				const SimdGatherIndices vertexA = SimdWordsToGatherIndices(SimdGatherWords(triangleBase + 0, indices), CompactVertexWords);
+				const SimdGatherIndices vertexB = SimdWordsToGatherIndices(SimdGatherWords(triangleBase + 1, indices), CompactVertexWords);
+				const SimdGatherIndices vertexC = SimdWordsToGatherIndices(SimdGatherWords(triangleBase + 2, indices), CompactVertexWords);
+				const SimdGatherIndices blockIndices = SimdWordsToGatherIndices(SimdGatherWords(triangleBase + 3, indices), CollisionBlockWords);
+				const SimdWords axayWords = SimdGatherWords(vertexBase + 0, vertexA);
+				const SimdWords bxbyWords = SimdGatherWords(vertexBase + 0, vertexB);
+				const SimdWords cxcyWords = SimdGatherWords(vertexBase + 0, vertexC);
+
+				const SimdFloat originX = SimdGather(blockBase + 0, blockIndices);
+				const SimdFloat stepX = SimdGather(blockBase + 3, blockIndices);
+				const SimdFloat ax = originX + SimdLowHalfToFloat(axayWords) * stepX;
+				const SimdFloat bx = originX + SimdLowHalfToFloat(bxbyWords) * stepX;
+				const SimdFloat cx = originX + SimdLowHalfToFloat(cxcyWords) * stepX;
+				SimdFloat overlap = SimdAnd(
+					SimdLessEqual(boundsMinX, SimdMax(ax, SimdMax(bx, cx))),
+					SimdGreaterEqual(boundsMaxX, SimdMin(ax, SimdMin(bx, cx))));
+
+				const SimdFloat originY = SimdGather(blockBase + 1, blockIndices);
+				const SimdFloat stepY = SimdGather(blockBase + 4, blockIndices);
+				const SimdFloat ay = originY + SimdHighHalfToFloat(axayWords) * stepY;
+				const SimdFloat by = originY + SimdHighHalfToFloat(bxbyWords) * stepY;
+				const SimdFloat cy = originY + SimdHighHalfToFloat(cxcyWords) * stepY;
+				overlap = SimdAnd(overlap, SimdAnd(
+					SimdLessEqual(boundsMinY, SimdMax(ay, SimdMax(by, cy))),
+					SimdGreaterEqual(boundsMaxY, SimdMin(ay, SimdMin(by, cy)))));
 
+				const SimdFloat originZ = SimdGather(blockBase + 2, blockIndices);
+				const SimdFloat stepZ = SimdGather(blockBase + 5, blockIndices);
+				const SimdFloat az = originZ + SimdLowHalfToFloat(SimdGatherWords(vertexBase + 1, vertexA)) * stepZ;
+				const SimdFloat bz = originZ + SimdLowHalfToFloat(SimdGatherWords(vertexBase + 1, vertexB)) * stepZ;
+				const SimdFloat cz = originZ + SimdLowHalfToFloat(SimdGatherWords(vertexBase + 1, vertexC)) * stepZ;
+				overlap = SimdAnd(overlap, SimdAnd(
+					SimdLessEqual(boundsMinZ, SimdMax(az, SimdMax(bz, cz))),
+					SimdGreaterEqual(boundsMaxZ, SimdMin(az, SimdMin(bz, cz)))));
+
+				const uint32_t overlapMask = SimdMoveMask(overlap);
+				if (stats)
+				{
+					stats->NarrowPhaseBatches++;
+					stats->NarrowPhaseTests += overlapMask != 0 ? static_cast<uint32_t>(std::countr_zero(overlapMask)) + 1 : SimdWidth;
+				}
+
+				if (overlapMask != 0)
+				{
+					if (stats)
+						stats->ContactsGenerated++;
+					return true;
+				}
+			}
+
+			for (; candidateIndex < candidates.size(); candidateIndex++)
+			{
+				const CompactWorldTriangle& triangle = triangles[candidates[candidateIndex]];
+				glm::vec3 a;
+				glm::vec3 b;
+				glm::vec3 c;
+				DecodeCompactTriangle(triangle, blocks[triangle.BlockIndex], vertices, a, b, c);
 				if (stats)
 					stats->NarrowPhaseTests++;
 
-				const WorldTriangle& triangle = triangles[triangleIndex];
-				if (BoundsOverlap(bounds, triangle.Bounds))
+				const AxisAlignedBounds triangleBounds = CalculateTriangleBounds(a, b, c);
+				if (bounds.Min.x <= triangleBounds.Max.x && bounds.Max.x >= triangleBounds.Min.x &&
+					bounds.Min.y <= triangleBounds.Max.y && bounds.Max.y >= triangleBounds.Min.y &&
+					bounds.Min.z <= triangleBounds.Max.z && bounds.Max.z >= triangleBounds.Min.z)
 				{
 					if (stats)
 						stats->ContactsGenerated++;
@@ -153,125 +597,166 @@ namespace FuturaLibrary
 			return false;
 		}
 
-		GridCoord ToGridCoord(const glm::vec3& point, float cellSize)
+		// Sums every field; new CollisionQueryStats counters belong here too.
+		void AccumulateCollisionStats(CollisionQueryStats& target, const CollisionQueryStats& source)
 		{
-			return {
-				static_cast<int32_t>(std::floor(point.x / cellSize)),
-				static_cast<int32_t>(std::floor(point.y / cellSize)),
-				static_cast<int32_t>(std::floor(point.z / cellSize))
-			};
+			target.CollisionTimeMs += source.CollisionTimeMs;
+			target.CandidateWorlds += source.CandidateWorlds;
+			target.BroadPhaseQueries += source.BroadPhaseQueries;
+			target.CandidateSurfaces += source.CandidateSurfaces;
+			target.CandidateTriangles += source.CandidateTriangles;
+			target.NarrowPhaseTests += source.NarrowPhaseTests;
+			target.NarrowPhaseBatches += source.NarrowPhaseBatches;
+			target.ContactsGenerated += source.ContactsGenerated;
+			target.SweepQueries += source.SweepQueries;
+			target.ClosestFeatureTests += source.ClosestFeatureTests;
+			target.OcclusionQueries += source.OcclusionQueries;
+			target.OcclusionTests += source.OcclusionTests;
+			target.OccludedRays += source.OccludedRays;
+			target.QueryCacheHits += source.QueryCacheHits;
+			target.QueryCacheMisses += source.QueryCacheMisses;
+			target.MovementBatches += source.MovementBatches;
+			target.BatchedMovers += source.BatchedMovers;
+			target.MovementBatchTimeMs += source.MovementBatchTimeMs;
 		}
 
-		int64_t HashGridCoord(const GridCoord& coord)
+		void HashBytes(uint64_t& hash, const void* data, size_t size)
 		{
-			const int64_t x = static_cast<int64_t>(coord.X) & 0x1fffff;
-			const int64_t y = static_cast<int64_t>(coord.Y) & 0x1fffff;
-			const int64_t z = static_cast<int64_t>(coord.Z) & 0x1fffff;
-			return x | (y << 21) | (z << 42);
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
 		}
-	}
 
-	StaticWorld::StaticWorld(const std::string& sourceName)
-		: m_SourceName(sourceName)
-	{
-	}
+		// Fixed lattice of probe boxes over the world bounds for VerifyBuild. Large probes overlap plenty of
+		// triangles; small ones mostly miss, so the narrow phase sees both answers.
+		std::vector<AxisAlignedBounds> MakeVerificationProbes(const AxisAlignedBounds& worldBounds)
+		{
+			constexpr uint32_t probeSteps = 4;
+			const glm::vec3 extent = glm::max(worldBounds.Max - worldBounds.Min, glm::vec3(MinGridCellSize));
+			std::vector<AxisAlignedBounds> probes;
+			for (uint32_t probeIndex = 0; probeIndex < probeSteps * probeSteps * probeSteps; probeIndex++)
+			{
+				const glm::vec3 cell(
+					static_cast<float>(probeIndex % probeSteps),
+					static_cast<float>(probeIndex / probeSteps % probeSteps),
+					static_cast<float>(probeIndex / (probeSteps * probeSteps)));
+				const glm::vec3 center = worldBounds.Min + extent * (cell + 0.5f) / static_cast<float>(probeSteps);
+				for (const float probeScale : { 0.6f, 0.02f })
+					probes.push_back(MakeAABB(center, extent * (probeScale / probeSteps)));
+			}
+			return probes;
+		}
 
-	void StaticWorld::AddModel(const Ref<Model>& model, const WorldTransform& transform)
-	{
-		FT_CORE_ASSERT(model, "StaticWorld requires a model!");
+		// One file per source model, placement and broad-phase choice, so worlds that share a model
+		// keep separate caches. The header repeats the key and the loader rejects any mismatch.
+		std::filesystem::path GetWorldCachePath(const std::string& sourcePath, const WorldTransform& transform, const StaticWorldSettings& settings)
+		{
+			const uint32_t broadPhase = static_cast<uint32_t>(settings.BroadPhase);
+			uint64_t hash = 14695981039346656037ull;
+			HashBytes(hash, sourcePath.data(), sourcePath.size());
+			HashBytes(hash, &transform.Matrix, sizeof(transform.Matrix));
+			HashBytes(hash, &broadPhase, sizeof(broadPhase));
+			HashBytes(hash, &settings.GridCellSize, sizeof(settings.GridCellSize));
+			HashBytes(hash, &settings.WeldTolerance, sizeof(settings.WeldTolerance));
+			HashBytes(hash, &settings.BuildEdgeAdjacency, sizeof(settings.BuildEdgeAdjacency));
+			HashBytes(hash, &settings.SimplifyTolerance, sizeof(settings.SimplifyTolerance));
 
-		if (m_SourceName.empty())
-			m_SourceName = model->GetSourcePath();
-		m_Transform = transform;
+			const std::filesystem::path path = sourcePath;
+			std::stringstream cacheName;
+			cacheName << path.stem().string() << "-" << std::hex << hash << ".fworld";
+			return path.parent_path() / ".futura-cache" / cacheName.str();
+		}
 
-		const std::vector<ModelSubmesh>& submeshes = model->GetSubmeshes();
-		for (size_t i = 0; i < submeshes.size(); i++)
+		// The BSP cache sits beside its world cache and adds the compile settings to the name, so changing
+		// them compiles a new tree instead of rejecting the old one on every start.
+		std::filesystem::path GetBspCachePath(const std::filesystem::path& worldCachePath, const BspBuildSettings& settings)
 		{
-			const ModelSubmesh& submesh = submeshes[i];
-			WorldMaterialRef materialRef;
-			materialRef.Name = submesh.Name;
-			materialRef.MaterialAsset = submesh.MaterialAsset;
-			materialRef.SourceMaterialIndex = submesh.MaterialIndex;
-			const uint32_t materialIndex = static_cast<uint32_t>(m_Materials.size());
-			m_Materials.push_back(materialRef);
-
-			WorldSurface surface;
-			surface.Name = submesh.Name;
-			surface.SourceModelPath = model->GetSourcePath();
-			surface.SourceSubmeshIndex = static_cast<uint32_t>(i);
-			surface.MaterialIndex = materialIndex;
-			surface.MeshAsset = submesh.MeshAsset;
-			surface.Transform = transform;
-			surface.LocalBounds = submesh.LocalBounds.IsValid ? submesh.LocalBounds : submesh.MeshAsset->GetLocalBounds();
-			surface.WorldBounds = TransformBounds(surface.LocalBounds, transform.Matrix);
+			uint64_t hash = 14695981039346656037ull;
+			HashBytes(hash, &settings.SplitCandidates, sizeof(settings.SplitCandidates));
+			HashBytes(hash, &settings.SplitWeight, sizeof(settings.SplitWeight));
+			HashBytes(hash, &settings.BalanceWeight, sizeof(settings.BalanceWeight));
+			HashBytes(hash, &settings.PlaneEpsilon, sizeof(settings.PlaneEpsilon));
+			HashBytes(hash, &settings.MaxDepth, sizeof(settings.MaxDepth));
 
-			Encapsulate(m_LocalBounds, surface.LocalBounds);
-			Encapsulate(m_WorldBounds, surface.WorldBounds);
-			m_Surfaces.push_back(surface);
-			ExtractCollisionTriangles(m_Surfaces.back());
+			std::stringstream cacheName;
+			cacheName << worldCachePath.stem().string() << "-" << std::hex << hash << ".fbsp";
+			return worldCachePath.parent_path() / cacheName.str();
 		}
 
-		BuildSpatialGrid();
-	}
-
-	void StaticWorld::ExtractCollisionTriangles(const WorldSurface& surface)
-	{
-		if (!surface.MeshAsset)
-			return;
+		// Scratch for ResolveAABBMovementBatch groups. A pool thread runs one chunk at a time, so a
+		// context per thread lets batches run at once on one world or several without sharing state.
+		WorldQueryContext& GetThreadBatchQueryContext()
+		{
+			thread_local WorldQueryContext s_Context;
+			return s_Context;
+		}
 
-		const std::vector<Vertex>& vertices = surface.MeshAsset->GetVertices();
-		const std::vector<uint32_t>& indices = surface.MeshAsset->GetIndices();
-		if (vertices.empty() || indices.size() < 3)
-			return;
+		uint64_t NextSpatialGridVersion()
+		{
+			static std::atomic<uint64_t> s_NextVersion = 1;
+			return s_NextVersion.fetch_add(1, std::memory_order_relaxed);
+		}
 
-		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		// Clamped to the coordinates a cell key can hold, so a query box reaching past them visits the border
+		// cells instead of wrapping onto unrelated keys.
+		int32_t ToGridAxis(float value, float cellSize)
 		{
-			const uint32_t indexA = indices[i];
-			const uint32_t indexB = indices[i + 1];
-			const uint32_t indexC = indices[i + 2];
-			if (indexA >= vertices.size() || indexB >= vertices.size() || indexC >= vertices.size())
-				continue;
+			return static_cast<int32_t>(std::clamp(
+				std::floor(value / cellSize),
+				static_cast<float>(PackedSpatialGrid::MinCellCoordinate),
+				static_cast<float>(PackedSpatialGrid::MaxCellCoordinate)));
+		}
 
-			const glm::vec3 a = glm::vec3(surface.Transform.Matrix * glm::vec4(vertices[indexA].Position, 1.0f));
-			const glm::vec3 b = glm::vec3(surface.Transform.Matrix * glm::vec4(vertices[indexB].Position, 1.0f));
-			const glm::vec3 c = glm::vec3(surface.Transform.Matrix * glm::vec4(vertices[indexC].Position, 1.0f));
-			const glm::vec3 normal = glm::cross(b - a, c - a);
-			if (glm::length2(normal) <= 0.0f)
-				continue;
+		GridCoord ToGridCoord(const glm::vec3& point, float cellSize)
+		{
+			return { ToGridAxis(point.x, cellSize), ToGridAxis(point.y, cellSize), ToGridAxis(point.z, cellSize) };
+		}
 
-			WorldTriangle triangle;
-			triangle.A = a;
-			triangle.B = b;
-			triangle.C = c;
-			triangle.Normal = glm::normalize(normal);
-			triangle.Bounds = CalculateTriangleBounds(a, b, c);
-			triangle.SourceSurfaceIndex = static_cast<uint32_t>(m_Surfaces.size() - 1);
-			m_CollisionTriangles.push_back(triangle);
+		// Cell coordinates are packed into 21 bits per axis. The base cell size keeps the world well inside
+		// that range, which leaves room for streamed chunks before the grid has to be rebuilt.
+		float GetMinimumGridCellSize(const AxisAlignedBounds& worldBounds)
+		{
+			const glm::vec3 worldReach = worldBounds.IsValid ? glm::max(glm::abs(worldBounds.Min), glm::abs(worldBounds.Max)) : glm::vec3(0.0f);
+			return std::max(std::max(worldReach.x, std::max(worldReach.y, worldReach.z)) / MaxGridCellsPerAxis, MinGridCellSize);
 		}
-	}
 
-	void StaticWorld::BuildSpatialGrid()
-	{
-		m_SpatialGrid.clear();
-		m_CollisionQueryMarks.assign(m_CollisionTriangles.size(), 0);
-		m_SurfaceQueryMarks.assign(m_Surfaces.size(), 0);
-		m_CollisionQueryCandidates.clear();
-		m_CollisionQueryCandidates.reserve(512);
-		m_CollisionQueryStamp = 1;
-		m_SurfaceQueryStamp = 1;
-		m_AccelerationStats = {};
-		m_AccelerationStats.CellSize = m_SpatialGridCellSize;
-		m_AccelerationStats.IndexedSurfaces = static_cast<uint32_t>(m_Surfaces.size());
-		m_AccelerationStats.IndexedTriangles = static_cast<uint32_t>(m_CollisionTriangles.size());
+		bool GridCellKeysCoverBounds(const AxisAlignedBounds& worldBounds, float cellSize)
+		{
+			const glm::vec3 worldReach = worldBounds.IsValid ? glm::max(glm::abs(worldBounds.Min), glm::abs(worldBounds.Max)) : glm::vec3(0.0f);
+			return std::max(worldReach.x, std::max(worldReach.y, worldReach.z)) < cellSize * static_cast<float>(PackedSpatialGrid::MaxCellCoordinate);
+		}
 
-		if (m_CollisionTriangles.empty())
-			return;
+		uint64_t GridCellKey(const GridCoord& coord)
+		{
+			return PackedSpatialGrid::MakeCellKey(coord.X, coord.Y, coord.Z);
+		}
 
-		for (uint32_t triangleIndex = 0; triangleIndex < m_CollisionTriangles.size(); triangleIndex++)
+		// Visits the occupied cells of one grid level inside [minCoord, maxCoord]. When the box spans more
+		// cells than the level holds, scanning the occupied cells beats probing mostly empty ones.
+		template <typename CellFunction>
+		void ForEachOccupiedCell(const PackedSpatialGrid& grid, const GridCoord& minCoord, const GridCoord& maxCoord, CellFunction&& cellFunction)
 		{
-			const WorldTriangle& triangle = m_CollisionTriangles[triangleIndex];
-			const GridCoord minCoord = ToGridCoord(triangle.Bounds.Min, m_SpatialGridCellSize);
-			const GridCoord maxCoord = ToGridCoord(triangle.Bounds.Max, m_SpatialGridCellSize);
+			const uint64_t rangeCells =
+				static_cast<uint64_t>(static_cast<int64_t>(maxCoord.X) - minCoord.X + 1) *
+				static_cast<uint64_t>(static_cast<int64_t>(maxCoord.Y) - minCoord.Y + 1) *
+				static_cast<uint64_t>(static_cast<int64_t>(maxCoord.Z) - minCoord.Z + 1);
+			if (rangeCells > grid.GetCellCount())
+			{
+				for (uint32_t cellIndex = 0; cellIndex < grid.GetCellCount(); cellIndex++)
+				{
+					GridCoord cell;
+					PackedSpatialGrid::DecodeCellKey(grid.GetCellKey(cellIndex), cell.X, cell.Y, cell.Z);
+					if (cell.X >= minCoord.X && cell.X <= maxCoord.X &&
+						cell.Y >= minCoord.Y && cell.Y <= maxCoord.Y &&
+						cell.Z >= minCoord.Z && cell.Z <= maxCoord.Z)
+						cellFunction(cellIndex);
+				}
+
+				return;
+			}
 
 			for (int32_t z = minCoord.Z; z <= maxCoord.Z; z++)
 			{
@@ -279,191 +764,3448 @@ namespace FuturaLibrary
 				{
 					for (int32_t x = minCoord.X; x <= maxCoord.X; x++)
 					{
-						SpatialCell& cell = m_SpatialGrid[HashGridCoord({ x, y, z })];
-						cell.CollisionTriangles.push_back(triangleIndex);
-
-						if (std::find(cell.Surfaces.begin(), cell.Surfaces.end(), triangle.SourceSurfaceIndex) == cell.Surfaces.end())
-							cell.Surfaces.push_back(triangle.SourceSurfaceIndex);
+						const uint32_t cellIndex = grid.FindCell(GridCellKey({ x, y, z }));
+						if (cellIndex != PackedSpatialGrid::InvalidCell)
+							cellFunction(cellIndex);
 					}
 				}
 			}
 		}
-		m_AccelerationStats.OccupiedCells = static_cast<uint32_t>(m_SpatialGrid.size());
-
-		FT_CORE_INFO(
-			"Built static world grid for '{0}': {1} surfaces, {2} collision triangles, {3} occupied cells.",
-			m_SourceName,
-			m_Surfaces.size(),
-			m_CollisionTriangles.size(),
-			m_SpatialGrid.size()
-		);
-	}
 
-	void StaticWorld::QueryCollisionTriangles(const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates, CollisionQueryStats* stats) const
-	{
-		candidates.clear();
-		if (!bounds.IsValid || m_SpatialGrid.empty())
-			return;
+		// Walks one grid level's Morton-sorted cells as an implicit octree. Nodes outside the frustum are
+		// skipped whole, nodes inside hand every cell to acceptCell, and single cells that straddle a plane
+		// go to testCell. Only non-empty nodes are visited, so empty space costs nothing.
+		template <typename AcceptFunction, typename TestFunction>
+		void CullSpatialGridCells(
+			const PackedSpatialGrid& grid,
+			float cellSize,
+			const Frustum& frustum,
+			FrustumCullStats& stats,
+			AcceptFunction&& acceptCell,
+			TestFunction&& testCell)
+		{
+			if (grid.IsEmpty())
+				return;
 
-		if (stats)
-			stats->BroadPhaseQueries++;
+			struct CellRange
+			{
+				uint32_t First;
+				uint32_t End;
+			};
 
-		if (m_CollisionQueryStamp == 0)
-		{
-			std::fill(m_CollisionQueryMarks.begin(), m_CollisionQueryMarks.end(), 0);
-			m_CollisionQueryStamp = 1;
-		}
-		if (m_SurfaceQueryStamp == 0)
-		{
-			std::fill(m_SurfaceQueryMarks.begin(), m_SurfaceQueryMarks.end(), 0);
-			m_SurfaceQueryStamp = 1;
-		}
+			CellRange stack[MaxCullCellRanges];
+			uint32_t stackSize = 0;
+			stack[stackSize++] = { 0, grid.GetCellCount() };
 
-		uint32_t candidateSurfaces = 0;
-		const GridCoord minCoord = ToGridCoord(bounds.Min, m_SpatialGridCellSize);
-		const GridCoord maxCoord = ToGridCoord(bounds.Max, m_SpatialGridCellSize);
-		for (int32_t z = minCoord.Z; z <= maxCoord.Z; z++)
-		{
-			for (int32_t y = minCoord.Y; y <= maxCoord.Y; y++)
+			while (stackSize > 0)
 			{
-				for (int32_t x = minCoord.X; x <= maxCoord.X; x++)
-				{
-					const auto cell = m_SpatialGrid.find(HashGridCoord({ x, y, z }));
-					if (cell == m_SpatialGrid.end())
-						continue;
+				const CellRange range = stack[--stackSize];
 
-					for (uint32_t triangleIndex : cell->second.CollisionTriangles)
-					{
-						if (triangleIndex >= m_CollisionQueryMarks.size() ||
-							m_CollisionQueryMarks[triangleIndex] == m_CollisionQueryStamp)
-							continue;
+				// The smallest octree node holding the first and last key holds the whole sorted range.
+				const uint64_t firstKey = grid.GetCellKey(range.First);
+				const uint64_t lastKey = grid.GetCellKey(range.End - 1);
+				const uint32_t nodeLevel = (static_cast<uint32_t>(std::bit_width(firstKey ^ lastKey)) + 2) / 3;
+				const uint32_t nodeShift = 3 * nodeLevel;
+				const uint64_t nodeKey = (firstKey >> nodeShift) << nodeShift;
 
-						m_CollisionQueryMarks[triangleIndex] = m_CollisionQueryStamp;
-						candidates.push_back(triangleIndex);
+				GridCoord nodeCell;
+				PackedSpatialGrid::DecodeCellKey(nodeKey, nodeCell.X, nodeCell.Y, nodeCell.Z);
+				const glm::vec3 nodeMin = glm::vec3(nodeCell.X, nodeCell.Y, nodeCell.Z) * cellSize;
+				const glm::vec3 nodeMax = nodeMin + glm::vec3(static_cast<float>(1u << nodeLevel) * cellSize);
 
-						const uint32_t surfaceIndex = m_CollisionTriangles[triangleIndex].SourceSurfaceIndex;
-						if (surfaceIndex < m_SurfaceQueryMarks.size() &&
-							m_SurfaceQueryMarks[surfaceIndex] != m_SurfaceQueryStamp)
-						{
-							m_SurfaceQueryMarks[surfaceIndex] = m_SurfaceQueryStamp;
-							candidateSurfaces++;
-						}
-					}
+				stats.CellsTested++;
+				const FrustumTest test = ClassifyBounds(frustum, nodeMin, nodeMax);
+				if (test == FrustumTest::Outside)
+					continue;
+
+				if (test == FrustumTest::Inside)
+				{
+					for (uint32_t cellIndex = range.First; cellIndex < range.End; cellIndex++)
+						acceptCell(cellIndex);
+					continue;
 				}
-			}
-		}
 
-		m_CollisionQueryStamp++;
-		m_SurfaceQueryStamp++;
-		if (stats)
+				if (range.End - range.First == 1)
+				{
+					testCell(range.First);
+					continue;
+				}
+
+				// Split at each child's first key, pushing the highest child first so low keys pop first.
+				uint32_t childEnd = range.End;
+				for (uint32_t child = 7; child > 0; child--)
+				{
+					const uint64_t childKey = nodeKey | (static_cast<uint64_t>(child) << (nodeShift - 3));
+					const uint32_t childFirst = std::max(grid.LowerBoundCell(childKey), range.First);
+					if (childFirst < childEnd)
+						stack[stackSize++] = { childFirst, childEnd };
+					childEnd = std::min(childEnd, childFirst);
+				}
+				if (range.First < childEnd)
+					stack[stackSize++] = { range.First, childEnd };
+			}
+		}
+
+		// The BVH counterpart of CullSpatialGridCells. Subtrees inside the frustum pass their primitives
+		// to acceptPrimitive without further node tests; leaves that straddle a plane use testPrimitive.
+		template <typename AcceptFunction, typename TestFunction>
+		void CullBoundingVolumeHierarchy(
+			const BoundingVolumeHierarchy& bvh,
+			const Frustum& frustum,
+			FrustumCullStats& stats,
+			AcceptFunction&& acceptPrimitive,
+			TestFunction&& testPrimitive)
+		{
+			const std::vector<BVHNode>& nodes = bvh.GetNodes();
+			const std::vector<uint32_t>& primitiveIndices = bvh.GetPrimitiveIndices();
+			if (nodes.empty())
+				return;
+
+			struct NodeEntry
+			{
+				uint32_t NodeIndex;
+				bool Inside;
+			};
+
+			NodeEntry stack[MaxCullTraversalDepth];
+			uint32_t stackSize = 0;
+			stack[stackSize++] = { 0, false };
+
+			while (stackSize > 0)
+			{
+				const NodeEntry entry = stack[--stackSize];
+				const BVHNode& node = nodes[entry.NodeIndex];
+
+				bool inside = entry.Inside;
+				if (!inside)
+				{
+					stats.CellsTested++;
+					const FrustumTest test = ClassifyBounds(frustum, node.Min, node.Max);
+					if (test == FrustumTest::Outside)
+						continue;
+
+					inside = test == FrustumTest::Inside;
+				}
+
+				if (node.IsLeaf())
+				{
+					for (uint32_t i = 0; i < node.PrimitiveCount; i++)
+					{
+						const uint32_t primitiveIndex = primitiveIndices[node.LeftFirst + i];
+						if (inside)
+							acceptPrimitive(primitiveIndex);
+						else
+							testPrimitive(primitiveIndex);
+					}
+
+					continue;
+				}
+
+				stack[stackSize++] = { node.LeftFirst + 1, inside };
+				stack[stackSize++] = { node.LeftFirst, inside };
+			}
+		}
+
+		uint32_t GetGridPartition(uint64_t cellKey, uint32_t partitionCount)
+		{
+			// Neighbouring cells differ only in the low key bits; mix them before splitting.
+			const uint64_t mixed = cellKey * 0x9e3779b97f4a7c15ull;
+			return static_cast<uint32_t>((mixed >> 32) % partitionCount);
+		}
+
+		void ExtractSurfaceTriangles(
+			const WorldSurface& surface,
+			uint32_t surfaceIndex,
+			size_t firstIndex,
+			size_t lastIndex,
+			std::vector<WorldTriangle>& triangles)
+		{
+			const std::vector<Vertex>& vertices = surface.MeshAsset->GetVertices();
+			const std::vector<uint32_t>& indices = surface.MeshAsset->GetIndices();
+			for (size_t i = firstIndex; i + 2 < lastIndex; i += 3)
+			{
+				const uint32_t indexA = indices[i];
+				const uint32_t indexB = indices[i + 1];
+				const uint32_t indexC = indices[i + 2];
+				if (indexA >= vertices.size() || indexB >= vertices.size() || indexC >= vertices.size())
+					continue;
+
+				const glm::vec3 a = glm::vec3(surface.Transform.Matrix * glm::vec4(vertices[indexA].Position, 1.0f));
+				const glm::vec3 b = glm::vec3(surface.Transform.Matrix * glm::vec4(vertices[indexB].Position, 1.0f));
+				const glm::vec3 c = glm::vec3(surface.Transform.Matrix * glm::vec4(vertices[indexC].Position, 1.0f));
+				const glm::vec3 normal = glm::cross(b - a, c - a);
+				if (glm::length2(normal) <= 0.0f)
+					continue;
+
+				WorldTriangle triangle;
+				triangle.A = a;
+				triangle.B = b;
+				triangle.C = c;
+				triangle.Normal = glm::normalize(normal);
+				triangle.Bounds = CalculateTriangleBounds(a, b, c);
+				triangle.SourceSurfaceIndex = surfaceIndex;
+				triangles.push_back(triangle);
+			}
+		}
+
+		struct WeldKey
+		{
+			int64_t X = 0;
+			int64_t Y = 0;
+			int64_t Z = 0;
+
+			bool operator==(const WeldKey& other) const { return X == other.X && Y == other.Y && Z == other.Z; }
+		};
+
+		struct WeldKeyHash
+		{
+			size_t operator()(const WeldKey& key) const
+			{
+				uint64_t hash = static_cast<uint64_t>(key.X) * 0x9e3779b97f4a7c15ull;
+				hash = (hash ^ (hash >> 29) ^ static_cast<uint64_t>(key.Y)) * 0xbf58476d1ce4e5b9ull;
+				hash = (hash ^ (hash >> 32) ^ static_cast<uint64_t>(key.Z)) * 0x94d049bb133111ebull;
+				return static_cast<size_t>(hash ^ (hash >> 31));
+			}
+		};
+
+		int64_t WeldCoordinate(float value, float tolerance)
+		{
+			// Adding zero folds -0 into +0 so both weld together.
+			if (tolerance <= 0.0f)
+				return static_cast<int64_t>(std::bit_cast<uint32_t>(value + 0.0f));
+
+			constexpr double MaxWeldCoordinate = 4.0e18;
+			return static_cast<int64_t>(std::clamp(std::round(static_cast<double>(value) / tolerance), -MaxWeldCoordinate, MaxWeldCoordinate));
+		}
+
+		// Cells one chunk of extraction jobs touched, in the order the chunk first reached them, with the
+		// first corner position seen in each.
+		struct WeldChunk
+		{
+			std::unordered_map<WeldKey, uint32_t, WeldKeyHash> LocalIds;
+			std::vector<WeldKey> Keys;
+			std::vector<glm::vec3> Positions;
+			std::vector<uint32_t> WeldedIds;
+		};
+
+		// A vertex already welded in one of the 26 cells around key whose position lies within tolerance,
+		// the nearest one first and the lowest id on ties; NoVertex when there is none.
+		uint32_t FindNeighborWeldVertex(
+			const std::unordered_map<WeldKey, uint32_t, WeldKeyHash>& vertexIds,
+			const std::vector<glm::vec3>& positions,
+			const WeldKey& key,
+			const glm::vec3& position,
+			float tolerance)
+		{
+			uint32_t bestVertex = NoVertex;
+			float bestDistance = tolerance * tolerance;
+			for (int64_t dz = -1; dz <= 1; dz++)
+			{
+				for (int64_t dy = -1; dy <= 1; dy++)
+				{
+					for (int64_t dx = -1; dx <= 1; dx++)
+					{
+						if (dx == 0 && dy == 0 && dz == 0)
+							continue;
+
+						const auto neighbor = vertexIds.find({ key.X + dx, key.Y + dy, key.Z + dz });
+						if (neighbor == vertexIds.end())
+							continue;
+
+						const float distance = glm::distance2(positions[neighbor->second], position);
+						if (distance < bestDistance || (distance == bestDistance && neighbor->second < bestVertex))
+						{
+							bestVertex = neighbor->second;
+							bestDistance = distance;
+						}
+					}
+				}
+			}
+
+			return bestVertex;
+		}
+
+		// Gives every corner a welded vertex id and snaps it to that vertex's position. Chunks of jobs first
+		// collect the lattice cells they touch in parallel; the cells are then merged in job order, where a
+		// cell not seen before joins a vertex within tolerance in a neighbouring cell, so corners on either
+		// side of a cell boundary still weld. Ids and positions follow the order cells are first reached
+		// in job order, so they do not depend on the thread count.
+		uint32_t WeldTriangleCorners(std::vector<std::vector<WorldTriangle>>& jobTriangles, float tolerance, uint32_t threadCount, std::vector<std::vector<uint32_t>>& jobCorners)
+		{
+			const uint32_t chunkCount = GetParallelChunkCount(jobTriangles.size(), 1, threadCount);
+			std::vector<WeldChunk> chunks(chunkCount);
+			ParallelForChunks(jobTriangles.size(), chunkCount, [&](uint32_t chunkIndex, size_t begin, size_t end)
+			{
+				WeldChunk& chunk = chunks[chunkIndex];
+				for (size_t jobIndex = begin; jobIndex < end; jobIndex++)
+				{
+					std::vector<uint32_t>& corners = jobCorners[jobIndex];
+					corners.resize(jobTriangles[jobIndex].size() * 3);
+					for (size_t triangleIndex = 0; triangleIndex < jobTriangles[jobIndex].size(); triangleIndex++)
+					{
+						const WorldTriangle& triangle = jobTriangles[jobIndex][triangleIndex];
+						const glm::vec3* trianglePositions[] = { &triangle.A, &triangle.B, &triangle.C };
+						for (uint32_t corner = 0; corner < 3; corner++)
+						{
+							const glm::vec3& position = *trianglePositions[corner];
+							const WeldKey key = { WeldCoordinate(position.x, tolerance), WeldCoordinate(position.y, tolerance), WeldCoordinate(position.z, tolerance) };
+							const auto [localId, inserted] = chunk.LocalIds.try_emplace(key, static_cast<uint32_t>(chunk.Keys.size()));
+							if (inserted)
+							{
+								chunk.Keys.push_back(key);
+								chunk.Positions.push_back(position);
+							}
+							corners[triangleIndex * 3 + corner] = localId->second;
+						}
+					}
+				}
+				std::unordered_map<WeldKey, uint32_t, WeldKeyHash>().swap(chunk.LocalIds);
+			});
+
+			size_t cellCount = 0;
+			for (const WeldChunk& chunk : chunks)
+				cellCount += chunk.Keys.size();
+
+			// Only cells, not corners, pass through this serial step, and most repeat across chunks only
+			// along the chunk seams.
+			std::unordered_map<WeldKey, uint32_t, WeldKeyHash> vertexIds;
+			vertexIds.reserve(cellCount);
+			std::vector<glm::vec3> positions;
+			positions.reserve(cellCount);
+			for (WeldChunk& chunk : chunks)
+			{
+				chunk.WeldedIds.resize(chunk.Keys.size());
+				for (size_t cell = 0; cell < chunk.Keys.size(); cell++)
+				{
+					const WeldKey& key = chunk.Keys[cell];
+					const auto existing = vertexIds.find(key);
+					if (existing != vertexIds.end())
+					{
+						chunk.WeldedIds[cell] = existing->second;
+						continue;
+					}
+
+					uint32_t vertex = tolerance > 0.0f ? FindNeighborWeldVertex(vertexIds, positions, key, chunk.Positions[cell], tolerance) : NoVertex;
+					if (vertex == NoVertex)
+					{
+						vertex = static_cast<uint32_t>(positions.size());
+						positions.push_back(chunk.Positions[cell]);
+					}
+					vertexIds.emplace(key, vertex);
+					chunk.WeldedIds[cell] = vertex;
+				}
+			}
+
+			ParallelForChunks(jobTriangles.size(), chunkCount, [&](uint32_t chunkIndex, size_t begin, size_t end)
+			{
+				const WeldChunk& chunk = chunks[chunkIndex];
+				for (size_t jobIndex = begin; jobIndex < end; jobIndex++)
+				{
+					std::vector<uint32_t>& corners = jobCorners[jobIndex];
+					for (size_t triangleIndex = 0; triangleIndex < jobTriangles[jobIndex].size(); triangleIndex++)
+					{
+						WorldTriangle& triangle = jobTriangles[jobIndex][triangleIndex];
+						glm::vec3* trianglePositions[] = { &triangle.A, &triangle.B, &triangle.C };
+						for (uint32_t corner = 0; corner < 3; corner++)
+						{
+							uint32_t& vertex = corners[triangleIndex * 3 + corner];
+							vertex = chunk.WeldedIds[vertex];
+							*trianglePositions[corner] = positions[vertex];
+						}
+						triangle.Bounds = CalculateTriangleBounds(triangle.A, triangle.B, triangle.C);
+					}
+				}
+			});
+
+			return static_cast<uint32_t>(positions.size());
+		}
+
+		// One extraction job's share of the collision mesh. Indices and block indices are local to the job
+		// until the jobs are appended; WeldedCorners keeps the welded ids of each kept triangle for adjacency.
+		struct CompressedTriangles
+		{
+			std::vector<CompactWorldVertex> Vertices;
+			std::vector<CompactWorldTriangle> Triangles;
+			std::vector<CollisionTriangleBlock> Blocks;
+			std::vector<uint32_t> WeldedCorners;
+		};
+
+		// Sort order and lattice of one extraction job's blocks: block b holds the triangles at
+		// Order[b * CollisionBlockTriangles] onwards. Minimums are the snapped block bounds.
+		struct TriangleBlockPlan
+		{
+			std::vector<uint32_t> Order;
+			std::vector<glm::vec3> Steps;
+			std::vector<glm::vec3> Minimums;
+		};
+
+		// Rounds in double so the result is the lattice point itself; it is exact in float whenever the step
+		// is at least the float spacing at that distance from the origin, which ChooseQuantizationStep ensures.
+		glm::vec3 SnapToLattice(const glm::vec3& position, const glm::vec3& step)
+		{
+			return glm::vec3(
+				static_cast<float>(std::round(static_cast<double>(position.x) / step.x) * step.x),
+				static_cast<float>(std::round(static_cast<double>(position.y) / step.y) * step.y),
+				static_cast<float>(std::round(static_cast<double>(position.z) / step.z) * step.z));
+		}
+
+		// Orders one surface's triangles along a Morton curve over their centroids and gives each run of
+		// CollisionBlockTriangles a lattice fitted to its bounds. Triangles whose corners welded together
+		// are left out.
+		void PlanSurfaceBlocks(const std::vector<WorldTriangle>& triangles, const std::vector<uint32_t>& corners, TriangleBlockPlan& plan)
+		{
+			if (triangles.empty())
+				return;
+
+			AxisAlignedBounds surfaceBounds;
+			for (const WorldTriangle& triangle : triangles)
+				Encapsulate(surfaceBounds, triangle.Bounds);
+
+			const glm::vec3 surfaceExtent = surfaceBounds.Max - surfaceBounds.Min;
+			const float sortCellSize = std::max(std::max(surfaceExtent.x, std::max(surfaceExtent.y, surfaceExtent.z)) / MortonSortCellsPerAxis, MinGridCellSize);
+			std::vector<uint64_t> sortKeys(triangles.size());
+			plan.Order.reserve(triangles.size());
+			for (uint32_t triangleIndex = 0; triangleIndex < triangles.size(); triangleIndex++)
+			{
+				const uint32_t* weldedIds = corners.data() + static_cast<size_t>(triangleIndex) * 3;
+				if (weldedIds[0] == weldedIds[1] || weldedIds[1] == weldedIds[2] || weldedIds[2] == weldedIds[0])
+					continue;
+
+				const WorldTriangle& triangle = triangles[triangleIndex];
+				const glm::vec3 centroid = (triangle.A + triangle.B + triangle.C) / 3.0f;
+				sortKeys[triangleIndex] = GridCellKey(ToGridCoord(centroid - surfaceBounds.Min, sortCellSize));
+				plan.Order.push_back(triangleIndex);
+			}
+			std::sort(plan.Order.begin(), plan.Order.end(), [&sortKeys](uint32_t a, uint32_t b)
+			{
+				return sortKeys[a] != sortKeys[b] ? sortKeys[a] < sortKeys[b] : a < b;
+			});
+
+			for (size_t blockStart = 0; blockStart < plan.Order.size(); blockStart += CollisionBlockTriangles)
+			{
+				const size_t blockEnd = std::min(blockStart + CollisionBlockTriangles, plan.Order.size());
+				AxisAlignedBounds blockBounds;
+				for (size_t sortedIndex = blockStart; sortedIndex < blockEnd; sortedIndex++)
+					Encapsulate(blockBounds, triangles[plan.Order[sortedIndex]].Bounds);
+
+				plan.Steps.push_back(glm::vec3(
+					ChooseQuantizationStep(blockBounds.Min.x, blockBounds.Max.x),
+					ChooseQuantizationStep(blockBounds.Min.y, blockBounds.Max.y),
+					ChooseQuantizationStep(blockBounds.Min.z, blockBounds.Max.z)));
+				plan.Minimums.push_back(blockBounds.Min);
+			}
+		}
+
+		// Raises each welded vertex's step to the coarsest step of the blocks that use it.
+		void RaiseVertexSteps(const std::vector<uint32_t>& corners, const TriangleBlockPlan& plan, std::vector<glm::vec3>& vertexSteps)
+		{
+			for (size_t sortedIndex = 0; sortedIndex < plan.Order.size(); sortedIndex++)
+			{
+				const glm::vec3& blockStep = plan.Steps[sortedIndex / CollisionBlockTriangles];
+				const uint32_t* weldedIds = corners.data() + static_cast<size_t>(plan.Order[sortedIndex]) * 3;
+				for (uint32_t corner = 0; corner < 3; corner++)
+					vertexSteps[weldedIds[corner]] = glm::max(vertexSteps[weldedIds[corner]], blockStep);
+			}
+		}
+
+		// Refits every block to the bounds of its snapped corners, which can reach up to half a vertex step
+		// past the source bounds. Steps only grow. Returns whether any did.
+		bool FitBlockSteps(
+			const std::vector<WorldTriangle>& triangles,
+			const std::vector<uint32_t>& corners,
+			const std::vector<glm::vec3>& vertexSteps,
+			TriangleBlockPlan& plan)
+		{
+			bool grew = false;
+			for (size_t blockIndex = 0; blockIndex < plan.Steps.size(); blockIndex++)
+			{
+				const size_t blockStart = blockIndex * CollisionBlockTriangles;
+				const size_t blockEnd = std::min(blockStart + CollisionBlockTriangles, plan.Order.size());
+				AxisAlignedBounds blockBounds;
+				for (size_t sortedIndex = blockStart; sortedIndex < blockEnd; sortedIndex++)
+				{
+					const WorldTriangle& triangle = triangles[plan.Order[sortedIndex]];
+					const uint32_t* weldedIds = corners.data() + static_cast<size_t>(plan.Order[sortedIndex]) * 3;
+					Encapsulate(blockBounds, CalculateTriangleBounds(
+						SnapToLattice(triangle.A, vertexSteps[weldedIds[0]]),
+						SnapToLattice(triangle.B, vertexSteps[weldedIds[1]]),
+						SnapToLattice(triangle.C, vertexSteps[weldedIds[2]])));
+				}
+
+				const glm::vec3 step = glm::max(plan.Steps[blockIndex], glm::vec3(
+					ChooseQuantizationStep(blockBounds.Min.x, blockBounds.Max.x),
+					ChooseQuantizationStep(blockBounds.Min.y, blockBounds.Max.y),
+					ChooseQuantizationStep(blockBounds.Min.z, blockBounds.Max.z)));
+				grew = grew || step != plan.Steps[blockIndex];
+				plan.Steps[blockIndex] = step;
+				plan.Minimums[blockIndex] = blockBounds.Min;
+			}
+			return grew;
+		}
+
+		// Quantises each planned block onto its lattice and stores the welded vertices its triangles use once.
+		// Every corner is snapped to its vertex step, a power-of-two multiple of the block step, so it lands
+		// on the lattice exactly and a vertex shared by several blocks decodes to the same point in each.
+		// Triangles that collapse onto the lattice are dropped. localVertices maps welded ids to block
+		// vertices and must hold NoVertex for every id on entry.
+		void CompressSurfaceTriangles(
+			const std::vector<WorldTriangle>& triangles,
+			const std::vector<uint32_t>& corners,
+			const TriangleBlockPlan& plan,
+			const std::vector<glm::vec3>& vertexSteps,
+			uint32_t surfaceIndex,
+			std::vector<uint32_t>& localVertices,
+			CompressedTriangles& output)
+		{
+			output.Triangles.reserve(output.Triangles.size() + plan.Order.size());
+			output.WeldedCorners.reserve(output.WeldedCorners.size() + plan.Order.size() * 3);
+			for (size_t blockStart = 0; blockStart < plan.Order.size(); blockStart += CollisionBlockTriangles)
+			{
+				const size_t blockEnd = std::min(blockStart + CollisionBlockTriangles, plan.Order.size());
+				const glm::vec3& step = plan.Steps[blockStart / CollisionBlockTriangles];
+				const glm::vec3& minimum = plan.Minimums[blockStart / CollisionBlockTriangles];
+
+				CollisionTriangleBlock block;
+				block.StepX = step.x;
+				block.StepY = step.y;
+				block.StepZ = step.z;
+				block.OriginX = std::floor(minimum.x / block.StepX) * block.StepX;
+				block.OriginY = std::floor(minimum.y / block.StepY) * block.StepY;
+				block.OriginZ = std::floor(minimum.z / block.StepZ) * block.StepZ;
+				block.SourceSurfaceIndex = surfaceIndex;
+
+				const uint32_t blockIndex = static_cast<uint32_t>(output.Blocks.size());
+				const size_t firstVertex = output.Vertices.size();
+				const size_t firstTriangle = output.Triangles.size();
+				for (size_t sortedIndex = blockStart; sortedIndex < blockEnd; sortedIndex++)
+				{
+					const uint32_t triangleIndex = plan.Order[sortedIndex];
+					const uint32_t* weldedIds = corners.data() + static_cast<size_t>(triangleIndex) * 3;
+					const WorldTriangle& triangle = triangles[triangleIndex];
+					const CompactWorldVertex quantized[] =
+					{
+						QuantizeVertex(SnapToLattice(triangle.A, vertexSteps[weldedIds[0]]), block),
+						QuantizeVertex(SnapToLattice(triangle.B, vertexSteps[weldedIds[1]]), block),
+						QuantizeVertex(SnapToLattice(triangle.C, vertexSteps[weldedIds[2]]), block)
+					};
+					const glm::vec3 a = DecodeVertex(quantized[0], block);
+					const glm::vec3 b = DecodeVertex(quantized[1], block);
+					const glm::vec3 c = DecodeVertex(quantized[2], block);
+					if (glm::length2(glm::cross(b - a, c - a)) <= 0.0f)
+						continue;
+
+					CompactWorldTriangle compactTriangle;
+					for (uint32_t corner = 0; corner < 3; corner++)
+					{
+						uint32_t& localVertex = localVertices[weldedIds[corner]];
+						if (localVertex == NoVertex)
+						{
+							localVertex = static_cast<uint32_t>(output.Vertices.size());
+							output.Vertices.push_back(quantized[corner]);
+						}
+						compactTriangle.Indices[corner] = localVertex;
+						output.WeldedCorners.push_back(weldedIds[corner]);
+					}
+					compactTriangle.BlockIndex = blockIndex;
+					output.Triangles.push_back(compactTriangle);
+				}
+
+				// Clear only the ids this block touched, so the scratch map stays valid for the next block.
+				for (size_t cornerIndex = firstTriangle * 3; cornerIndex < output.WeldedCorners.size(); cornerIndex++)
+					localVertices[output.WeldedCorners[cornerIndex]] = NoVertex;
+
+				if (output.Vertices.size() > firstVertex)
+					output.Blocks.push_back(block);
+			}
+		}
+
+		// Pairs triangles that share an edge by its two welded vertex ids. Edges used by exactly two triangles
+		// get neighbours; open and non-manifold edges keep NoNeighbor.
+		void BuildTriangleAdjacency(const std::vector<uint32_t>& weldedCorners, uint32_t firstTriangle, std::vector<WorldTriangleAdjacency>& adjacency)
+		{
+			struct EdgeRecord
+			{
+				uint64_t Key = 0;
+				uint32_t Triangle = 0;
+				uint32_t Edge = 0;
+			};
+
+			const uint32_t triangleCount = static_cast<uint32_t>(weldedCorners.size() / 3);
+			std::vector<EdgeRecord> edges;
+			edges.reserve(weldedCorners.size());
+			for (uint32_t triangleIndex = 0; triangleIndex < triangleCount; triangleIndex++)
+			{
+				for (uint32_t edge = 0; edge < 3; edge++)
+				{
+					const uint32_t start = weldedCorners[triangleIndex * 3 + edge];
+					const uint32_t end = weldedCorners[triangleIndex * 3 + (edge + 1) % 3];
+					const uint64_t key = (static_cast<uint64_t>(std::min(start, end)) << 32) | std::max(start, end);
+					edges.push_back({ key, triangleIndex, edge });
+				}
+			}
+			std::sort(edges.begin(), edges.end(), [](const EdgeRecord& a, const EdgeRecord& b)
+			{
+				if (a.Key != b.Key)
+					return a.Key < b.Key;
+				return a.Triangle != b.Triangle ? a.Triangle < b.Triangle : a.Edge < b.Edge;
+			});
+
+			adjacency.resize(static_cast<size_t>(firstTriangle) + triangleCount);
+			for (size_t first = 0; first < edges.size();)
+			{
+				size_t last = first + 1;
+				while (last < edges.size() && edges[last].Key == edges[first].Key)
+					last++;
+
+				if (last - first == 2)
+				{
+					const EdgeRecord& a = edges[first];
+					const EdgeRecord& b = edges[first + 1];
+					adjacency[firstTriangle + a.Triangle].Neighbors[a.Edge] = firstTriangle + b.Triangle;
+					adjacency[firstTriangle + b.Triangle].Neighbors[b.Edge] = firstTriangle + a.Triangle;
+				}
+				first = last;
+			}
+		}
+
+		struct SimplificationResult
+		{
+			uint32_t MergedTriangles = 0;
+			uint32_t SliverTriangles = 0;
+		};
+
+		struct RegionPlane
+		{
+			glm::vec3 Normal = glm::vec3(0.0f);
+			float Distance = 0.0f;
+		};
+
+		// The welded mesh of one extraction, flattened across jobs. Triangles keep their flat index for the
+		// whole simplification; removed ones are only marked, so jobs can be rebuilt in their original order.
+		struct SimplificationMesh
+		{
+			std::vector<glm::vec3> Positions;
+			std::vector<uint32_t> Corners;
+			std::vector<uint32_t> Surfaces;
+			std::vector<uint32_t> Regions;
+			std::vector<RegionPlane> Planes;
+			std::vector<uint8_t> Alive;
+			std::vector<uint32_t> IncidenceOffsets;
+			std::vector<uint32_t> Incidence;
+		};
+
+		// Smallest altitude of a triangle: twice its area over its longest edge.
+		float GetTriangleThickness(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+		{
+			const float longestEdgeSquared = std::max(glm::length2(b - a), std::max(glm::length2(c - b), glm::length2(a - c)));
+			if (longestEdgeSquared <= 0.0f)
+				return 0.0f;
+
+			return glm::length(glm::cross(b - a, c - a)) / std::sqrt(longestEdgeSquared);
+		}
+
+		bool IsInsideRegionSlab(const RegionPlane& plane, const glm::vec3& point, float tolerance)
+		{
+			return std::abs(glm::dot(plane.Normal, point) - plane.Distance) <= tolerance;
+		}
+
+		// Grows regions across shared edges from each unassigned triangle of [firstTriangle, endTriangle) in
+		// order. A neighbour joins when it belongs to the same surface, faces within CoplanarNormalCosine of the
+		// seed and has every corner within tolerance of the seed plane, so a gently curved surface is split
+		// instead of drifting with the walk. Region indices index planes and start at zero.
+		void BuildPlanarRegions(SimplificationMesh& mesh, uint32_t firstTriangle, uint32_t endTriangle, float tolerance, std::vector<RegionPlane>& planes)
+		{
+			std::vector<uint32_t> liveTriangles;
+			std::vector<uint32_t> liveCorners;
+			for (uint32_t triangleIndex = firstTriangle; triangleIndex < endTriangle; triangleIndex++)
+			{
+				if (!mesh.Alive[triangleIndex])
+					continue;
+
+				liveTriangles.push_back(triangleIndex);
+				liveCorners.insert(liveCorners.end(), mesh.Corners.begin() + triangleIndex * 3, mesh.Corners.begin() + triangleIndex * 3 + 3);
+			}
+
+			std::vector<WorldTriangleAdjacency> adjacency;
+			BuildTriangleAdjacency(liveCorners, 0, adjacency);
+
+			const auto getNormal = [&mesh](uint32_t triangleIndex)
+			{
+				const uint32_t* corners = mesh.Corners.data() + static_cast<size_t>(triangleIndex) * 3;
+				const glm::vec3& a = mesh.Positions[corners[0]];
+				return glm::normalize(glm::cross(mesh.Positions[corners[1]] - a, mesh.Positions[corners[2]] - a));
+			};
+
+			std::vector<uint32_t> stack;
+			for (uint32_t seed = 0; seed < liveTriangles.size(); seed++)
+			{
+				const uint32_t seedTriangle = liveTriangles[seed];
+				if (mesh.Regions[seedTriangle] != NoTriangle)
+					continue;
+
+				RegionPlane plane;
+				plane.Normal = getNormal(seedTriangle);
+				plane.Distance = glm::dot(plane.Normal, mesh.Positions[mesh.Corners[static_cast<size_t>(seedTriangle) * 3]]);
+				const uint32_t regionIndex = static_cast<uint32_t>(planes.size());
+				planes.push_back(plane);
+				mesh.Regions[seedTriangle] = regionIndex;
+
+				stack.assign(1, seed);
+				while (!stack.empty())
+				{
+					const uint32_t current = stack.back();
+					stack.pop_back();
+					for (uint32_t neighbor : adjacency[current].Neighbors)
+					{
+						if (neighbor == WorldTriangleAdjacency::NoNeighbor)
+							continue;
+
+						const uint32_t neighborTriangle = liveTriangles[neighbor];
+						if (mesh.Regions[neighborTriangle] != NoTriangle ||
+							mesh.Surfaces[neighborTriangle] != mesh.Surfaces[seedTriangle] ||
+							glm::dot(getNormal(neighborTriangle), plane.Normal) < CoplanarNormalCosine)
+							continue;
+
+						const uint32_t* corners = mesh.Corners.data() + static_cast<size_t>(neighborTriangle) * 3;
+						if (!IsInsideRegionSlab(plane, mesh.Positions[corners[0]], tolerance) ||
+							!IsInsideRegionSlab(plane, mesh.Positions[corners[1]], tolerance) ||
+							!IsInsideRegionSlab(plane, mesh.Positions[corners[2]], tolerance))
+							continue;
+
+						mesh.Regions[neighborTriangle] = regionIndex;
+						stack.push_back(neighbor);
+					}
+				}
+			}
+		}
+
+		// Regions never cross surfaces and each surface's triangles form one run, so runs of whole surfaces
+		// are grown on separate threads. Their planes are appended in run order, which numbers the regions
+		// exactly as one walk over every triangle would.
+		void BuildPlanarRegions(SimplificationMesh& mesh, float tolerance, uint32_t threadCount)
+		{
+			std::vector<uint32_t> surfaceRuns;
+			for (uint32_t triangleIndex = 0; triangleIndex < mesh.Surfaces.size(); triangleIndex++)
+			{
+				if (triangleIndex == 0 || mesh.Surfaces[triangleIndex] != mesh.Surfaces[triangleIndex - 1])
+					surfaceRuns.push_back(triangleIndex);
+			}
+			surfaceRuns.push_back(static_cast<uint32_t>(mesh.Surfaces.size()));
+
+			const size_t runCount = surfaceRuns.size() - 1;
+			const uint32_t chunkCount = GetParallelChunkCount(runCount, 1, threadCount);
+			std::vector<std::vector<RegionPlane>> chunkPlanes(chunkCount);
+			mesh.Regions.assign(mesh.Alive.size(), NoTriangle);
+			ParallelForChunks(runCount, chunkCount, [&](uint32_t chunkIndex, size_t begin, size_t end)
+			{
+				if (begin < end)
+					BuildPlanarRegions(mesh, surfaceRuns[begin], surfaceRuns[end], tolerance, chunkPlanes[chunkIndex]);
+			});
+
+			std::vector<uint32_t> firstRegions(chunkCount, 0);
+			for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+			{
+				firstRegions[chunkIndex] = static_cast<uint32_t>(mesh.Planes.size());
+				mesh.Planes.insert(mesh.Planes.end(), chunkPlanes[chunkIndex].begin(), chunkPlanes[chunkIndex].end());
+			}
+
+			ParallelForChunks(runCount, chunkCount, [&](uint32_t chunkIndex, size_t begin, size_t end)
+			{
+				for (uint32_t triangleIndex = surfaceRuns[begin]; triangleIndex < surfaceRuns[end]; triangleIndex++)
+				{
+					if (mesh.Regions[triangleIndex] != NoTriangle)
+						mesh.Regions[triangleIndex] += firstRegions[chunkIndex];
+				}
+			});
+		}
+
+		void BuildVertexIncidence(SimplificationMesh& mesh)
+		{
+			mesh.IncidenceOffsets.assign(mesh.Positions.size() + 1, 0);
+			for (uint32_t triangleIndex = 0; triangleIndex < mesh.Alive.size(); triangleIndex++)
+			{
+				if (mesh.Alive[triangleIndex])
+				{
+					for (uint32_t corner = 0; corner < 3; corner++)
+						mesh.IncidenceOffsets[mesh.Corners[triangleIndex * 3 + corner] + 1]++;
+				}
+			}
+			for (size_t vertex = 1; vertex < mesh.IncidenceOffsets.size(); vertex++)
+				mesh.IncidenceOffsets[vertex] += mesh.IncidenceOffsets[vertex - 1];
+
+			std::vector<uint32_t> cursors(mesh.IncidenceOffsets.begin(), mesh.IncidenceOffsets.end() - 1);
+			mesh.Incidence.resize(mesh.IncidenceOffsets.back());
+			for (uint32_t triangleIndex = 0; triangleIndex < mesh.Alive.size(); triangleIndex++)
+			{
+				if (mesh.Alive[triangleIndex])
+				{
+					for (uint32_t corner = 0; corner < 3; corner++)
+						mesh.Incidence[cursors[mesh.Corners[triangleIndex * 3 + corner]]++] = triangleIndex;
+				}
+			}
+		}
+
+		struct FanNeighbor
+		{
+			uint32_t Vertex = 0;
+			uint32_t EdgeTriangles = 0;
+			uint32_t Region = 0;
+			bool MixedRegions = false;
+		};
+
+		// Per-thread buffers for planning collapses.
+		struct CollapseScratch
+		{
+			std::vector<uint32_t> Fan;
+			std::vector<FanNeighbor> Neighbors;
+			std::vector<uint32_t> OtherFan;
+			std::vector<FanNeighbor> OtherNeighbors;
+		};
+
+		// Collects the live triangles around vertex and the vertices across its edges. Incidence lists are built
+		// once per pass, so triangles removed since then are skipped here.
+		void GatherVertexFan(const SimplificationMesh& mesh, uint32_t vertex, std::vector<uint32_t>& fan, std::vector<FanNeighbor>& neighbors)
+		{
+			fan.clear();
+			neighbors.clear();
+			for (uint32_t incidence = mesh.IncidenceOffsets[vertex]; incidence < mesh.IncidenceOffsets[vertex + 1]; incidence++)
+			{
+				const uint32_t triangleIndex = mesh.Incidence[incidence];
+				if (!mesh.Alive[triangleIndex])
+					continue;
+
+				fan.push_back(triangleIndex);
+				for (uint32_t corner = 0; corner < 3; corner++)
+				{
+					const uint32_t other = mesh.Corners[triangleIndex * 3 + corner];
+					if (other == vertex)
+						continue;
+
+					auto neighbor = std::find_if(neighbors.begin(), neighbors.end(), [other](const FanNeighbor& entry) { return entry.Vertex == other; });
+					if (neighbor == neighbors.end())
+					{
+						neighbors.push_back({ other, 1, mesh.Regions.empty() ? 0 : mesh.Regions[triangleIndex], false });
+						continue;
+					}
+
+					neighbor->EdgeTriangles++;
+					neighbor->MixedRegions = neighbor->MixedRegions || (!mesh.Regions.empty() && neighbor->Region != mesh.Regions[triangleIndex]);
+				}
+			}
+		}
+
+		// Link test for collapsing vertex onto target: the only vertices next to both ends of the edge are the
+		// apexes of the edgeTriangles triangles on it, so the mesh stays manifold. Leaves the target's fan in
+		// the scratch's other buffers.
+		bool PassesLinkTest(const SimplificationMesh& mesh, uint32_t target, uint32_t edgeTriangles, CollapseScratch& scratch)
+		{
+			GatherVertexFan(mesh, target, scratch.OtherFan, scratch.OtherNeighbors);
+			uint32_t commonNeighbors = 0;
+			for (const FanNeighbor& neighbor : scratch.Neighbors)
+			{
+				if (neighbor.Vertex != target &&
+					std::any_of(scratch.OtherNeighbors.begin(), scratch.OtherNeighbors.end(), [&neighbor](const FanNeighbor& other) { return other.Vertex == neighbor.Vertex; }))
+					commonNeighbors++;
+			}
+			return commonNeighbors == edgeTriangles;
+		}
+
+		// The neighbour a sliver edge from vertex should collapse onto, or NoVertex. Every triangle on an edge
+		// shorter than tolerance is thinner than tolerance, so collapsing those edges removes needle slivers
+		// while the triangles around them close over the gap. The shortest valid edge wins, the lowest id on
+		// ties. Open borders only collapse along themselves, and no triangle kept may flip or lose its area.
+		uint32_t FindSliverCollapse(const SimplificationMesh& mesh, uint32_t vertex, float tolerance, CollapseScratch& scratch)
+		{
+			GatherVertexFan(mesh, vertex, scratch.Fan, scratch.Neighbors);
+			bool onBorder = false;
+			for (const FanNeighbor& neighbor : scratch.Neighbors)
+			{
+				if (neighbor.EdgeTriangles > 2)
+					return NoVertex;
+				onBorder = onBorder || neighbor.EdgeTriangles == 1;
+			}
+
+			const glm::vec3 position = mesh.Positions[vertex];
+			uint32_t bestTarget = NoVertex;
+			float bestLengthSquared = 0.0f;
+			for (const FanNeighbor& neighbor : scratch.Neighbors)
+			{
+				const float lengthSquared = glm::length2(mesh.Positions[neighbor.Vertex] - position);
+				if (lengthSquared >= tolerance * tolerance ||
+					(bestTarget != NoVertex && (lengthSquared > bestLengthSquared || (lengthSquared == bestLengthSquared && neighbor.Vertex > bestTarget))))
+					continue;
+
+				bool valid = true;
+				for (uint32_t triangleIndex : scratch.Fan)
+				{
+					const uint32_t* corners = mesh.Corners.data() + static_cast<size_t>(triangleIndex) * 3;
+					if (corners[0] == neighbor.Vertex || corners[1] == neighbor.Vertex || corners[2] == neighbor.Vertex)
+						continue;
+
+					glm::vec3 moved[3];
+					glm::vec3 original[3];
+					for (uint32_t corner = 0; corner < 3; corner++)
+					{
+						original[corner] = mesh.Positions[corners[corner]];
+						moved[corner] = corners[corner] == vertex ? mesh.Positions[neighbor.Vertex] : original[corner];
+					}
+
+					const glm::vec3 movedNormal = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+					const glm::vec3 originalNormal = glm::cross(original[1] - original[0], original[2] - original[0]);
+					if (glm::dot(movedNormal, originalNormal) <= 0.0f)
+					{
+						valid = false;
+						break;
+					}
+				}
+				if (!valid || !PassesLinkTest(mesh, neighbor.Vertex, neighbor.EdgeTriangles, scratch))
+					continue;
+
+				// A border vertex moving inward would open the border, so it only slides along an open edge onto
+				// another border vertex; an inner vertex may always move onto the border.
+				const bool targetOnBorder = std::any_of(scratch.OtherNeighbors.begin(), scratch.OtherNeighbors.end(), [](const FanNeighbor& other) { return other.EdgeTriangles == 1; });
+				if (onBorder && (!targetOnBorder || neighbor.EdgeTriangles != 1))
+					continue;
+
+				bestTarget = neighbor.Vertex;
+				bestLengthSquared = lengthSquared;
+			}
+
+			return bestTarget;
+		}
+
+		// The neighbour vertex can move onto while leaving the surface in place, or NoVertex: inside a planar
+		// region any neighbour may be used, on a straight region border only the two border neighbours. Every
+		// changed triangle must stay in its region's slab, face its region and stay thicker than tolerance, and
+		// the edge must pass the link test so the mesh stays manifold.
+		uint32_t FindPlanarCollapse(const SimplificationMesh& mesh, uint32_t vertex, float tolerance, CollapseScratch& scratch)
+		{
+			std::vector<uint32_t>& fan = scratch.Fan;
+			std::vector<FanNeighbor>& neighbors = scratch.Neighbors;
+			GatherVertexFan(mesh, vertex, fan, neighbors);
+			if (fan.empty())
+				return NoVertex;
+
+			uint32_t borderNeighbors[2] = {};
+			uint32_t borderCount = 0;
+			uint32_t openEdges = 0;
+			for (const FanNeighbor& neighbor : neighbors)
+			{
+				if (neighbor.EdgeTriangles == 2 && !neighbor.MixedRegions)
+					continue;
+				if (neighbor.EdgeTriangles > 2 || borderCount == 2)
+					return NoVertex;
+
+				openEdges += neighbor.EdgeTriangles == 1 ? 1 : 0;
+				borderNeighbors[borderCount++] = neighbor.Vertex;
+			}
+
+			// A closed fan has one neighbour per triangle and an open one a single extra neighbour; anything
+			// else is a pinched or non-manifold vertex. A border vertex must also sit on the line between its
+			// two border neighbours.
+			if (borderCount == 1 || (openEdges != 0 && openEdges != 2) || neighbors.size() != fan.size() + (openEdges == 2 ? 1 : 0))
+				return NoVertex;
+
+			const glm::vec3 position = mesh.Positions[vertex];
+			if (borderCount == 2)
+			{
+				const glm::vec3 start = mesh.Positions[borderNeighbors[0]];
+				const glm::vec3 border = mesh.Positions[borderNeighbors[1]] - start;
+				const float borderLengthSquared = glm::length2(border);
+				const float along = glm::dot(position - start, border);
+				if (borderLengthSquared <= 0.0f || along <= 0.0f || along >= borderLengthSquared ||
+					glm::length2(glm::cross(position - start, border)) > tolerance * tolerance * borderLengthSquared)
+					return NoVertex;
+			}
+
+			const uint32_t candidateCount = borderCount == 2 ? 2 : static_cast<uint32_t>(neighbors.size());
+			for (uint32_t candidateIndex = 0; candidateIndex < candidateCount; candidateIndex++)
+			{
+				const uint32_t target = borderCount == 2 ? borderNeighbors[candidateIndex] : neighbors[candidateIndex].Vertex;
+				uint32_t sharedTriangles = 0;
+				bool valid = true;
+				for (uint32_t triangleIndex : fan)
+				{
+					const uint32_t* corners = mesh.Corners.data() + static_cast<size_t>(triangleIndex) * 3;
+					if (corners[0] == target || corners[1] == target || corners[2] == target)
+					{
+						sharedTriangles++;
+						continue;
+					}
+
+					glm::vec3 moved[3];
+					for (uint32_t corner = 0; corner < 3; corner++)
+						moved[corner] = corners[corner] == vertex ? mesh.Positions[target] : mesh.Positions[corners[corner]];
+
+					const RegionPlane& plane = mesh.Planes[mesh.Regions[triangleIndex]];
+					const glm::vec3 normal = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+					if (!IsInsideRegionSlab(plane, mesh.Positions[target], tolerance) ||
+						glm::dot(normal, plane.Normal) < CoplanarNormalCosine * glm::length(normal) ||
+						GetTriangleThickness(moved[0], moved[1], moved[2]) < tolerance)
+					{
+						valid = false;
+						break;
+					}
+				}
+
+				if (valid && PassesLinkTest(mesh, target, sharedTriangles, scratch))
+					return target;
+			}
+
+			return NoVertex;
+		}
+
+		// Moves vertex onto target. Triangles on the edge between them are left with zero area and removed;
+		// the rest of the fan is renamed. The vertex, its neighbours and target are marked touched, because
+		// their fans or neighbour sets changed and their incidence lists no longer describe them.
+		uint32_t ApplyCollapse(SimplificationMesh& mesh, uint32_t vertex, uint32_t target, CollapseScratch& scratch, std::vector<uint8_t>& touched)
+		{
+			GatherVertexFan(mesh, vertex, scratch.Fan, scratch.Neighbors);
+			uint32_t removedTriangles = 0;
+			for (uint32_t triangleIndex : scratch.Fan)
+			{
+				uint32_t* corners = mesh.Corners.data() + static_cast<size_t>(triangleIndex) * 3;
+				if (corners[0] == target || corners[1] == target || corners[2] == target)
+				{
+					mesh.Alive[triangleIndex] = 0;
+					removedTriangles++;
+					continue;
+				}
+
+				for (uint32_t corner = 0; corner < 3; corner++)
+				{
+					if (corners[corner] == vertex)
+						corners[corner] = target;
+				}
+			}
+
+			touched[vertex] = 1;
+			for (const FanNeighbor& neighbor : scratch.Neighbors)
+				touched[neighbor.Vertex] = 1;
+			return removedTriangles;
+		}
+
+		// Repeats passes until one changes nothing. Each pass plans a collapse for every vertex in parallel
+		// against the mesh as the pass found it, then applies the plans in vertex order, skipping any whose
+		// vertex or target an earlier collapse of the pass touched. A plan that survives saw exactly the mesh
+		// it is applied to, and the order never depends on the thread count. Returns the triangles removed.
+		template <typename FindCollapse>
+		uint32_t RunCollapsePasses(SimplificationMesh& mesh, uint32_t threadCount, FindCollapse&& findCollapse)
+		{
+			const uint32_t vertexCount = static_cast<uint32_t>(mesh.Positions.size());
+			const uint32_t chunkCount = GetParallelChunkCount(vertexCount, MinSimplificationVerticesPerChunk, threadCount);
+			std::vector<uint32_t> targets(vertexCount, NoVertex);
+			std::vector<uint8_t> touched;
+			CollapseScratch scratch;
+			uint32_t removedTriangles = 0;
+			for (uint32_t pass = 0; pass < MaxSimplificationPasses; pass++)
+			{
+				BuildVertexIncidence(mesh);
+				ParallelForChunks(vertexCount, chunkCount, [&](uint32_t, size_t begin, size_t end)
+				{
+					CollapseScratch chunkScratch;
+					for (size_t vertex = begin; vertex < end; vertex++)
+						targets[vertex] = findCollapse(mesh, static_cast<uint32_t>(vertex), chunkScratch);
+				});
+
+				bool changed = false;
+				touched.assign(vertexCount, 0);
+				for (uint32_t vertex = 0; vertex < vertexCount; vertex++)
+				{
+					const uint32_t target = targets[vertex];
+					if (target == NoVertex || touched[vertex] || touched[target])
+						continue;
+
+					removedTriangles += ApplyCollapse(mesh, vertex, target, scratch, touched);
+					changed = true;
+				}
+
+				if (!changed)
+					break;
+			}
+
+			return removedTriangles;
+		}
+
+		// Shrinks the welded mesh of one extraction in place. Edges shorter than tolerance are collapsed first,
+		// so needle slivers close up without leaving holes; a sliver only counts as dropped once the collapse
+		// has left it with zero area. Vertices inside planar regions and on straight region borders are then
+		// collapsed too. Every kept triangle stays within tolerance of its region plane, so the surface moves
+		// by about tolerance at most. Planning runs on worker threads and collapses are applied in vertex id
+		// order, so the result does not depend on the extraction thread count.
+		SimplificationResult SimplifyWeldedTriangles(
+			std::vector<std::vector<WorldTriangle>>& jobTriangles,
+			std::vector<std::vector<uint32_t>>& jobCorners,
+			uint32_t vertexCount,
+			float tolerance,
+			uint32_t threadCount)
+		{
+			SimplificationResult result;
+			SimplificationMesh mesh;
+			mesh.Positions.resize(vertexCount);
+			for (size_t jobIndex = 0; jobIndex < jobTriangles.size(); jobIndex++)
+			{
+				mesh.Corners.insert(mesh.Corners.end(), jobCorners[jobIndex].begin(), jobCorners[jobIndex].end());
+				for (size_t triangleIndex = 0; triangleIndex < jobTriangles[jobIndex].size(); triangleIndex++)
+				{
+					const WorldTriangle& triangle = jobTriangles[jobIndex][triangleIndex];
+					const uint32_t* corners = jobCorners[jobIndex].data() + triangleIndex * 3;
+					mesh.Positions[corners[0]] = triangle.A;
+					mesh.Positions[corners[1]] = triangle.B;
+					mesh.Positions[corners[2]] = triangle.C;
+					mesh.Surfaces.push_back(triangle.SourceSurfaceIndex);
+				}
+			}
+
+			// Triangles whose corners welded together are not counted; compression would drop them anyway.
+			mesh.Alive.assign(mesh.Surfaces.size(), 1);
+			for (uint32_t triangleIndex = 0; triangleIndex < mesh.Alive.size(); triangleIndex++)
+			{
+				const uint32_t* corners = mesh.Corners.data() + static_cast<size_t>(triangleIndex) * 3;
+				if (corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0])
+					mesh.Alive[triangleIndex] = 0;
+			}
+
+			result.SliverTriangles = RunCollapsePasses(mesh, threadCount, [tolerance](const SimplificationMesh& sliverMesh, uint32_t vertex, CollapseScratch& scratch)
+			{
+				return FindSliverCollapse(sliverMesh, vertex, tolerance, scratch);
+			});
+
+			BuildPlanarRegions(mesh, tolerance, threadCount);
+			result.MergedTriangles = RunCollapsePasses(mesh, threadCount, [tolerance](const SimplificationMesh& planarMesh, uint32_t vertex, CollapseScratch& scratch)
+			{
+				return FindPlanarCollapse(planarMesh, vertex, tolerance, scratch);
+			});
+
+			size_t flatIndex = 0;
+			for (size_t jobIndex = 0; jobIndex < jobTriangles.size(); jobIndex++)
+			{
+				std::vector<WorldTriangle>& triangles = jobTriangles[jobIndex];
+				std::vector<uint32_t>& corners = jobCorners[jobIndex];
+				size_t keptCount = 0;
+				for (size_t triangleIndex = 0; triangleIndex < triangles.size(); triangleIndex++, flatIndex++)
+				{
+					if (!mesh.Alive[flatIndex])
+						continue;
+
+					const uint32_t* simplifiedCorners = mesh.Corners.data() + flatIndex * 3;
+
+					WorldTriangle triangle = triangles[triangleIndex];
+					triangle.A = mesh.Positions[simplifiedCorners[0]];
+					triangle.B = mesh.Positions[simplifiedCorners[1]];
+					triangle.C = mesh.Positions[simplifiedCorners[2]];
+					triangle.Normal = glm::normalize(glm::cross(triangle.B - triangle.A, triangle.C - triangle.A));
+					triangle.Bounds = CalculateTriangleBounds(triangle.A, triangle.B, triangle.C);
+					triangles[keptCount] = triangle;
+					std::copy(simplifiedCorners, simplifiedCorners + 3, corners.begin() + keptCount * 3);
+					keptCount++;
+				}
+				triangles.resize(keptCount);
+				corners.resize(keptCount * 3);
+			}
+
+			return result;
+		}
+	}
+
+	StaticWorld::StaticWorld(const std::string& sourceName, const StaticWorldSettings& settings)
+		: m_SourceName(sourceName), m_Settings(settings)
+	{
+	}
+
+	void StaticWorld::AddModel(const Ref<Model>& model, const WorldTransform& transform)
+	{
+		AppendModel(model, transform);
+		Finalize();
+	}
+
+	void StaticWorld::AddModels(const std::vector<WorldModelPlacement>& models)
+	{
+		for (const WorldModelPlacement& placement : models)
+			AppendModel(placement.ModelAsset, placement.Transform);
+	}
+
+	void StaticWorld::Finalize()
+	{
+		if (!HasPendingGeometry())
+			return;
+
+		UpdateAccelerationStructure();
+	}
+
+	void StaticWorld::AppendModel(const Ref<Model>& model, const WorldTransform& transform)
+	{
+		ExtractCollisionTriangles(AppendSurfaces(model, transform));
+	}
+
+	uint32_t StaticWorld::AppendSurfaces(const Ref<Model>& model, const WorldTransform& transform)
+	{
+		FT_CORE_ASSERT(model, "StaticWorld requires a model!");
+
+		if (m_SourceName.empty())
+			m_SourceName = model->GetSourcePath();
+		m_Transform = transform;
+
+		const uint32_t firstSurface = static_cast<uint32_t>(m_Surfaces.size());
+		const std::vector<ModelSubmesh>& submeshes = model->GetSubmeshes();
+		for (size_t i = 0; i < submeshes.size(); i++)
+		{
+			const ModelSubmesh& submesh = submeshes[i];
+			WorldMaterialRef materialRef;
+			materialRef.Name = submesh.Name;
+			materialRef.MaterialAsset = submesh.MaterialAsset;
+			materialRef.SourceMaterialIndex = submesh.MaterialIndex;
+			const uint32_t materialIndex = static_cast<uint32_t>(m_Materials.size());
+			m_Materials.push_back(materialRef);
+
+			WorldSurface surface;
+			surface.Name = submesh.Name;
+			surface.SourceModelPath = model->GetSourcePath();
+			surface.SourceSubmeshIndex = static_cast<uint32_t>(i);
+			surface.MaterialIndex = materialIndex;
+			surface.MeshAsset = submesh.MeshAsset;
+			surface.Transform = transform;
+			surface.LocalBounds = submesh.LocalBounds.IsValid ? submesh.LocalBounds : submesh.MeshAsset->GetLocalBounds();
+			surface.WorldBounds = TransformBounds(surface.LocalBounds, transform.Matrix);
+
+			Encapsulate(m_LocalBounds, surface.LocalBounds);
+			Encapsulate(m_WorldBounds, surface.WorldBounds);
+			m_Surfaces.push_back(surface);
+			m_SurfaceBounds.Push(surface.WorldBounds);
+		}
+
+		return firstSurface;
+	}
+
+	void StaticWorld::SetBroadPhase(WorldBroadPhase broadPhase)
+	{
+		if (m_Settings.BroadPhase == broadPhase)
+			return;
+
+		m_Settings.BroadPhase = broadPhase;
+		if (!m_Surfaces.empty())
+			BuildAccelerationStructure();
+	}
+
+	void StaticWorld::ExtractCollisionTriangles(uint32_t firstSurface)
+	{
+		struct ExtractionJob
+		{
+			uint32_t SurfaceIndex = 0;
+			size_t FirstIndex = 0;
+			size_t LastIndex = 0;
+		};
+
+		// Large surfaces are split into fixed index ranges so a single huge submesh still spreads across threads.
+		std::vector<ExtractionJob> jobs;
+		for (uint32_t surfaceIndex = firstSurface; surfaceIndex < m_Surfaces.size(); surfaceIndex++)
+		{
+			const WorldSurface& surface = m_Surfaces[surfaceIndex];
+			if (!surface.MeshAsset || surface.MeshAsset->GetVertices().empty())
+				continue;
+
+			const size_t indexCount = surface.MeshAsset->GetIndices().size();
+			for (size_t firstIndex = 0; firstIndex + 2 < indexCount; firstIndex += ExtractionJobIndices)
+				jobs.push_back({ surfaceIndex, firstIndex, std::min(firstIndex + ExtractionJobIndices, indexCount) });
+		}
+
+		std::vector<std::vector<WorldTriangle>> jobTriangles(jobs.size());
+		const uint32_t chunkCount = GetParallelChunkCount(jobs.size(), 1, m_Settings.BuildThreadCount);
+		ParallelForChunks(jobs.size(), chunkCount, [&](uint32_t, size_t begin, size_t end)
+		{
+			for (size_t jobIndex = begin; jobIndex < end; jobIndex++)
+			{
+				const ExtractionJob& job = jobs[jobIndex];
+				ExtractSurfaceTriangles(m_Surfaces[job.SurfaceIndex], job.SurfaceIndex, job.FirstIndex, job.LastIndex, jobTriangles[jobIndex]);
+			}
+		});
+
+		for (const std::vector<WorldTriangle>& triangles : jobTriangles)
+			m_SourceTriangleCount += static_cast<uint32_t>(triangles.size());
+
+		std::vector<std::vector<uint32_t>> jobCorners(jobs.size());
+		const uint32_t weldedVertexCount = WeldTriangleCorners(jobTriangles, m_Settings.WeldTolerance, m_Settings.BuildThreadCount, jobCorners);
+		if (m_Settings.SimplifyTolerance > 0.0f)
+		{
+			const SimplificationResult simplification = SimplifyWeldedTriangles(jobTriangles, jobCorners, weldedVertexCount, m_Settings.SimplifyTolerance, m_Settings.BuildThreadCount);
+			m_MergedTriangleCount += simplification.MergedTriangles;
+			m_SliverTriangleCount += simplification.SliverTriangles;
+		}
+
+		std::vector<TriangleBlockPlan> plans(jobs.size());
+		ParallelForChunks(jobs.size(), chunkCount, [&](uint32_t, size_t begin, size_t end)
+		{
+			for (size_t jobIndex = begin; jobIndex < end; jobIndex++)
+				PlanSurfaceBlocks(jobTriangles[jobIndex], jobCorners[jobIndex], plans[jobIndex]);
+		});
+
+		// A welded vertex sits on the lattice of the coarsest block that uses it, so it decodes to the same
+		// point in every block and shared edges stay closed. Snapping can widen a block past its own lattice,
+		// so vertex and block steps are raised together until neither changes; steps only double, so this ends.
+		// Welded ids are only shared within one extraction, as are the lattices fitted to them.
+		std::vector<glm::vec3> vertexSteps(weldedVertexCount, glm::vec3(0.0f));
+		std::vector<uint8_t> jobStepsGrew(jobs.size(), 1);
+		while (std::find(jobStepsGrew.begin(), jobStepsGrew.end(), 1) != jobStepsGrew.end())
+		{
+			for (size_t jobIndex = 0; jobIndex < jobs.size(); jobIndex++)
+				RaiseVertexSteps(jobCorners[jobIndex], plans[jobIndex], vertexSteps);
+
+			ParallelForChunks(jobs.size(), chunkCount, [&](uint32_t, size_t begin, size_t end)
+			{
+				for (size_t jobIndex = begin; jobIndex < end; jobIndex++)
+					jobStepsGrew[jobIndex] = FitBlockSteps(jobTriangles[jobIndex], jobCorners[jobIndex], vertexSteps, plans[jobIndex]) ? 1 : 0;
+			});
+		}
+
+		std::vector<CompressedTriangles> jobOutputs(jobs.size());
+		ParallelForChunks(jobs.size(), chunkCount, [&](uint32_t, size_t begin, size_t end)
+		{
+			std::vector<uint32_t> localVertices(weldedVertexCount, NoVertex);
+			for (size_t jobIndex = begin; jobIndex < end; jobIndex++)
+			{
+				CompressSurfaceTriangles(jobTriangles[jobIndex], jobCorners[jobIndex], plans[jobIndex], vertexSteps, jobs[jobIndex].SurfaceIndex, localVertices, jobOutputs[jobIndex]);
+				std::vector<uint32_t>().swap(plans[jobIndex].Order);
+				std::vector<WorldTriangle>().swap(jobTriangles[jobIndex]);
+			}
+		});
+
+		// Appending in job order keeps triangle, vertex and block indices identical to a single-threaded extraction.
+		const uint32_t firstTriangle = static_cast<uint32_t>(m_CollisionTriangles.size());
+		size_t triangleCount = m_CollisionTriangles.size();
+		size_t vertexCount = m_CollisionVertices.size();
+		size_t blockCount = m_CollisionTriangleBlocks.size();
+		for (const CompressedTriangles& output : jobOutputs)
+		{
+			triangleCount += output.Triangles.size();
+			vertexCount += output.Vertices.size();
+			blockCount += output.Blocks.size();
+		}
+
+		m_CollisionTriangles.reserve(triangleCount);
+		m_CollisionVertices.reserve(vertexCount);
+		m_CollisionTriangleBlocks.reserve(blockCount);
+		for (const CompressedTriangles& output : jobOutputs)
+		{
+			const uint32_t firstVertex = static_cast<uint32_t>(m_CollisionVertices.size());
+			const uint32_t firstBlock = static_cast<uint32_t>(m_CollisionTriangleBlocks.size());
+			for (CompactWorldTriangle triangle : output.Triangles)
+			{
+				for (uint32_t& index : triangle.Indices)
+					index += firstVertex;
+				triangle.BlockIndex += firstBlock;
+				m_CollisionTriangles.push_back(triangle);
+			}
+			m_CollisionVertices.insert(m_CollisionVertices.end(), output.Vertices.begin(), output.Vertices.end());
+			m_CollisionTriangleBlocks.insert(m_CollisionTriangleBlocks.end(), output.Blocks.begin(), output.Blocks.end());
+		}
+
+		// Welded ids are only shared within one extraction, so triangles from separate AddModels calls are never linked.
+		if (m_Settings.BuildEdgeAdjacency)
+		{
+			std::vector<uint32_t> weldedCorners;
+			weldedCorners.reserve((triangleCount - firstTriangle) * 3);
+			for (const CompressedTriangles& output : jobOutputs)
+				weldedCorners.insert(weldedCorners.end(), output.WeldedCorners.begin(), output.WeldedCorners.end());
+			BuildTriangleAdjacency(weldedCorners, firstTriangle, m_CollisionTriangleAdjacency);
+		}
+	}
+
+	WorldTriangle StaticWorld::GetCollisionTriangle(uint32_t triangleIndex) const
+	{
+		WorldTriangle triangle;
+		DecodeTriangleCorners(triangleIndex, triangle);
+		triangle.Normal = glm::normalize(glm::cross(triangle.B - triangle.A, triangle.C - triangle.A));
+		triangle.Bounds = CalculateTriangleBounds(triangle.A, triangle.B, triangle.C);
+		triangle.SourceSurfaceIndex = GetTriangleSurface(triangleIndex);
+		return triangle;
+	}
+
+	void StaticWorld::DecodeTriangleCorners(uint32_t triangleIndex, WorldTriangle& triangle) const
+	{
+		const CompactWorldTriangle& compactTriangle = m_CollisionTriangles[triangleIndex];
+		DecodeCompactTriangle(compactTriangle, m_CollisionTriangleBlocks[compactTriangle.BlockIndex], m_CollisionVertices, triangle.A, triangle.B, triangle.C);
+	}
+
+	void StaticWorld::GetCollisionTriangleCorners(uint32_t triangleIndex, glm::vec3& a, glm::vec3& b, glm::vec3& c) const
+	{
+		const CompactWorldTriangle& compactTriangle = m_CollisionTriangles[triangleIndex];
+		DecodeCompactTriangle(compactTriangle, m_CollisionTriangleBlocks[compactTriangle.BlockIndex], m_CollisionVertices, a, b, c);
+	}
+
+	WorldTriangleBounds StaticWorld::DecodeTriangleBounds(uint32_t triangleIndex) const
+	{
+		const CompactWorldTriangle& compactTriangle = m_CollisionTriangles[triangleIndex];
+		glm::vec3 a;
+		glm::vec3 b;
+		glm::vec3 c;
+		DecodeCompactTriangle(compactTriangle, m_CollisionTriangleBlocks[compactTriangle.BlockIndex], m_CollisionVertices, a, b, c);
+		const glm::vec3 minimum = glm::min(a, glm::min(b, c));
+		const glm::vec3 maximum = glm::max(a, glm::max(b, c));
+		return { minimum.x, minimum.y, minimum.z, maximum.x, maximum.y, maximum.z };
+	}
+
+	void StaticWorld::UpdateCollisionMemoryStats()
+	{
+		m_AccelerationStats.CollisionVertices = static_cast<uint32_t>(m_CollisionVertices.size());
+		m_AccelerationStats.CollisionMemoryBytes =
+			m_CollisionVertices.size() * sizeof(CompactWorldVertex) +
+			m_CollisionTriangles.size() * sizeof(CompactWorldTriangle) +
+			m_CollisionTriangleBlocks.size() * sizeof(CollisionTriangleBlock) +
+			m_CollisionTriangleAdjacency.size() * sizeof(WorldTriangleAdjacency);
+		m_AccelerationStats.UncompressedCollisionMemoryBytes = m_CollisionTriangles.size() * (sizeof(WorldTriangle) + sizeof(WorldTriangleBounds));
+	}
+
+	void StaticWorld::UpdateCollisionErrorBound()
+	{
+		// Snapping to the coarsest lattice of the blocks sharing a corner moves it at most half of that
+		// block's step on each axis.
+		float quantizationError = 0.0f;
+		for (const CollisionTriangleBlock& block : m_CollisionTriangleBlocks)
+			quantizationError = std::max(quantizationError, 0.5f * glm::length(glm::vec3(block.StepX, block.StepY, block.StepZ)));
+
+		// Welding snaps a corner across at most one cell diagonal, then at most one tolerance to a neighbour.
+		const float weldError = (std::sqrt(3.0f) + 1.0f) * m_Settings.WeldTolerance;
+		m_CollisionErrorBound = quantizationError + weldError + m_Settings.SimplifyTolerance;
+	}
+
+	void StaticWorld::BuildAccelerationStructure()
+	{
+		ResetQueryScratch();
+		for (PackedSpatialGrid& grid : m_SpatialGridLevels)
+			grid.Clear();
+		m_SpatialGridLevelMask = 0;
+		m_SpatialGridCellSize = 0.0f;
+		m_CollisionBVH.Clear();
+		m_IndexedSurfaceCount = 0;
+		m_IndexedTriangleCount = 0;
+		m_AccelerationStats = {};
+		UpdateAccelerationStructure();
+	}
+
+	void StaticWorld::UpdateAccelerationStructure()
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		m_AccelerationStats.BroadPhase = m_Settings.BroadPhase;
+		m_AccelerationStats.IndexedSurfaces = static_cast<uint32_t>(m_Surfaces.size());
+		m_AccelerationStats.IndexedTriangles = static_cast<uint32_t>(m_CollisionTriangles.size());
+		m_AccelerationStats.SourceTriangles = m_SourceTriangleCount;
+		m_AccelerationStats.MergedTriangles = m_MergedTriangleCount;
+		m_AccelerationStats.SliverTriangles = m_SliverTriangleCount;
+		UpdateCollisionMemoryStats();
+		UpdateCollisionErrorBound();
+
+		// The grid only inserts the new triangles. SAH splits depend on every primitive, so the BVH is rebuilt.
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+		{
+			BuildBoundingVolumeHierarchy();
+		}
+		else if (m_SpatialGridCellSize > 0.0f && !GridCellKeysCoverBounds(m_WorldBounds, m_SpatialGridCellSize))
+		{
+			// A streamed chunk reached past the cell keys the base cell size can address, so the whole grid is
+			// rebuilt on a base sized for the new bounds.
+			FT_CORE_WARN("Static world '{0}' grew past its {1:.4g} unit grid cells; rebuilding the grid.", m_SourceName, m_SpatialGridCellSize);
+			for (PackedSpatialGrid& grid : m_SpatialGridLevels)
+				grid.Clear();
+			m_SpatialGridLevelMask = 0;
+			m_SpatialGridCellSize = 0.0f;
+			BuildSpatialGrid(0);
+		}
+		else
+		{
+			BuildSpatialGrid(m_IndexedTriangleCount);
+		}
+
+		const uint32_t firstSurface = m_IndexedSurfaceCount;
+		const uint32_t firstTriangle = m_IndexedTriangleCount;
+		m_IndexedSurfaceCount = static_cast<uint32_t>(m_Surfaces.size());
+		m_IndexedTriangleCount = static_cast<uint32_t>(m_CollisionTriangles.size());
+		m_SpatialGridVersion = NextSpatialGridVersion();
+		UpdateSurfaceTriangleRanges(firstSurface, firstTriangle);
+
+		const auto endTime = std::chrono::steady_clock::now();
+		m_AccelerationStats.BuildTimeMs += std::chrono::duration<float, std::milli>(endTime - startTime).count();
+
+		// Splits depend on every triangle, so recompiling after each streamed chunk would redo the whole
+		// tree every time. New triangles only leave it stale until UpdateBsp or the next BSP query.
+		UpdateBspStats();
+	}
+
+	void StaticWorld::BuildBsp()
+	{
+		std::lock_guard<std::mutex> lock(m_BspMutex);
+		CompileBsp();
+		UpdateBspStats();
+	}
+
+	void StaticWorld::UpdateBsp()
+	{
+		std::lock_guard<std::mutex> lock(m_BspMutex);
+		if (IsBspStale())
+			CompileBsp();
+		UpdateBspStats();
+	}
+
+	const BspTree& StaticWorld::GetBsp() const
+	{
+		EnsureBspCompiled();
+		return m_Bsp;
+	}
+
+	bool StaticWorld::IsBspStale() const
+	{
+		return (m_Settings.BuildBsp || !m_Bsp.IsEmpty()) && m_BspTriangleCount != m_IndexedTriangleCount;
+	}
+
+	void StaticWorld::EnsureBspCompiled() const
+	{
+		std::lock_guard<std::mutex> lock(m_BspMutex);
+		if (IsBspStale())
+			CompileBsp();
+	}
+
+	void StaticWorld::CompileBsp() const
+	{
+		std::vector<glm::vec3> corners(static_cast<size_t>(m_IndexedTriangleCount) * 3);
+		for (uint32_t triangleIndex = 0; triangleIndex < m_IndexedTriangleCount; triangleIndex++)
+			GetCollisionTriangleCorners(triangleIndex, corners[triangleIndex * 3], corners[triangleIndex * 3 + 1], corners[triangleIndex * 3 + 2]);
+
+		m_Bsp.Build(corners, m_Settings.Bsp);
+		m_BspTriangleCount = m_IndexedTriangleCount;
+		m_BspLoadedFromCache = false;
+
+		const BspBuildStats& bspStats = m_Bsp.GetStats();
+		FT_CORE_INFO(
+			"Built static world BSP for '{0}': {1} collision triangles, {2} nodes, {3} leaves ({4} solid), depth {5}, {6} split fragments in {7:.2f} ms.",
+			m_SourceName,
+			m_IndexedTriangleCount,
+			bspStats.NodeCount,
+			bspStats.LeafCount,
+			bspStats.SolidLeafCount,
+			bspStats.MaxDepth,
+			bspStats.SplitFragments,
+			bspStats.BuildTimeMs
+		);
+		if (bspStats.DepthLimitedLeaves > 0)
+		{
+			FT_CORE_WARN(
+				"Static world BSP for '{0}' closed {1} leaves at depth {2} with planes left unsplit; they read as empty space.",
+				m_SourceName,
+				bspStats.DepthLimitedLeaves,
+				std::min(m_Settings.Bsp.MaxDepth, BspTree::MaxTreeDepth)
+			);
+		}
+	}
+
+	void StaticWorld::UpdateBspStats()
+	{
+		const BspBuildStats& bspStats = m_Bsp.GetStats();
+		m_AccelerationStats.BspNodes = bspStats.NodeCount;
+		m_AccelerationStats.BspLeaves = bspStats.LeafCount;
+		m_AccelerationStats.BspSolidLeaves = bspStats.SolidLeafCount;
+		m_AccelerationStats.BspMaxDepth = bspStats.MaxDepth;
+		m_AccelerationStats.BspBuildTimeMs = bspStats.BuildTimeMs;
+		m_AccelerationStats.BspLoadedFromCache = m_BspLoadedFromCache;
+	}
+
+	void StaticWorld::UpdateSurfaceTriangleRanges(uint32_t firstSurface, uint32_t firstTriangle)
+	{
+		// Triangles are extracted with the surfaces they come from, so triangles from firstTriangle on only
+		// ever belong to surfaces from firstSurface on and the earlier ranges stay as they are.
+		m_SurfaceTriangleRanges.resize(firstSurface);
+		m_SurfaceTriangleRanges.resize(m_Surfaces.size());
+		m_UncoveredSurfaces.erase(std::lower_bound(m_UncoveredSurfaces.begin(), m_UncoveredSurfaces.end(), firstSurface), m_UncoveredSurfaces.end());
+		for (uint32_t triangleIndex = firstTriangle; triangleIndex < m_CollisionTriangles.size(); triangleIndex++)
+		{
+			const uint32_t surfaceIndex = GetTriangleSurface(triangleIndex);
+			if (surfaceIndex >= m_SurfaceTriangleRanges.size())
+				continue;
+
+			SurfaceTriangleRange& range = m_SurfaceTriangleRanges[surfaceIndex];
+			if (range.TriangleCount == 0)
+				range.FirstTriangle = triangleIndex;
+			range.TriangleCount = triangleIndex - range.FirstTriangle + 1;
+		}
+
+		for (uint32_t surfaceIndex = firstSurface; surfaceIndex < m_IndexedSurfaceCount; surfaceIndex++)
+		{
+			if (m_SurfaceTriangleRanges[surfaceIndex].TriangleCount == 0)
+				m_UncoveredSurfaces.push_back(surfaceIndex);
+		}
+	}
+
+	void StaticWorld::ResetQueryScratch()
+	{
+		m_DefaultQueryContext = {};
+		m_DefaultQueryContext.CollisionMarks.assign(m_CollisionTriangles.size(), 0);
+		m_DefaultQueryContext.SurfaceMarks.assign(m_Surfaces.size(), 0);
+		m_DefaultQueryContext.CollisionCandidates.reserve(512);
+	}
+
+	uint32_t StaticWorld::BeginCollisionQuery(WorldQueryContext& context) const
+	{
+		// Contexts may be shared between worlds, so grow the marks to this world's triangle count.
+		if (context.CollisionMarks.size() < m_CollisionTriangles.size())
+			context.CollisionMarks.resize(m_CollisionTriangles.size(), 0);
+
+		if (++context.CollisionStamp == 0)
+		{
+			std::fill(context.CollisionMarks.begin(), context.CollisionMarks.end(), 0);
+			context.CollisionStamp = 1;
+		}
+
+		return context.CollisionStamp;
+	}
+
+	uint32_t StaticWorld::BeginSurfaceQuery(WorldQueryContext& context) const
+	{
+		if (context.SurfaceMarks.size() < m_Surfaces.size())
+			context.SurfaceMarks.resize(m_Surfaces.size(), 0);
+
+		if (++context.SurfaceStamp == 0)
+		{
+			std::fill(context.SurfaceMarks.begin(), context.SurfaceMarks.end(), 0);
+			context.SurfaceStamp = 1;
+		}
+
+		return context.SurfaceStamp;
+	}
+
+	void StaticWorld::BeginFrustumQuery(WorldQueryContext& context) const
+	{
+		if (context.SurfaceMarks.size() < m_Surfaces.size())
+			context.SurfaceMarks.resize(m_Surfaces.size(), 0);
+
+		// Frustum queries take two stamps; other surface queries keep counting on from the second.
+		if (context.SurfaceStamp >= std::numeric_limits<uint32_t>::max() - 1)
+		{
+			std::fill(context.SurfaceMarks.begin(), context.SurfaceMarks.end(), 0);
+			context.SurfaceStamp = 0;
+		}
+
+		context.FrustumAcceptStamp = ++context.SurfaceStamp;
+		context.FrustumTestStamp = ++context.SurfaceStamp;
+	}
+
+	void StaticWorld::ChooseSpatialGridCellSize(uint32_t firstTriangle)
+	{
+		const float minimumCellSize = GetMinimumGridCellSize(m_WorldBounds);
+		if (m_Settings.GridCellSize > 0.0f)
+		{
+			m_SpatialGridCellSize = std::max(m_Settings.GridCellSize, minimumCellSize);
+			if (m_SpatialGridCellSize > m_Settings.GridCellSize)
+				FT_CORE_WARN("Static world '{0}' is too large for a {1:.4g} unit grid cell; using {2:.4g}.", m_SourceName, m_Settings.GridCellSize, m_SpatialGridCellSize);
+			return;
+		}
+
+		// The median longest axis puts a typical triangle in one to eight base cells whatever units the
+		// scene was authored in. A stride sample is plenty for a median and keeps huge meshes cheap.
+		const size_t triangleCount = m_CollisionTriangles.size() - firstTriangle;
+		const size_t sampleStride = std::max<size_t>(triangleCount / MaxCellSizeSamples, 1);
+		std::vector<float> extents;
+		extents.reserve(std::min(triangleCount, MaxCellSizeSamples + 1));
+		for (size_t triangleIndex = firstTriangle; triangleIndex < m_CollisionTriangles.size(); triangleIndex += sampleStride)
+		{
+			const WorldTriangleBounds bounds = DecodeTriangleBounds(static_cast<uint32_t>(triangleIndex));
+			const glm::vec3 extent(bounds.MaxX - bounds.MinX, bounds.MaxY - bounds.MinY, bounds.MaxZ - bounds.MinZ);
+			extents.push_back(std::max(extent.x, std::max(extent.y, extent.z)));
+		}
+
+		const auto median = extents.begin() + extents.size() / 2;
+		std::nth_element(extents.begin(), median, extents.end());
+		m_SpatialGridCellSize = std::max(*median, minimumCellSize);
+	}
+
+	float StaticWorld::GetSpatialGridLevelCellSize(uint32_t level) const
+	{
+		return m_SpatialGridCellSize * static_cast<float>(1u << level);
+	}
+
+	uint32_t StaticWorld::SelectSpatialGridLevel(const AxisAlignedBounds& bounds) const
+	{
+		const glm::vec3 extent = bounds.Max - bounds.Min;
+		const float longestAxis = std::max(extent.x, std::max(extent.y, extent.z));
+		uint32_t level = 0;
+		while (level + 1 < MaxSpatialGridLevels && GetSpatialGridLevelCellSize(level) < longestAxis)
+			level++;
+
+		return level;
+	}
+
+	void StaticWorld::BuildSpatialGrid(uint32_t firstTriangle)
+	{
+		if (firstTriangle >= m_CollisionTriangles.size())
+		{
+			m_AccelerationStats.CellSize = m_SpatialGridCellSize;
+			return;
+		}
+
+		const auto startTime = std::chrono::steady_clock::now();
+		if (m_SpatialGridCellSize <= 0.0f)
+			ChooseSpatialGridCellSize(firstTriangle);
+
+		const size_t newTriangleCount = m_CollisionTriangles.size() - firstTriangle;
+		const uint32_t chunkCount = GetParallelChunkCount(newTriangleCount, MinGridTrianglesPerChunk, m_Settings.BuildThreadCount);
+		const uint32_t partitionCount = chunkCount;
+		auto binIndex = [partitionCount](uint32_t chunkIndex, uint32_t level, uint32_t partitionIndex)
+		{
+			return (static_cast<size_t>(chunkIndex) * MaxSpatialGridLevels + level) * partitionCount + partitionIndex;
+		};
+
+		// Pass 1: each chunk of triangles sorts its cell entries into bins by level and by the partition that owns the cell.
+		std::vector<std::vector<SpatialGridEntry>> bins(static_cast<size_t>(chunkCount) * MaxSpatialGridLevels * partitionCount);
+		std::vector<uint32_t> chunkLevelMasks(chunkCount, 0);
+		ParallelForChunks(newTriangleCount, chunkCount, [&](uint32_t chunkIndex, size_t begin, size_t end)
+		{
+			for (size_t triangleIndex = firstTriangle + begin; triangleIndex < firstTriangle + end; triangleIndex++)
+			{
+				const AxisAlignedBounds triangleBounds = ToAxisAlignedBounds(DecodeTriangleBounds(static_cast<uint32_t>(triangleIndex)));
+				const uint32_t surfaceIndex = GetTriangleSurface(static_cast<uint32_t>(triangleIndex));
+				const uint32_t level = SelectSpatialGridLevel(triangleBounds);
+				const float cellSize = GetSpatialGridLevelCellSize(level);
+				const GridCoord minCoord = ToGridCoord(triangleBounds.Min, cellSize);
+				const GridCoord maxCoord = ToGridCoord(triangleBounds.Max, cellSize);
+				chunkLevelMasks[chunkIndex] |= 1u << level;
+
+				for (int32_t z = minCoord.Z; z <= maxCoord.Z; z++)
+				{
+					for (int32_t y = minCoord.Y; y <= maxCoord.Y; y++)
+					{
+						for (int32_t x = minCoord.X; x <= maxCoord.X; x++)
+						{
+							const uint64_t cellKey = GridCellKey({ x, y, z });
+							bins[binIndex(chunkIndex, level, GetGridPartition(cellKey, partitionCount))].push_back(
+								{ cellKey, static_cast<uint32_t>(triangleIndex), surfaceIndex });
+						}
+					}
+				}
+			}
+		});
+
+		uint32_t newLevelMask = 0;
+		for (uint32_t levelMask : chunkLevelMasks)
+			newLevelMask |= levelMask;
+
+		// Pass 2: each partition gathers its bins in chunk order, which is triangle order, and packs one grid per level.
+		// Every cell therefore lists its triangles and surfaces exactly as a single-threaded build would.
+		std::vector<PackedSpatialGrid> partitions(static_cast<size_t>(MaxSpatialGridLevels) * partitionCount);
+		ParallelForChunks(partitionCount, partitionCount, [&](uint32_t, size_t begin, size_t end)
+		{
+			for (uint32_t partitionIndex = static_cast<uint32_t>(begin); partitionIndex < end; partitionIndex++)
+			{
+				for (uint32_t level = 0; level < MaxSpatialGridLevels; level++)
+				{
+					if ((newLevelMask & (1u << level)) == 0)
+						continue;
+
+					PackedSpatialGrid& partition = partitions[static_cast<size_t>(level) * partitionCount + partitionIndex];
+					if (chunkCount == 1)
+					{
+						partition.Build(bins[binIndex(0, level, partitionIndex)]);
+						continue;
+					}
+
+					std::vector<SpatialGridEntry> entries;
+					for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+					{
+						std::vector<SpatialGridEntry>& bin = bins[binIndex(chunkIndex, level, partitionIndex)];
+						entries.insert(entries.end(), bin.begin(), bin.end());
+						std::vector<SpatialGridEntry>().swap(bin);
+					}
+
+					partition.Build(entries);
+				}
+			}
+		});
+
+		// Pass 3: merge the partitions of each level with any cells indexed by earlier models. New triangle
+		// indices are larger than every indexed one, so appending them keeps each existing cell sorted.
+		for (uint32_t level = 0; level < MaxSpatialGridLevels; level++)
+		{
+			if ((newLevelMask & (1u << level)) == 0)
+				continue;
+
+			PackedSpatialGrid& grid = m_SpatialGridLevels[level];
+			PackedSpatialGrid* levelPartitions = partitions.data() + static_cast<size_t>(level) * partitionCount;
+			if (partitionCount == 1 && grid.IsEmpty())
+			{
+				grid = std::move(levelPartitions[0]);
+				continue;
+			}
+
+			std::vector<const PackedSpatialGrid*> additions;
+			for (uint32_t partitionIndex = 0; partitionIndex < partitionCount; partitionIndex++)
+				additions.push_back(&levelPartitions[partitionIndex]);
+			grid.Merge(additions);
+		}
+		m_SpatialGridLevelMask |= newLevelMask;
+		UpdateSpatialGridStats();
+
+		const auto endTime = std::chrono::steady_clock::now();
+		FT_CORE_INFO(
+			"Built static world grid for '{0}': {1} surfaces, {2} collision triangles ({3} new), {4} occupied cells on {5} levels from {6:.4g} units in {7:.2f} ms ({8} build chunks), {9:.1f} KB packed vs {10:.1f} KB hashed.",
+			m_SourceName,
+			m_Surfaces.size(),
+			m_CollisionTriangles.size(),
+			newTriangleCount,
+			m_AccelerationStats.OccupiedCells,
+			m_AccelerationStats.GridLevels,
+			m_SpatialGridCellSize,
+			std::chrono::duration<float, std::milli>(endTime - startTime).count(),
+			chunkCount,
+			static_cast<float>(m_AccelerationStats.GridMemoryBytes) / 1024.0f,
+			static_cast<float>(m_AccelerationStats.UnpackedGridMemoryBytes) / 1024.0f
+		);
+	}
+
+	void StaticWorld::UpdateSpatialGridStats()
+	{
+		m_AccelerationStats.CellSize = m_SpatialGridCellSize;
+		m_AccelerationStats.GridLevels = static_cast<uint32_t>(std::popcount(m_SpatialGridLevelMask));
+		m_AccelerationStats.OccupiedCells = 0;
+		m_AccelerationStats.GridMemoryBytes = 0;
+		m_AccelerationStats.UnpackedGridMemoryBytes = 0;
+		for (const PackedSpatialGrid& grid : m_SpatialGridLevels)
+		{
+			m_AccelerationStats.OccupiedCells += grid.GetCellCount();
+			m_AccelerationStats.GridMemoryBytes += grid.GetMemoryBytes();
+			m_AccelerationStats.UnpackedGridMemoryBytes += grid.EstimateHashMapBytes();
+		}
+	}
+
+	void StaticWorld::BuildBoundingVolumeHierarchy()
+	{
+		if (m_CollisionTriangles.empty())
+			return;
+
+		std::vector<AxisAlignedBounds> triangleBounds;
+		triangleBounds.reserve(m_CollisionTriangles.size());
+		for (uint32_t triangleIndex = 0; triangleIndex < m_CollisionTriangles.size(); triangleIndex++)
+			triangleBounds.push_back(ToAxisAlignedBounds(DecodeTriangleBounds(triangleIndex)));
+
+		m_CollisionBVH.Build(triangleBounds);
+
+		UpdateBVHStats();
+		const BVHBuildStats& bvhStats = m_CollisionBVH.GetStats();
+
+		FT_CORE_INFO(
+			"Built static world BVH for '{0}': {1} surfaces, {2} collision triangles, {3} nodes, {4} leaves, depth {5} in {6:.2f} ms.",
+			m_SourceName,
+			m_Surfaces.size(),
+			m_CollisionTriangles.size(),
+			bvhStats.NodeCount,
+			bvhStats.LeafCount,
+			bvhStats.MaxDepth,
+			bvhStats.BuildTimeMs
+		);
+	}
+
+	void StaticWorld::UpdateBVHStats()
+	{
+		const BVHBuildStats& bvhStats = m_CollisionBVH.GetStats();
+		m_AccelerationStats.BVHNodes = bvhStats.NodeCount;
+		m_AccelerationStats.BVHLeaves = bvhStats.LeafCount;
+		m_AccelerationStats.BVHMaxDepth = bvhStats.MaxDepth;
+	}
+
+	void StaticWorld::QueryCollisionTriangles(WorldQueryContext& context, const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates, CollisionQueryStats* stats) const
+	{
+		candidates.clear();
+		if (!bounds.IsValid)
+			return;
+
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+		{
+			if (m_CollisionBVH.IsEmpty())
+				return;
+
+			if (stats)
+				stats->BroadPhaseQueries++;
+
+			// Each triangle lives in exactly one BVH leaf, so the result needs no de-duplication.
+			m_CollisionBVH.QueryOverlaps(bounds, candidates);
+			if (stats)
+			{
+				stats->CandidateTriangles += static_cast<uint32_t>(candidates.size());
+				stats->CandidateSurfaces += CountCandidateSurfaces(context, candidates);
+			}
+			return;
+		}
+
+		if (m_SpatialGridLevelMask == 0)
+			return;
+
+		// Every level doubles the base cell size, so floor(x / 2c) == floor(floor(x / c) / 2) and the
+		// base-level range decides the range on every level. The same range means the same candidates.
+		const GridCoord baseMin = ToGridCoord(bounds.Min, m_SpatialGridCellSize);
+		const GridCoord baseMax = ToGridCoord(bounds.Max, m_SpatialGridCellSize);
+		const glm::ivec3 cellMin(baseMin.X, baseMin.Y, baseMin.Z);
+		const glm::ivec3 cellMax(baseMax.X, baseMax.Y, baseMax.Z);
+		if (context.CachedGridVersion == m_SpatialGridVersion && context.CachedCellMin == cellMin && context.CachedCellMax == cellMax)
+		{
+			candidates.assign(context.CachedCandidates.begin(), context.CachedCandidates.end());
+			if (stats)
+			{
+				stats->QueryCacheHits++;
+				stats->CandidateTriangles += static_cast<uint32_t>(candidates.size());
+				stats->CandidateSurfaces += context.CachedCandidateSurfaces;
+			}
+			return;
+		}
+
+		if (stats)
+		{
+			stats->BroadPhaseQueries++;
+			stats->QueryCacheMisses++;
+		}
+
+		const uint32_t collisionStamp = BeginCollisionQuery(context);
+		const uint32_t surfaceStamp = BeginSurfaceQuery(context);
+		uint32_t candidateSurfaces = 0;
+		for (uint32_t level = 0; level < MaxSpatialGridLevels; level++)
+		{
+			if ((m_SpatialGridLevelMask & (1u << level)) == 0)
+				continue;
+
+			const PackedSpatialGrid& grid = m_SpatialGridLevels[level];
+			const float cellSize = GetSpatialGridLevelCellSize(level);
+			ForEachOccupiedCell(grid, ToGridCoord(bounds.Min, cellSize), ToGridCoord(bounds.Max, cellSize), [&](uint32_t cellIndex)
+			{
+				for (uint32_t triangleIndex : grid.GetCellTriangles(cellIndex))
+				{
+					if (triangleIndex >= context.CollisionMarks.size() ||
+						context.CollisionMarks[triangleIndex] == collisionStamp)
+						continue;
+
+					context.CollisionMarks[triangleIndex] = collisionStamp;
+					candidates.push_back(triangleIndex);
+
+					const uint32_t surfaceIndex = GetTriangleSurface(triangleIndex);
+					if (surfaceIndex < context.SurfaceMarks.size() &&
+						context.SurfaceMarks[surfaceIndex] != surfaceStamp)
+					{
+						context.SurfaceMarks[surfaceIndex] = surfaceStamp;
+						candidateSurfaces++;
+					}
+				}
+			});
+		}
+
+		context.CachedCandidates.assign(candidates.begin(), candidates.end());
+		context.CachedCellMin = cellMin;
+		context.CachedCellMax = cellMax;
+		context.CachedCandidateSurfaces = candidateSurfaces;
+		context.CachedGridVersion = m_SpatialGridVersion;
+
+		if (stats)
+		{
+			stats->CandidateTriangles += static_cast<uint32_t>(candidates.size());
+			stats->CandidateSurfaces += candidateSurfaces;
+		}
+	}
+
+	uint32_t StaticWorld::CountCandidateSurfaces(WorldQueryContext& context, const std::vector<uint32_t>& triangles) const
+	{
+		const uint32_t surfaceStamp = BeginSurfaceQuery(context);
+		uint32_t candidateSurfaces = 0;
+		for (uint32_t triangleIndex : triangles)
+		{
+			const uint32_t surfaceIndex = GetTriangleSurface(triangleIndex);
+			if (surfaceIndex < context.SurfaceMarks.size() &&
+				context.SurfaceMarks[surfaceIndex] != surfaceStamp)
+			{
+				context.SurfaceMarks[surfaceIndex] = surfaceStamp;
+				candidateSurfaces++;
+			}
+		}
+
+		return candidateSurfaces;
+	}
+
+	void StaticWorld::QuerySurfaces(const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates) const
+	{
+		QuerySurfaces(m_DefaultQueryContext, bounds, candidates);
+	}
+
+	void StaticWorld::QuerySurfaces(WorldQueryContext& context, const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates) const
+	{
+		candidates.clear();
+		if (!bounds.IsValid)
+			return;
+
+		const uint32_t surfaceStamp = BeginSurfaceQuery(context);
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
 		{
-			stats->CandidateTriangles += static_cast<uint32_t>(candidates.size());
-			stats->CandidateSurfaces += candidateSurfaces;
+			m_CollisionBVH.QueryOverlaps(bounds, context.CollisionCandidates);
+			for (uint32_t triangleIndex : context.CollisionCandidates)
+			{
+				const uint32_t surfaceIndex = GetTriangleSurface(triangleIndex);
+				if (surfaceIndex >= context.SurfaceMarks.size() ||
+					context.SurfaceMarks[surfaceIndex] == surfaceStamp)
+					continue;
+
+				context.SurfaceMarks[surfaceIndex] = surfaceStamp;
+				candidates.push_back(surfaceIndex);
+			}
+
+			return;
+		}
+
+		for (uint32_t level = 0; level < MaxSpatialGridLevels; level++)
+		{
+			if ((m_SpatialGridLevelMask & (1u << level)) == 0)
+				continue;
+
+			const PackedSpatialGrid& grid = m_SpatialGridLevels[level];
+			const float cellSize = GetSpatialGridLevelCellSize(level);
+			ForEachOccupiedCell(grid, ToGridCoord(bounds.Min, cellSize), ToGridCoord(bounds.Max, cellSize), [&](uint32_t cellIndex)
+			{
+				for (uint32_t surfaceIndex : grid.GetCellSurfaces(cellIndex))
+				{
+					if (surfaceIndex >= context.SurfaceMarks.size() ||
+						context.SurfaceMarks[surfaceIndex] == surfaceStamp)
+						continue;
+
+					context.SurfaceMarks[surfaceIndex] = surfaceStamp;
+					candidates.push_back(surfaceIndex);
+				}
+			});
+		}
+	}
+
+	void StaticWorld::QuerySurfacesFrontToBack(const glm::vec3& eye, std::vector<uint32_t>& surfaces) const
+	{
+		QuerySurfacesFrontToBack(m_DefaultQueryContext, eye, surfaces);
+	}
+
+	void StaticWorld::QuerySurfacesFrontToBack(WorldQueryContext& context, const glm::vec3& eye, std::vector<uint32_t>& surfaces) const
+	{
+		surfaces.clear();
+		EnsureBspCompiled();
+		if (m_Bsp.IsEmpty())
+			return;
+
+		const uint32_t stamp = BeginSurfaceQuery(context);
+		const std::vector<uint32_t>& leafTriangles = m_Bsp.GetLeafTriangles();
+		m_Bsp.TraverseFrontToBack(eye, [&](const BspLeaf& leaf)
+		{
+			for (uint32_t i = 0; i < leaf.TriangleCount; i++)
+			{
+				const uint32_t surfaceIndex = GetTriangleSurface(leafTriangles[leaf.FirstTriangle + i]);
+				if (context.SurfaceMarks[surfaceIndex] == stamp)
+					continue;
+
+				context.SurfaceMarks[surfaceIndex] = stamp;
+				surfaces.push_back(surfaceIndex);
+			}
+
+			return false;
+		});
+	}
+
+	void StaticWorld::QueryVisibleSurfaces(const Frustum& frustum, std::vector<uint32_t>& visibleSurfaces, FrustumCullStats* stats) const
+	{
+		QueryVisibleSurfaces(m_DefaultQueryContext, frustum, visibleSurfaces, stats);
+	}
+
+	void StaticWorld::QueryVisibleSurfaces(WorldQueryContext& context, const Frustum& frustum, std::vector<uint32_t>& visibleSurfaces, FrustumCullStats* stats) const
+	{
+		visibleSurfaces.clear();
+		MarkVisibleSurfaces(context, frustum, stats);
+		CollectVisibleSurfaces(context, frustum, 0, static_cast<uint32_t>(m_Surfaces.size()), visibleSurfaces, stats);
+	}
+
+	void StaticWorld::MarkVisibleSurfaces(WorldQueryContext& context, const Frustum& frustum, FrustumCullStats* stats) const
+	{
+		// A surface is decided once: a cell inside the frustum can only hold surfaces whose bounds pass the
+		// plane test, so whichever cell reaches a surface first gives the same answer as any later one.
+		FrustumCullStats cullStats;
+		BeginFrustumQuery(context);
+		const uint32_t acceptStamp = context.FrustumAcceptStamp;
+		const uint32_t testStamp = context.FrustumTestStamp;
+		const auto markSurface = [&](uint32_t surfaceIndex, uint32_t stamp)
+		{
+			if (surfaceIndex >= context.SurfaceMarks.size())
+				return;
+
+			uint32_t& mark = context.SurfaceMarks[surfaceIndex];
+			if (mark != acceptStamp && mark != testStamp)
+				mark = stamp;
+		};
+
+		// No cell or node reaches uncovered or staged surfaces; they are always tested on their own bounds.
+		for (uint32_t surfaceIndex : m_UncoveredSurfaces)
+			context.SurfaceMarks[surfaceIndex] = testStamp;
+		for (uint32_t surfaceIndex = m_IndexedSurfaceCount; surfaceIndex < m_Surfaces.size(); surfaceIndex++)
+			context.SurfaceMarks[surfaceIndex] = testStamp;
+
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+		{
+			CullBoundingVolumeHierarchy(
+				m_CollisionBVH,
+				frustum,
+				cullStats,
+				[&](uint32_t triangleIndex) { markSurface(GetTriangleSurface(triangleIndex), acceptStamp); },
+				[&](uint32_t triangleIndex) { markSurface(GetTriangleSurface(triangleIndex), testStamp); }
+			);
+		}
+		else
+		{
+			for (uint32_t level = 0; level < MaxSpatialGridLevels; level++)
+			{
+				if ((m_SpatialGridLevelMask & (1u << level)) == 0)
+					continue;
+
+				const PackedSpatialGrid& grid = m_SpatialGridLevels[level];
+				CullSpatialGridCells(
+					grid,
+					GetSpatialGridLevelCellSize(level),
+					frustum,
+					cullStats,
+					[&](uint32_t cellIndex)
+					{
+						for (uint32_t surfaceIndex : grid.GetCellSurfaces(cellIndex))
+							markSurface(surfaceIndex, acceptStamp);
+					},
+					[&](uint32_t cellIndex)
+					{
+						for (uint32_t surfaceIndex : grid.GetCellSurfaces(cellIndex))
+							markSurface(surfaceIndex, testStamp);
+					}
+				);
+			}
+		}
+
+		if (stats)
+			stats->CellsTested += cullStats.CellsTested;
+	}
+
+	void StaticWorld::CollectVisibleSurfaces(const WorldQueryContext& context, const Frustum& frustum, uint32_t firstSurface, uint32_t surfaceCount, std::vector<uint32_t>& visibleSurfaces, FrustumCullStats* stats) const
+	{
+		FT_CORE_ASSERT(firstSurface + surfaceCount <= m_Surfaces.size(), "Visible surface range is outside the world!");
+		FT_CORE_ASSERT(context.SurfaceMarks.size() >= m_Surfaces.size(), "Collect visible surfaces after marking them!");
+
+		// Walking the marks in surface order keeps the result sorted without a sort, whatever order the
+		// cells were visited in, so submission stays stable from frame to frame.
+		const uint32_t testedCount = CullMarkedBoundsRange(
+			frustum,
+			m_SurfaceBounds,
+			context.SurfaceMarks.data(),
+			context.FrustumAcceptStamp,
+			context.FrustumTestStamp,
+			firstSurface,
+			surfaceCount,
+			visibleSurfaces
+		);
+
+		if (stats)
+			stats->SurfacesTested += testedCount;
+	}
+
+	template <typename TriangleFunction>
+	void StaticWorld::TraverseSpatialGridRay(WorldQueryContext& context, const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleFunction&& triangleFunction) const
+	{
+		if (m_SpatialGridLevelMask == 0 || !m_WorldBounds.IsValid)
+			return;
+
+		// Clip the segment to the world bounds so the walk never steps through empty space outside it.
+		float clipStart = 0.0f;
+		float clipEnd = maxDistance;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (std::abs(direction[axis]) < RayEpsilon)
+			{
+				if (origin[axis] < m_WorldBounds.Min[axis] || origin[axis] > m_WorldBounds.Max[axis])
+					return;
+				continue;
+			}
+
+			const float inverseDirection = 1.0f / direction[axis];
+			float t0 = (m_WorldBounds.Min[axis] - origin[axis]) * inverseDirection;
+			float t1 = (m_WorldBounds.Max[axis] - origin[axis]) * inverseDirection;
+			if (t0 > t1)
+				std::swap(t0, t1);
+
+			clipStart = std::max(clipStart, t0);
+			clipEnd = std::min(clipEnd, t1);
+			if (clipStart > clipEnd)
+				return;
+		}
+
+		const uint32_t collisionStamp = BeginCollisionQuery(context);
+
+		// Amanatides-Woo traversal: step into whichever neighbouring cell the ray reaches first.
+		// Returns true when the triangle function asked to stop the whole query.
+		auto traverseLevel = [&](const PackedSpatialGrid& grid, float cellSize)
+		{
+			GridCoord cell = ToGridCoord(origin + direction * clipStart, cellSize);
+			int32_t step[3] = { 0, 0, 0 };
+			float nextBoundary[3] = { 0.0f, 0.0f, 0.0f };
+			float boundaryStep[3] = { 0.0f, 0.0f, 0.0f };
+			int32_t* cellAxes[3] = { &cell.X, &cell.Y, &cell.Z };
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (std::abs(direction[axis]) < RayEpsilon)
+				{
+					nextBoundary[axis] = std::numeric_limits<float>::max();
+					boundaryStep[axis] = std::numeric_limits<float>::max();
+					continue;
+				}
+
+				step[axis] = direction[axis] > 0.0f ? 1 : -1;
+				const float boundary = static_cast<float>(*cellAxes[axis] + (step[axis] > 0 ? 1 : 0)) * cellSize;
+				nextBoundary[axis] = (boundary - origin[axis]) / direction[axis];
+				boundaryStep[axis] = cellSize / std::abs(direction[axis]);
+			}
+
+			float cellEntry = clipStart;
+			while (cellEntry <= std::min(clipEnd, maxDistance))
+			{
+				const int nextAxis = nextBoundary[0] < nextBoundary[1] ?
+					(nextBoundary[0] < nextBoundary[2] ? 0 : 2) :
+					(nextBoundary[1] < nextBoundary[2] ? 1 : 2);
+				const float cellExit = nextBoundary[nextAxis];
+
+				const uint32_t cellIndex = grid.FindCell(GridCellKey(cell));
+				if (cellIndex != PackedSpatialGrid::InvalidCell)
+				{
+					for (uint32_t triangleIndex : grid.GetCellTriangles(cellIndex))
+					{
+						if (context.CollisionMarks[triangleIndex] == collisionStamp)
+							continue;
+
+						context.CollisionMarks[triangleIndex] = collisionStamp;
+						if (triangleFunction(triangleIndex, maxDistance))
+							return true;
+					}
+				}
+
+				// A hit inside this cell is closer than anything a later cell on this level can contain.
+				if (maxDistance <= cellExit)
+					break;
+
+				*cellAxes[nextAxis] += step[nextAxis];
+				nextBoundary[nextAxis] += boundaryStep[nextAxis];
+				cellEntry = cellExit;
+			}
+
+			return false;
+		};
+
+		// Walk the coarse levels first: their few, large triangles (floors, walls) shrink maxDistance
+		// early and cut the fine-level walks short. Every level shares the stamp and the distance.
+		for (uint32_t level = MaxSpatialGridLevels; level-- > 0;)
+		{
+			if ((m_SpatialGridLevelMask & (1u << level)) == 0)
+				continue;
+
+			if (traverseLevel(m_SpatialGridLevels[level], GetSpatialGridLevelCellSize(level)))
+				return;
+		}
+	}
+
+	WorldRaycastHit StaticWorld::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+	{
+		return Raycast(m_DefaultQueryContext, origin, direction, maxDistance);
+	}
+
+	WorldRaycastHit StaticWorld::Raycast(WorldQueryContext& context, const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+	{
+		WorldRaycastHit closestHit;
+		if (glm::length2(direction) <= 0.0f || maxDistance <= 0.0f)
+			return closestHit;
+
+		// Only corners are decoded per candidate; the normal is rebuilt once for the closest hit.
+		const glm::vec3 rayDirection = glm::normalize(direction);
+		uint32_t closestTriangle = NoTriangle;
+		auto testTriangle = [&](uint32_t triangleIndex, float& closestDistance)
+		{
+			WorldTriangle triangle;
+			DecodeTriangleCorners(triangleIndex, triangle);
+			float distance = 0.0f;
+			if (!RayIntersectsTriangle(origin, rayDirection, triangle, closestDistance, distance))
+				return false;
+
+			closestDistance = distance;
+			closestTriangle = triangleIndex;
+			closestHit.Hit = true;
+			closestHit.Distance = distance;
+			closestHit.Position = origin + rayDirection * distance;
+			return false;
+		};
+
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+			m_CollisionBVH.TraverseRay(origin, rayDirection, maxDistance, testTriangle);
+		else
+			TraverseSpatialGridRay(context, origin, rayDirection, maxDistance, testTriangle);
+
+		if (closestTriangle != NoTriangle)
+		{
+			const WorldTriangle triangle = GetCollisionTriangle(closestTriangle);
+			closestHit.Normal = triangle.Normal;
+			closestHit.SurfaceIndex = triangle.SourceSurfaceIndex;
+		}
+
+		return closestHit;
+	}
+
+	bool StaticWorld::Occluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, CollisionQueryStats* stats) const
+	{
+		return Occluded(m_DefaultQueryContext, origin, direction, maxDistance, stats);
+	}
+
+	bool StaticWorld::Occluded(WorldQueryContext& context, const glm::vec3& origin, const glm::vec3& direction, float maxDistance, CollisionQueryStats* stats) const
+	{
+		if (stats)
+			stats->OcclusionQueries++;
+
+		if (glm::length2(direction) <= 0.0f || maxDistance <= 0.0f || !HasCollisionMesh())
+			return false;
+
+		// Any confirmed intersection answers the query, so maxDistance is never shortened
+		// and the first hit ends the traversal.
+		const glm::vec3 rayDirection = glm::normalize(direction);
+		bool occluded = false;
+		auto testTriangle = [&](uint32_t triangleIndex, float& rayDistance)
+		{
+			if (stats)
+				stats->OcclusionTests++;
+
+			WorldTriangle triangle;
+			DecodeTriangleCorners(triangleIndex, triangle);
+			float distance = 0.0f;
+			occluded = RayIntersectsTriangle(origin, rayDirection, triangle, rayDistance, distance);
+			return occluded;
+		};
+
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+			m_CollisionBVH.TraverseRay(origin, rayDirection, maxDistance, testTriangle);
+		else
+			TraverseSpatialGridRay(context, origin, rayDirection, maxDistance, testTriangle);
+
+		if (occluded && stats)
+			stats->OccludedRays++;
+
+		return occluded;
+	}
+
+	void StaticWorld::RaycastBatch(const std::vector<WorldRay>& rays, std::vector<WorldRaycastHit>& hits) const
+	{
+		RaycastBatch(m_DefaultQueryContext, rays, hits);
+	}
+
+	void StaticWorld::RaycastBatch(WorldQueryContext& context, const std::vector<WorldRay>& rays, std::vector<WorldRaycastHit>& hits) const
+	{
+		hits.assign(rays.size(), WorldRaycastHit());
+		if (!HasCollisionMesh())
+			return;
+
+		for (size_t first = 0; first < rays.size(); first += SimdWidth)
+		{
+			WorldRayPacket packet;
+			uint32_t directionSigns = 0;
+			bool mixedDirections = false;
+			AxisAlignedBounds packetBounds;
+			for (uint32_t lane = 0; lane < SimdWidth; lane++)
+			{
+				const size_t rayIndex = first + lane;
+				packet.OriginX[lane] = 0.0f;
+				packet.OriginY[lane] = 0.0f;
+				packet.OriginZ[lane] = 0.0f;
+				packet.DirectionX[lane] = 0.0f;
+				packet.DirectionY[lane] = 0.0f;
+				packet.DirectionZ[lane] = 1.0f;
+				packet.InverseDirectionX[lane] = 0.0f;
+				packet.InverseDirectionY[lane] = 0.0f;
+				packet.InverseDirectionZ[lane] = 1.0f;
+				packet.MaxDistance[lane] = -1.0f;
+				packet.HitTriangle[lane] = NoTriangle;
+				packet.RayIndex[lane] = NoTriangle;
+				if (rayIndex >= rays.size())
+					continue;
+
+				const WorldRay& ray = rays[rayIndex];
+				if (glm::length2(ray.Direction) <= 0.0f || ray.MaxDistance <= 0.0f)
+					continue;
+
+				const glm::vec3 direction = glm::normalize(ray.Direction);
+				const glm::vec3 inverseDirection = BoundingVolumeHierarchy::CalculateInverseDirection(direction);
+				packet.OriginX[lane] = ray.Origin.x;
+				packet.OriginY[lane] = ray.Origin.y;
+				packet.OriginZ[lane] = ray.Origin.z;
+				packet.DirectionX[lane] = direction.x;
+				packet.DirectionY[lane] = direction.y;
+				packet.DirectionZ[lane] = direction.z;
+				packet.InverseDirectionX[lane] = inverseDirection.x;
+				packet.InverseDirectionY[lane] = inverseDirection.y;
+				packet.InverseDirectionZ[lane] = inverseDirection.z;
+				packet.MaxDistance[lane] = ray.MaxDistance;
+				packet.RayIndex[lane] = static_cast<uint32_t>(rayIndex);
+
+				const uint32_t signs = (direction.x < 0.0f ? 1u : 0u) | (direction.y < 0.0f ? 2u : 0u) | (direction.z < 0.0f ? 4u : 0u);
+				if (packet.RayCount > 0 && signs != directionSigns)
+					mixedDirections = true;
+				directionSigns = signs;
+
+				AxisAlignedBounds segmentBounds;
+				segmentBounds.Min = glm::min(ray.Origin, ray.Origin + direction * ray.MaxDistance);
+				segmentBounds.Max = glm::max(ray.Origin, ray.Origin + direction * ray.MaxDistance);
+				segmentBounds.IsValid = true;
+				Encapsulate(packetBounds, segmentBounds);
+				packet.RayCount++;
+			}
+
+			if (packet.RayCount == 0)
+				continue;
+
+			if (!TraceRayPacket(context, packet, packetBounds, mixedDirections))
+			{
+				// The packet is too spread out to share work; fall back to one walk per ray.
+				for (uint32_t lane = 0; lane < SimdWidth; lane++)
+				{
+					if (packet.RayIndex[lane] == NoTriangle)
+						continue;
+
+					const WorldRay& ray = rays[packet.RayIndex[lane]];
+					hits[packet.RayIndex[lane]] = Raycast(context, ray.Origin, ray.Direction, ray.MaxDistance);
+				}
+				continue;
+			}
+
+			for (uint32_t lane = 0; lane < SimdWidth; lane++)
+			{
+				if (packet.RayIndex[lane] == NoTriangle || packet.HitTriangle[lane] == NoTriangle)
+					continue;
+
+				const WorldTriangle triangle = GetCollisionTriangle(packet.HitTriangle[lane]);
+				const glm::vec3 origin(packet.OriginX[lane], packet.OriginY[lane], packet.OriginZ[lane]);
+				const glm::vec3 direction(packet.DirectionX[lane], packet.DirectionY[lane], packet.DirectionZ[lane]);
+				WorldRaycastHit& hit = hits[packet.RayIndex[lane]];
+				hit.Hit = true;
+				hit.Distance = packet.MaxDistance[lane];
+				hit.Position = origin + direction * hit.Distance;
+				hit.Normal = triangle.Normal;
+				hit.SurfaceIndex = triangle.SourceSurfaceIndex;
+			}
+		}
+	}
+
+	bool StaticWorld::TraceRayPacket(WorldQueryContext& context, WorldRayPacket& packet, const AxisAlignedBounds& packetBounds, bool mixedDirections) const
+	{
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+		{
+			// Rays that leave in different octants disagree on child order and rarely share nodes.
+			if (mixedDirections || m_CollisionBVH.IsEmpty())
+				return false;
+
+			const std::vector<BVHNode>& nodes = m_CollisionBVH.GetNodes();
+			const std::vector<uint32_t>& primitiveIndices = m_CollisionBVH.GetPrimitiveIndices();
+			glm::vec3 packetDirection(0.0f);
+			for (uint32_t lane = 0; lane < SimdWidth; lane++)
+			{
+				if (packet.RayIndex[lane] != NoTriangle)
+					packetDirection += glm::vec3(packet.DirectionX[lane], packet.DirectionY[lane], packet.DirectionZ[lane]);
+			}
+
+			uint32_t stack[MaxPacketTraversalDepth];
+			uint32_t stackSize = 0;
+			stack[stackSize++] = 0;
+			while (stackSize > 0)
+			{
+				const BVHNode& node = nodes[stack[--stackSize]];
+				if (!RayPacketIntersectsNode(packet, node))
+					continue;
+
+				if (node.IsLeaf())
+				{
+					for (uint32_t i = 0; i < node.PrimitiveCount; i++)
+					{
+						const uint32_t triangleIndex = primitiveIndices[node.LeftFirst + i];
+						WorldTriangle triangle;
+						DecodeTriangleCorners(triangleIndex, triangle);
+						IntersectRayPacketTriangle(packet, triangle, triangleIndex);
+					}
+					continue;
+				}
+
+				// All rays share an octant, so one ordering along the packet direction suits every lane.
+				const BVHNode& left = nodes[node.LeftFirst];
+				const BVHNode& right = nodes[node.LeftFirst + 1];
+				const float leftOrder = glm::dot(left.Min + left.Max, packetDirection);
+				const float rightOrder = glm::dot(right.Min + right.Max, packetDirection);
+				if (leftOrder <= rightOrder)
+				{
+					stack[stackSize++] = node.LeftFirst + 1;
+					stack[stackSize++] = node.LeftFirst;
+				}
+				else
+				{
+					stack[stackSize++] = node.LeftFirst;
+					stack[stackSize++] = node.LeftFirst + 1;
+				}
+			}
+
+			return true;
+		}
+
+		if (m_SpatialGridLevelMask == 0)
+			return true;
+
+		uint64_t packetCells = 0;
+		for (uint32_t level = 0; level < MaxSpatialGridLevels; level++)
+		{
+			if ((m_SpatialGridLevelMask & (1u << level)) == 0)
+				continue;
+
+			const float cellSize = GetSpatialGridLevelCellSize(level);
+			const GridCoord minCoord = ToGridCoord(packetBounds.Min, cellSize);
+			const GridCoord maxCoord = ToGridCoord(packetBounds.Max, cellSize);
+			packetCells +=
+				static_cast<uint64_t>(maxCoord.X - minCoord.X + 1) *
+				static_cast<uint64_t>(maxCoord.Y - minCoord.Y + 1) *
+				static_cast<uint64_t>(maxCoord.Z - minCoord.Z + 1);
+		}
+		if (packetCells > MaxSharedPacketCells)
+			return false;
+
+		// Short or tightly grouped rays: gather the shared cells once and test each candidate against every lane.
+		QueryCollisionTriangles(context, packetBounds, context.CollisionCandidates);
+		for (uint32_t triangleIndex : context.CollisionCandidates)
+		{
+			WorldTriangle triangle;
+			DecodeTriangleCorners(triangleIndex, triangle);
+			IntersectRayPacketTriangle(packet, triangle, triangleIndex);
+		}
+
+		return true;
+	}
+
+	glm::vec3 StaticWorld::ResolveAABBMovement(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& desiredDelta, CollisionQueryStats* stats) const
+	{
+		return ResolveAABBMovement(m_DefaultQueryContext, center, halfExtents, desiredDelta, stats);
+	}
+
+	glm::vec3 StaticWorld::ResolveAABBMovement(WorldQueryContext& context, const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& desiredDelta, CollisionQueryStats* stats) const
+	{
+		glm::vec3 resolvedCenter = center;
+		glm::vec3 resolvedDelta = glm::vec3(0.0f);
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			glm::vec3 axisDelta = glm::vec3(0.0f);
+			axisDelta[axis] = desiredDelta[axis];
+			if (axisDelta[axis] == 0.0f)
+				continue;
+
+			const glm::vec3 candidateCenter = resolvedCenter + axisDelta;
+			const AxisAlignedBounds candidateBounds = MakeAABB(candidateCenter, halfExtents);
+			QueryCollisionTriangles(context, candidateBounds, context.CollisionCandidates, stats);
+			if (AABBOverlapsAnyTriangle(candidateBounds, m_CollisionVertices, m_CollisionTriangles, m_CollisionTriangleBlocks, context.CollisionCandidates, stats))
+				continue;
+
+			resolvedCenter = candidateCenter;
+			resolvedDelta += axisDelta;
 		}
+
+		return resolvedDelta;
 	}
 
-	void StaticWorld::QuerySurfaces(const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates) const
+	void StaticWorld::ResolveAABBMovementBatch(
+		const std::vector<glm::vec3>& centers,
+		const std::vector<glm::vec3>& halfExtents,
+		const std::vector<glm::vec3>& desiredDeltas,
+		std::vector<glm::vec3>& resolvedDeltas,
+		CollisionQueryStats* stats) const
 	{
-		candidates.clear();
-		if (!bounds.IsValid || m_SpatialGrid.empty())
+		FT_CORE_ASSERT(centers.size() == halfExtents.size() && centers.size() == desiredDeltas.size(), "ResolveAABBMovementBatch needs one half extent and one delta per center.");
+		const size_t moverCount = std::min(centers.size(), std::min(halfExtents.size(), desiredDeltas.size()));
+		resolvedDeltas.assign(moverCount, glm::vec3(0.0f));
+
+		// Every axis probe of a mover stays inside the box spanned by its start and end positions,
+		// so one query over the union of a group's boxes returns a superset of each probe's candidates.
+		// A triangle overlapping a probe is always in that superset, which keeps results identical to
+		// the per-mover path; the extra candidates only cost narrow-phase tests.
+		std::vector<AxisAlignedBounds> moveBounds(moverCount);
+		std::vector<uint32_t> movers;
+		movers.reserve(moverCount);
+		float smallestMoveExtent = std::numeric_limits<float>::max();
+		for (size_t moverIndex = 0; moverIndex < moverCount; moverIndex++)
+		{
+			const glm::vec3& delta = desiredDeltas[moverIndex];
+			if (delta.x == 0.0f && delta.y == 0.0f && delta.z == 0.0f)
+				continue;
+
+			AxisAlignedBounds& bounds = moveBounds[moverIndex];
+			bounds = MakeAABB(centers[moverIndex], halfExtents[moverIndex]);
+			Encapsulate(bounds, MakeAABB(centers[moverIndex] + delta, halfExtents[moverIndex]));
+			const glm::vec3 extent = bounds.Max - bounds.Min;
+			smallestMoveExtent = std::min(smallestMoveExtent, std::max(extent.x, std::max(extent.y, extent.z)));
+			movers.push_back(static_cast<uint32_t>(moverIndex));
+		}
+
+		if (movers.empty())
 			return;
 
-		if (m_SurfaceQueryStamp == 0)
+		// Each mover is bucketed on its own level, whose cells are at least twice its move box, so a group
+		// sharing a cell spans at most 1.5 of that level's cells per axis and one fast or large mover no
+		// longer coarsens every other group. Levels double from the grid's base cell, or from twice the
+		// smallest move box on the BVH. Morton order within a level keeps neighbouring groups, and
+		// therefore each worker's cache footprint, close together.
+		const float baseCellSize = std::max(m_SpatialGridCellSize > 0.0f ? m_SpatialGridCellSize : 2.0f * smallestMoveExtent, MinGridCellSize);
+		std::vector<uint64_t> moverKeys(moverCount, 0);
+		std::vector<uint32_t> moverLevels(moverCount, 0);
+		for (uint32_t moverIndex : movers)
+		{
+			const glm::vec3 extent = moveBounds[moverIndex].Max - moveBounds[moverIndex].Min;
+			const float groupCellSize = 2.0f * std::max(extent.x, std::max(extent.y, extent.z));
+			uint32_t level = 0;
+			float cellSize = baseCellSize;
+			while (level + 1 < MaxMovementBatchLevels && cellSize < groupCellSize)
+			{
+				cellSize *= 2.0f;
+				level++;
+			}
+
+			moverLevels[moverIndex] = level;
+			moverKeys[moverIndex] = GridCellKey(ToGridCoord(centers[moverIndex], cellSize));
+		}
+		std::sort(movers.begin(), movers.end(), [&moverKeys, &moverLevels](uint32_t a, uint32_t b)
+		{
+			if (moverLevels[a] != moverLevels[b])
+				return moverLevels[a] < moverLevels[b];
+			return moverKeys[a] != moverKeys[b] ? moverKeys[a] < moverKeys[b] : a < b;
+		});
+
+		std::vector<uint32_t> batchOffsets;
+		batchOffsets.push_back(0);
+		for (uint32_t sortedIndex = 1; sortedIndex < movers.size(); sortedIndex++)
 		{
-			std::fill(m_SurfaceQueryMarks.begin(), m_SurfaceQueryMarks.end(), 0);
-			m_SurfaceQueryStamp = 1;
+			const uint32_t mover = movers[sortedIndex];
+			const uint32_t previousMover = movers[sortedIndex - 1];
+			if (moverLevels[mover] != moverLevels[previousMover] ||
+				moverKeys[mover] != moverKeys[previousMover] ||
+				sortedIndex - batchOffsets.back() >= MaxMovementBatchMovers)
+				batchOffsets.push_back(sortedIndex);
 		}
+		batchOffsets.push_back(static_cast<uint32_t>(movers.size()));
+
+		const size_t batchCount = batchOffsets.size() - 1;
+		const uint32_t chunkCount = GetParallelChunkCount(batchCount, MinMovementBatchesPerChunk, m_Settings.QueryThreadCount);
 
-		const GridCoord minCoord = ToGridCoord(bounds.Min, m_SpatialGridCellSize);
-		const GridCoord maxCoord = ToGridCoord(bounds.Max, m_SpatialGridCellSize);
-		for (int32_t z = minCoord.Z; z <= maxCoord.Z; z++)
+		std::vector<CollisionQueryStats> chunkStats(stats ? chunkCount : 0);
+		ParallelForChunks(batchCount, chunkCount, [&](uint32_t chunkIndex, size_t firstBatch, size_t endBatch)
 		{
-			for (int32_t y = minCoord.Y; y <= maxCoord.Y; y++)
+			WorldQueryContext& context = GetThreadBatchQueryContext();
+			CollisionQueryStats* batchStats = stats ? &chunkStats[chunkIndex] : nullptr;
+			for (size_t batchIndex = firstBatch; batchIndex < endBatch; batchIndex++)
 			{
-				for (int32_t x = minCoord.X; x <= maxCoord.X; x++)
-				{
-					const auto cell = m_SpatialGrid.find(HashGridCoord({ x, y, z }));
-					if (cell == m_SpatialGrid.end())
-						continue;
+				const auto startTime = std::chrono::steady_clock::now();
 
-					for (uint32_t surfaceIndex : cell->second.Surfaces)
+				AxisAlignedBounds batchBounds;
+				for (uint32_t sortedIndex = batchOffsets[batchIndex]; sortedIndex < batchOffsets[batchIndex + 1]; sortedIndex++)
+					Encapsulate(batchBounds, moveBounds[movers[sortedIndex]]);
+				QueryCollisionTriangles(context, batchBounds, context.CollisionCandidates, batchStats);
+
+				for (uint32_t sortedIndex = batchOffsets[batchIndex]; sortedIndex < batchOffsets[batchIndex + 1]; sortedIndex++)
+				{
+					const uint32_t moverIndex = movers[sortedIndex];
+					glm::vec3 resolvedCenter = centers[moverIndex];
+					glm::vec3& resolvedDelta = resolvedDeltas[moverIndex];
+					for (int axis = 0; axis < 3; axis++)
 					{
-						if (surfaceIndex >= m_SurfaceQueryMarks.size() ||
-							m_SurfaceQueryMarks[surfaceIndex] == m_SurfaceQueryStamp)
+						glm::vec3 axisDelta = glm::vec3(0.0f);
+						axisDelta[axis] = desiredDeltas[moverIndex][axis];
+						if (axisDelta[axis] == 0.0f)
 							continue;
 
-						m_SurfaceQueryMarks[surfaceIndex] = m_SurfaceQueryStamp;
-						candidates.push_back(surfaceIndex);
+						const glm::vec3 candidateCenter = resolvedCenter + axisDelta;
+						if (AABBOverlapsAnyTriangle(MakeAABB(candidateCenter, halfExtents[moverIndex]), m_CollisionVertices, m_CollisionTriangles, m_CollisionTriangleBlocks, context.CollisionCandidates, batchStats))
+							continue;
+
+						resolvedCenter = candidateCenter;
+						resolvedDelta += axisDelta;
 					}
 				}
+
+				if (batchStats)
+				{
+					const auto endTime = std::chrono::steady_clock::now();
+					batchStats->MovementBatches++;
+					batchStats->BatchedMovers += batchOffsets[batchIndex + 1] - batchOffsets[batchIndex];
+					batchStats->MovementBatchTimeMs += std::chrono::duration<float, std::milli>(endTime - startTime).count();
+				}
 			}
-		}
+		});
 
-		m_SurfaceQueryStamp++;
+		// Chunks cover fixed batch ranges, so merging in chunk order gives the same counters on every run.
+		for (const CollisionQueryStats& chunk : chunkStats)
+			AccumulateCollisionStats(*stats, chunk);
 	}
 
-	WorldRaycastHit StaticWorld::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+	WorldSweepHit StaticWorld::SweepAABB(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& delta, CollisionQueryStats* stats) const
 	{
-		WorldRaycastHit closestHit;
-		if (glm::length2(direction) <= 0.0f || maxDistance <= 0.0f)
-			return closestHit;
+		return SweepAABB(m_DefaultQueryContext, center, halfExtents, delta, stats);
+	}
 
-		const glm::vec3 rayDirection = glm::normalize(direction);
-		AxisAlignedBounds rayBounds;
-		rayBounds.Min = glm::min(origin, origin + rayDirection * maxDistance);
-		rayBounds.Max = glm::max(origin, origin + rayDirection * maxDistance);
-		rayBounds.IsValid = true;
-		QueryCollisionTriangles(rayBounds, m_CollisionQueryCandidates);
+	WorldSweepHit StaticWorld::SweepAABB(WorldQueryContext& context, const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& delta, CollisionQueryStats* stats) const
+	{
+		WorldSweepHit sweepHit;
+		sweepHit.RemainingDelta = glm::vec3(0.0f);
+		const float deltaLength = glm::length(delta);
+		if (deltaLength <= 0.0f)
+			return sweepHit;
+
+		if (stats)
+			stats->SweepQueries++;
+
+		const float skin = SweepSkinFraction * std::min(halfExtents.x, std::min(halfExtents.y, halfExtents.z));
+		AxisAlignedBounds sweptBounds = MakeAABB(center, halfExtents + glm::vec3(skin));
+		Encapsulate(sweptBounds, MakeAABB(center + delta, halfExtents + glm::vec3(skin)));
+		QueryCollisionTriangles(context, sweptBounds, context.CollisionCandidates, stats);
 
-		float closestDistance = maxDistance;
-		for (uint32_t triangleIndex : m_CollisionQueryCandidates)
+		float closestTime = 1.0f;
+		int closestAxis = -1;
+		uint32_t closestTriangle = NoTriangle;
+		for (uint32_t triangleIndex : context.CollisionCandidates)
 		{
-			const WorldTriangle& triangle = m_CollisionTriangles[triangleIndex];
-			float distance = 0.0f;
-			if (!RayIntersectsTriangle(origin, rayDirection, triangle, closestDistance, distance))
+			if (stats)
+				stats->NarrowPhaseTests++;
+
+			float entryTime = 0.0f;
+			int entryAxis = 0;
+			if (!SweepAABBIntersectsBounds(center, halfExtents, delta, DecodeTriangleBounds(triangleIndex), closestTime, skin, entryTime, entryAxis))
 				continue;
 
-			closestDistance = distance;
-			closestHit.Hit = true;
-			closestHit.Distance = distance;
-			closestHit.Position = origin + rayDirection * distance;
-			closestHit.Normal = triangle.Normal;
-			closestHit.SurfaceIndex = triangle.SourceSurfaceIndex;
+			// Ties keep the lowest triangle index so the result does not depend on candidate order.
+			if (entryTime < closestTime || (entryTime == closestTime && triangleIndex < closestTriangle))
+			{
+				closestTime = entryTime;
+				closestAxis = entryAxis;
+				closestTriangle = triangleIndex;
+			}
 		}
 
-		return closestHit;
+		if (closestTriangle == NoTriangle)
+			return sweepHit;
+
+		if (stats)
+			stats->ContactsGenerated++;
+
+		sweepHit.Hit = true;
+		sweepHit.Time = std::max(closestTime - skin / deltaLength, 0.0f);
+		sweepHit.Normal = glm::vec3(0.0f);
+		sweepHit.Normal[closestAxis] = delta[closestAxis] > 0.0f ? -1.0f : 1.0f;
+		sweepHit.SurfaceIndex = GetTriangleSurface(closestTriangle);
+
+		const glm::vec3 remainingDelta = delta * (1.0f - sweepHit.Time);
+		sweepHit.RemainingDelta = remainingDelta - sweepHit.Normal * std::min(glm::dot(remainingDelta, sweepHit.Normal), 0.0f);
+		return sweepHit;
 	}
 
-	glm::vec3 StaticWorld::ResolveAABBMovement(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& desiredDelta, CollisionQueryStats* stats) const
+	WorldSweepHit StaticWorld::SweepSphere(const glm::vec3& center, float radius, const glm::vec3& delta, CollisionQueryStats* stats) const
 	{
-		glm::vec3 resolvedCenter = center;
-		glm::vec3 resolvedDelta = glm::vec3(0.0f);
+		return SweepCapsule(m_DefaultQueryContext, center, center, radius, delta, stats);
+	}
 
-		for (int axis = 0; axis < 3; axis++)
+	WorldSweepHit StaticWorld::SweepSphere(WorldQueryContext& context, const glm::vec3& center, float radius, const glm::vec3& delta, CollisionQueryStats* stats) const
+	{
+		return SweepCapsule(context, center, center, radius, delta, stats);
+	}
+
+	WorldSweepHit StaticWorld::SweepCapsule(const glm::vec3& segmentStart, const glm::vec3& segmentEnd, float radius, const glm::vec3& delta, CollisionQueryStats* stats) const
+	{
+		return SweepCapsule(m_DefaultQueryContext, segmentStart, segmentEnd, radius, delta, stats);
+	}
+
+	WorldSweepHit StaticWorld::SweepCapsule(
+		WorldQueryContext& context,
+		const glm::vec3& segmentStart,
+		const glm::vec3& segmentEnd,
+		float radius,
+		const glm::vec3& delta,
+		CollisionQueryStats* stats) const
+	{
+		WorldSweepHit sweepHit;
+		sweepHit.RemainingDelta = glm::vec3(0.0f);
+		const float deltaLength = glm::length(delta);
+		if (deltaLength <= 0.0f || radius <= 0.0f)
+			return sweepHit;
+
+		if (stats)
+			stats->SweepQueries++;
+
+		// Contacts stop between half a skin and a full skin away from the surface, so the next
+		// slide step starts separated and never has to resolve an overlap.
+		const float skin = SweepSkinFraction * radius;
+		const glm::vec3 capsuleCenter = (segmentStart + segmentEnd) * 0.5f;
+		const glm::vec3 capsuleHalfExtents = glm::abs(segmentEnd - segmentStart) * 0.5f + glm::vec3(radius);
+		AxisAlignedBounds sweptBounds = MakeAABB(capsuleCenter, capsuleHalfExtents + glm::vec3(skin));
+		Encapsulate(sweptBounds, MakeAABB(capsuleCenter + delta, capsuleHalfExtents + glm::vec3(skin)));
+		QueryCollisionTriangles(context, sweptBounds, context.CollisionCandidates, stats);
+
+		float closestTime = 1.0f;
+		glm::vec3 closestNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+		uint32_t closestTriangle = NoTriangle;
+		for (uint32_t triangleIndex : context.CollisionCandidates)
 		{
-			glm::vec3 axisDelta = glm::vec3(0.0f);
-			axisDelta[axis] = desiredDelta[axis];
-			if (axisDelta[axis] == 0.0f)
+			if (stats)
+				stats->NarrowPhaseTests++;
+
+			// Early out 1: the capsule's box must reach the triangle's box before the best contact so far.
+			// Start overlaps are common (a capsule inside a slope's box), so any depth is accepted as time 0.
+			float advanceTime = 0.0f;
+			int entryAxis = 0;
+			if (!SweepAABBIntersectsBounds(capsuleCenter, capsuleHalfExtents + glm::vec3(skin), delta, DecodeTriangleBounds(triangleIndex), closestTime, std::numeric_limits<float>::max(), advanceTime, entryAxis))
 				continue;
 
-			const glm::vec3 candidateCenter = resolvedCenter + axisDelta;
-			const AxisAlignedBounds candidateBounds = MakeAABB(candidateCenter, halfExtents);
-			QueryCollisionTriangles(candidateBounds, m_CollisionQueryCandidates, stats);
-			if (AABBOverlapsAnyTriangleBounds(candidateBounds, m_CollisionTriangles, m_CollisionQueryCandidates, stats))
+			// Early out 2: both capsule ends stay more than a radius to the same side of the plane.
+			const WorldTriangle triangle = GetCollisionTriangle(triangleIndex);
+			const float startDistanceA = glm::dot(triangle.Normal, segmentStart - triangle.A);
+			const float startDistanceB = glm::dot(triangle.Normal, segmentEnd - triangle.A);
+			const float planeMotion = glm::dot(triangle.Normal, delta) * closestTime;
+			const float reach = radius + skin;
+			const float nearestStart = std::min(startDistanceA, startDistanceB);
+			const float farthestStart = std::max(startDistanceA, startDistanceB);
+			if ((nearestStart > reach && nearestStart + planeMotion > reach) ||
+				(farthestStart < -reach && farthestStart + planeMotion < -reach))
 				continue;
 
-			resolvedCenter = candidateCenter;
-			resolvedDelta += axisDelta;
+			// Conservative advancement on the closest features. Both shapes are convex and only translate, so
+			// the gap is a convex function of time and its tangent never overshoots the true contact time.
+			// Each step is a Newton step towards half a skin; a gap that stops shrinking never closes.
+			bool contact = false;
+			bool decided = false;
+			glm::vec3 contactNormal = glm::vec3(0.0f, 1.0f, 0.0f);
+			for (uint32_t step = 0; step < MaxSweepAdvanceSteps && advanceTime <= closestTime; step++)
+			{
+				if (stats)
+					stats->ClosestFeatureTests++;
+
+				const glm::vec3 offset = delta * advanceTime;
+				glm::vec3 capsulePoint;
+				glm::vec3 trianglePoint;
+				const float distance = std::sqrt(ClosestPointsSegmentTriangle(segmentStart + offset, segmentEnd + offset, triangle, capsulePoint, trianglePoint));
+
+				// The segment touches or pierces the triangle, usually because the capsule started inside it. The
+				// face normal on the side of the segment's midpoint stops motion into the triangle at once, and
+				// motion away from it is let through so the capsule can leave.
+				decided = true;
+				if (distance <= RayEpsilon)
+				{
+					const float midpointDistance = glm::dot(triangle.Normal, capsuleCenter + offset - triangle.A);
+					const bool behind = midpointDistance < 0.0f || (midpointDistance == 0.0f && glm::dot(delta, triangle.Normal) > 0.0f);
+					contactNormal = behind ? -triangle.Normal : triangle.Normal;
+					contact = glm::dot(delta, contactNormal) < 0.0f;
+					break;
+				}
+
+				contactNormal = (capsulePoint - trianglePoint) / distance;
+				const float approach = -glm::dot(delta, contactNormal);
+				const float gap = distance - radius;
+				if (gap <= skin)
+				{
+					// Within the skin only motion into the surface counts. Grazing motion from a slide step is let
+					// through until it eats into the inner quarter of the skin, so rounding in the projected
+					// delta cannot stall every slide iteration against the surface it just left.
+					contact = approach > (gap < skin * 0.25f ? 0.0f : deltaLength * GrazingApproachFraction);
+					break;
+				}
+
+				if (approach <= 0.0f)
+					break;
+
+				advanceTime += (gap - skin * 0.5f) / approach;
+				decided = false;
+			}
+
+			// Newton steps only run out on a grazing pass, where the gap creeps towards the skin. The gap is convex
+			// in time, so bisecting on the sign of its slope finds its lowest point over the rest of the interval.
+			// The capsule stops where the safe steps got it only if that point reaches into the skin.
+			if (!decided && advanceTime <= closestTime)
+			{
+				float lowerTime = advanceTime;
+				float upperTime = closestTime;
+				for (uint32_t step = 0; step < MaxSweepAdvanceSteps && !contact; step++)
+				{
+					if (stats)
+						stats->ClosestFeatureTests++;
+
+					const float time = (lowerTime + upperTime) * 0.5f;
+					const glm::vec3 offset = delta * time;
+					glm::vec3 capsulePoint;
+					glm::vec3 trianglePoint;
+					const float distance = std::sqrt(ClosestPointsSegmentTriangle(segmentStart + offset, segmentEnd + offset, triangle, capsulePoint, trianglePoint));
+					contact = distance - radius <= skin;
+					if (glm::dot(delta, capsulePoint - trianglePoint) < 0.0f)
+						lowerTime = time;
+					else
+						upperTime = time;
+				}
+			}
+
+			if (!contact || advanceTime > closestTime)
+				continue;
+
+			if (advanceTime < closestTime || (advanceTime == closestTime && triangleIndex < closestTriangle))
+			{
+				closestTime = advanceTime;
+				closestNormal = contactNormal;
+				closestTriangle = triangleIndex;
+			}
 		}
 
-		return resolvedDelta;
+		if (closestTriangle == NoTriangle)
+			return sweepHit;
+
+		if (stats)
+			stats->ContactsGenerated++;
+
+		sweepHit.Hit = true;
+		sweepHit.Time = closestTime;
+		sweepHit.Normal = closestNormal;
+		sweepHit.SurfaceIndex = GetTriangleSurface(closestTriangle);
+
+		const glm::vec3 remainingDelta = delta * (1.0f - closestTime);
+		sweepHit.RemainingDelta = remainingDelta - closestNormal * std::min(glm::dot(remainingDelta, closestNormal), 0.0f);
+		return sweepHit;
+	}
+
+	bool StaticWorld::SaveCache(const std::filesystem::path& cachePath, uint64_t sourceFingerprint) const
+	{
+		std::error_code error;
+		std::filesystem::create_directories(cachePath.parent_path(), error);
+		if (error)
+		{
+			FT_CORE_WARN("Unable to create world cache directory '{0}': {1}", cachePath.parent_path().generic_string(), error.message());
+			return false;
+		}
+
+		// Write beside the final path and rename, so a mapped reader never sees a half-written file.
+		std::filesystem::path temporaryPath = cachePath;
+		temporaryPath += ".tmp";
+		{
+			std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!output.is_open())
+			{
+				FT_CORE_WARN("Unable to write world cache '{0}'.", cachePath.generic_string());
+				return false;
+			}
+
+			BinaryWriter writer(output);
+			bool written =
+				writer.Write(WorldCacheMagic) &&
+				writer.Write(WorldCacheFormatVersion) &&
+				writer.Write(static_cast<uint32_t>(sizeof(CompactWorldVertex))) &&
+				writer.Write(static_cast<uint32_t>(sizeof(CompactWorldTriangle))) &&
+				writer.Write(static_cast<uint32_t>(sizeof(CollisionTriangleBlock))) &&
+				writer.Write(static_cast<uint32_t>(sizeof(BVHNode))) &&
+				writer.Write(sourceFingerprint) &&
+				writer.WriteString(m_SourceName) &&
+				writer.Write(m_Transform.Matrix) &&
+				writer.Write(static_cast<uint32_t>(m_Settings.BroadPhase)) &&
+				writer.Write(m_Settings.GridCellSize) &&
+				writer.Write(m_Settings.WeldTolerance) &&
+				writer.Write(static_cast<uint32_t>(m_Settings.BuildEdgeAdjacency)) &&
+				writer.Write(m_Settings.SimplifyTolerance) &&
+				writer.Write(static_cast<uint32_t>(m_Surfaces.size())) &&
+				writer.WriteAlignedArray(m_CollisionVertices) &&
+				writer.WriteAlignedArray(m_CollisionTriangles) &&
+				writer.WriteAlignedArray(m_CollisionTriangleBlocks) &&
+				writer.WriteAlignedArray(m_CollisionTriangleAdjacency) &&
+				// Only the import counts are stored; the other stats are rebuilt from the loaded data.
+				writer.Write(m_SourceTriangleCount) &&
+				writer.Write(m_MergedTriangleCount) &&
+				writer.Write(m_SliverTriangleCount);
+
+			if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+			{
+				written = written && m_CollisionBVH.Write(writer);
+			}
+			else
+			{
+				written = written && writer.Write(m_SpatialGridCellSize) && writer.Write(m_SpatialGridLevelMask);
+				for (uint32_t level = 0; level < MaxSpatialGridLevels; level++)
+				{
+					if (m_SpatialGridLevelMask & (1u << level))
+						written = written && m_SpatialGridLevels[level].Write(writer);
+				}
+			}
+
+			if (!written)
+			{
+				output.close();
+				std::filesystem::remove(temporaryPath, error);
+				FT_CORE_WARN("Unable to write world cache '{0}'.", cachePath.generic_string());
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporaryPath, cachePath, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+			FT_CORE_WARN("Unable to replace world cache '{0}'.", cachePath.generic_string());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool StaticWorld::LoadCache(const std::filesystem::path& cachePath, uint64_t sourceFingerprint)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		MappedFile file;
+		if (!file.Open(cachePath))
+			return false;
+
+		BinaryReader reader(file.GetData(), file.GetSize());
+		uint32_t magic = 0;
+		uint32_t formatVersion = 0;
+		uint32_t vertexSize = 0;
+		uint32_t triangleSize = 0;
+		uint32_t blockSize = 0;
+		uint32_t nodeSize = 0;
+		uint64_t cachedFingerprint = 0;
+		std::string cachedSourceName;
+		glm::mat4 cachedTransform = glm::mat4(1.0f);
+		uint32_t cachedBroadPhase = 0;
+		float cachedGridCellSize = 0.0f;
+		float cachedWeldTolerance = 0.0f;
+		uint32_t cachedEdgeAdjacency = 0;
+		float cachedSimplifyTolerance = 0.0f;
+		uint32_t surfaceCount = 0;
+		if (!reader.Read(magic) ||
+			!reader.Read(formatVersion) ||
+			!reader.Read(vertexSize) ||
+			!reader.Read(triangleSize) ||
+			!reader.Read(blockSize) ||
+			!reader.Read(nodeSize) ||
+			!reader.Read(cachedFingerprint) ||
+			!reader.ReadString(cachedSourceName) ||
+			!reader.Read(cachedTransform) ||
+			!reader.Read(cachedBroadPhase) ||
+			!reader.Read(cachedGridCellSize) ||
+			!reader.Read(cachedWeldTolerance) ||
+			!reader.Read(cachedEdgeAdjacency) ||
+			!reader.Read(cachedSimplifyTolerance) ||
+			!reader.Read(surfaceCount))
+			return false;
+
+		if (magic != WorldCacheMagic ||
+			formatVersion != WorldCacheFormatVersion ||
+			vertexSize != sizeof(CompactWorldVertex) ||
+			triangleSize != sizeof(CompactWorldTriangle) ||
+			blockSize != sizeof(CollisionTriangleBlock) ||
+			nodeSize != sizeof(BVHNode) ||
+			cachedFingerprint != sourceFingerprint ||
+			cachedSourceName != m_SourceName ||
+			cachedTransform != m_Transform.Matrix ||
+			cachedBroadPhase != static_cast<uint32_t>(m_Settings.BroadPhase) ||
+			cachedGridCellSize != m_Settings.GridCellSize ||
+			cachedWeldTolerance != m_Settings.WeldTolerance ||
+			cachedEdgeAdjacency != static_cast<uint32_t>(m_Settings.BuildEdgeAdjacency) ||
+			cachedSimplifyTolerance != m_Settings.SimplifyTolerance ||
+			surfaceCount != m_Surfaces.size())
+			return false;
+
+		// The collision arrays are validated where they lie in the mapping and copied into the world only
+		// once the whole file is accepted, so a rejected cache leaves the world untouched and costs no copies.
+		std::span<const CompactWorldVertex> vertices;
+		std::span<const CompactWorldTriangle> triangles;
+		std::span<const CollisionTriangleBlock> blocks;
+		std::span<const WorldTriangleAdjacency> adjacency;
+		uint32_t sourceTriangleCount = 0;
+		uint32_t mergedTriangleCount = 0;
+		uint32_t sliverTriangleCount = 0;
+		if (!reader.ReadSpan(vertices) ||
+			!reader.ReadSpan(triangles) ||
+			!reader.ReadSpan(blocks) ||
+			!reader.ReadSpan(adjacency) ||
+			!reader.Read(sourceTriangleCount) ||
+			!reader.Read(mergedTriangleCount) ||
+			!reader.Read(sliverTriangleCount) ||
+			triangles.size() >= NoTriangle ||
+			adjacency.size() != (m_Settings.BuildEdgeAdjacency ? triangles.size() : 0))
+			return false;
+
+		for (const CompactWorldTriangle& triangle : triangles)
+		{
+			if (triangle.BlockIndex >= blocks.size() ||
+				triangle.Indices[0] >= vertices.size() ||
+				triangle.Indices[1] >= vertices.size() ||
+				triangle.Indices[2] >= vertices.size())
+				return false;
+		}
+
+		for (const WorldTriangleAdjacency& neighbors : adjacency)
+		{
+			for (uint32_t neighbor : neighbors.Neighbors)
+			{
+				if (neighbor != WorldTriangleAdjacency::NoNeighbor && neighbor >= triangles.size())
+					return false;
+			}
+		}
+
+		for (const CollisionTriangleBlock& block : blocks)
+		{
+			if (block.SourceSurfaceIndex >= surfaceCount ||
+				!(block.StepX > 0.0f && block.StepY > 0.0f && block.StepZ > 0.0f) ||
+				!std::isfinite(block.OriginX) || !std::isfinite(block.OriginY) || !std::isfinite(block.OriginZ) ||
+				!std::isfinite(block.StepX) || !std::isfinite(block.StepY) || !std::isfinite(block.StepZ))
+				return false;
+		}
+
+		const uint32_t triangleCount = static_cast<uint32_t>(triangles.size());
+		std::array<PackedSpatialGrid, MaxSpatialGridLevels> gridLevels;
+		BoundingVolumeHierarchy collisionBVH;
+		float gridCellSize = 0.0f;
+		uint32_t gridLevelMask = 0;
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+		{
+			if (!collisionBVH.Read(reader, triangleCount))
+				return false;
+		}
+		else
+		{
+			if (!reader.Read(gridCellSize) ||
+				!reader.Read(gridLevelMask) ||
+				gridLevelMask >= (1u << MaxSpatialGridLevels) ||
+				(gridLevelMask != 0 && !(std::isfinite(gridCellSize) && gridCellSize >= MinGridCellSize)))
+				return false;
+
+			for (uint32_t level = 0; level < MaxSpatialGridLevels; level++)
+			{
+				if ((gridLevelMask & (1u << level)) && !gridLevels[level].Read(reader, triangleCount, surfaceCount))
+					return false;
+			}
+		}
+
+		if (reader.GetRemaining() != 0)
+			return false;
+
+		m_CollisionTriangles.assign(triangles.begin(), triangles.end());
+		m_CollisionVertices.assign(vertices.begin(), vertices.end());
+		m_CollisionTriangleBlocks.assign(blocks.begin(), blocks.end());
+		m_CollisionTriangleAdjacency.assign(adjacency.begin(), adjacency.end());
+		m_SpatialGridLevels = std::move(gridLevels);
+		m_SpatialGridLevelMask = gridLevelMask;
+		m_SpatialGridCellSize = gridCellSize;
+		m_SpatialGridVersion = NextSpatialGridVersion();
+		m_CollisionBVH = std::move(collisionBVH);
+		m_Bsp.Clear();
+		m_BspTriangleCount = 0;
+		m_BspLoadedFromCache = false;
+		m_IndexedSurfaceCount = static_cast<uint32_t>(m_Surfaces.size());
+		m_IndexedTriangleCount = triangleCount;
+		m_SourceTriangleCount = sourceTriangleCount;
+		m_MergedTriangleCount = mergedTriangleCount;
+		m_SliverTriangleCount = sliverTriangleCount;
+		UpdateCollisionErrorBound();
+		UpdateSurfaceTriangleRanges(0, 0);
+		ResetQueryScratch();
+
+		m_AccelerationStats = {};
+		m_AccelerationStats.BroadPhase = m_Settings.BroadPhase;
+		m_AccelerationStats.IndexedSurfaces = m_IndexedSurfaceCount;
+		m_AccelerationStats.IndexedTriangles = m_IndexedTriangleCount;
+		m_AccelerationStats.SourceTriangles = m_SourceTriangleCount;
+		m_AccelerationStats.MergedTriangles = m_MergedTriangleCount;
+		m_AccelerationStats.SliverTriangles = m_SliverTriangleCount;
+		UpdateCollisionMemoryStats();
+		if (m_Settings.BroadPhase == WorldBroadPhase::BoundingVolumeHierarchy)
+			UpdateBVHStats();
+		else
+			UpdateSpatialGridStats();
+
+		const auto endTime = std::chrono::steady_clock::now();
+		m_AccelerationStats.BuildTimeMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+		m_AccelerationStats.LoadedFromCache = true;
+		UpdateBspStats();
+
+		FT_CORE_INFO(
+			"Loaded static world '{0}' from cache '{1}': {2} collision triangles in {3:.2f} ms.",
+			m_SourceName,
+			cachePath.generic_string(),
+			triangleCount,
+			m_AccelerationStats.BuildTimeMs
+		);
+		return true;
+	}
+
+	uint64_t StaticWorld::HashCollisionGeometry() const
+	{
+		uint64_t hash = 14695981039346656037ull;
+		HashBytes(hash, m_CollisionVertices.data(), m_CollisionVertices.size() * sizeof(CompactWorldVertex));
+		HashBytes(hash, m_CollisionTriangles.data(), m_CollisionTriangles.size() * sizeof(CompactWorldTriangle));
+		HashBytes(hash, m_CollisionTriangleBlocks.data(), m_CollisionTriangleBlocks.size() * sizeof(CollisionTriangleBlock));
+		return hash;
+	}
+
+	void StaticWorld::VerifyBuild(const Ref<Model>& model, const WorldTransform& transform) const
+	{
+		// A single-threaded build without caches is the reference: parallel extraction and welding and the
+		// chunked grid merge all claim to reproduce it exactly.
+		StaticWorldSettings referenceSettings = m_Settings;
+		referenceSettings.BuildThreadCount = 1;
+		referenceSettings.UseWorldCache = false;
+		referenceSettings.BuildBsp = false;
+		StaticWorld reference(m_SourceName, referenceSettings);
+		reference.ExtractCollisionTriangles(reference.AppendSurfaces(model, transform));
+		reference.Finalize();
+		if (reference.m_CollisionVertices.size() != m_CollisionVertices.size() ||
+			reference.m_CollisionTriangles.size() != m_CollisionTriangles.size() ||
+			reference.m_CollisionTriangleBlocks.size() != m_CollisionTriangleBlocks.size() ||
+			reference.HashCollisionGeometry() != HashCollisionGeometry())
+		{
+			FT_CORE_WARN(
+				"Static world '{0}' has {1} collision triangles where a serial build has {2}, or different geometry.",
+				m_SourceName,
+				m_CollisionTriangles.size(),
+				reference.m_CollisionTriangles.size());
+		}
+
+		if (!m_WorldBounds.IsValid || m_CollisionTriangles.empty())
+			return;
+
+		WorldQueryContext context;
+		WorldQueryContext referenceContext;
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> referenceCandidates;
+		uint32_t broadPhaseMismatches = 0;
+		uint32_t narrowPhaseMismatches = 0;
+		const std::vector<AxisAlignedBounds> probes = MakeVerificationProbes(m_WorldBounds);
+		for (const AxisAlignedBounds& probe : probes)
+		{
+			QueryCollisionTriangles(context, probe, candidates, nullptr);
+			reference.QueryCollisionTriangles(referenceContext, probe, referenceCandidates, nullptr);
+			std::sort(candidates.begin(), candidates.end());
+			std::sort(referenceCandidates.begin(), referenceCandidates.end());
+			broadPhaseMismatches += candidates != referenceCandidates ? 1 : 0;
+
+			// The SIMD narrow phase must agree with per-triangle bounds tests on the decoded triangles.
+			bool scalarOverlap = false;
+			for (uint32_t triangleIndex : candidates)
+			{
+				const WorldTriangleBounds triangleBounds = DecodeTriangleBounds(triangleIndex);
+				scalarOverlap = scalarOverlap || (
+					probe.Min.x <= triangleBounds.MaxX && probe.Max.x >= triangleBounds.MinX &&
+					probe.Min.y <= triangleBounds.MaxY && probe.Max.y >= triangleBounds.MinY &&
+					probe.Min.z <= triangleBounds.MaxZ && probe.Max.z >= triangleBounds.MinZ);
+			}
+
+			const bool simdOverlap = AABBOverlapsAnyTriangle(probe, m_CollisionVertices, m_CollisionTriangles, m_CollisionTriangleBlocks, candidates, nullptr);
+			narrowPhaseMismatches += simdOverlap != scalarOverlap ? 1 : 0;
+		}
+
+		if (broadPhaseMismatches != 0)
+			FT_CORE_WARN("Static world '{0}' returns different broad-phase candidates from a serial build for {1} of {2} probe boxes.", m_SourceName, broadPhaseMismatches, probes.size());
+		if (narrowPhaseMismatches != 0)
+			FT_CORE_WARN("Static world '{0}' SIMD narrow phase disagrees with per-triangle bounds tests for {1} of {2} probe boxes.", m_SourceName, narrowPhaseMismatches, probes.size());
+
+		// A fan of rays falling through the world, nudged off the probe lattice. Packets and single rays
+		// may settle a ray grazing a shared edge on either neighbour, so hits are compared by distance, with
+		// a miss counting as the full ray length.
+		constexpr uint32_t rayColumns = 16;
+		const glm::vec3 extent = glm::max(m_WorldBounds.Max - m_WorldBounds.Min, glm::vec3(MinGridCellSize));
+		std::vector<WorldRay> rays;
+		for (uint32_t rayIndex = 0; rayIndex < rayColumns * rayColumns; rayIndex++)
+		{
+			const float u = (static_cast<float>(rayIndex % rayColumns) + 0.437f) / rayColumns;
+			const float v = (static_cast<float>(rayIndex / rayColumns) + 0.619f) / rayColumns;
+			WorldRay ray;
+			ray.Origin = glm::vec3(m_WorldBounds.Min.x + extent.x * u, m_WorldBounds.Max.y + extent.y * 0.01f, m_WorldBounds.Min.z + extent.z * v);
+			ray.Direction = glm::vec3(0.13f * (u - 0.5f), -1.0f, 0.11f * (v - 0.5f));
+			ray.MaxDistance = extent.y * 1.5f;
+			rays.push_back(ray);
+		}
+
+		std::vector<WorldRaycastHit> packetHits;
+		RaycastBatch(context, rays, packetHits);
+		uint32_t rayMismatches = 0;
+		for (size_t rayIndex = 0; rayIndex < rays.size(); rayIndex++)
+		{
+			const WorldRay& ray = rays[rayIndex];
+			const WorldRaycastHit hit = Raycast(context, ray.Origin, ray.Direction, ray.MaxDistance);
+			const float distance = hit.Hit ? hit.Distance : ray.MaxDistance;
+			const float packetDistance = packetHits[rayIndex].Hit ? packetHits[rayIndex].Distance : ray.MaxDistance;
+			rayMismatches += std::abs(distance - packetDistance) > 0.001f * std::max(distance, 1.0f) ? 1 : 0;
+		}
+
+		if (rayMismatches != 0)
+			FT_CORE_WARN("Static world '{0}' packet raycasts stop at a different distance from single rays for {1} of {2} rays.", m_SourceName, rayMismatches, rays.size());
+	}
+
+	bool StaticWorld::SaveBspCache(const std::filesystem::path& cachePath, uint64_t sourceFingerprint) const
+	{
+		EnsureBspCompiled();
+		std::error_code error;
+		std::filesystem::create_directories(cachePath.parent_path(), error);
+		if (error)
+		{
+			FT_CORE_WARN("Unable to create BSP cache directory '{0}': {1}", cachePath.parent_path().generic_string(), error.message());
+			return false;
+		}
+
+		std::filesystem::path temporaryPath = cachePath;
+		temporaryPath += ".tmp";
+		{
+			std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!output.is_open())
+			{
+				FT_CORE_WARN("Unable to write BSP cache '{0}'.", cachePath.generic_string());
+				return false;
+			}
+
+			BinaryWriter writer(output);
+			const bool written =
+				writer.Write(BspCacheMagic) &&
+				writer.Write(BspCacheFormatVersion) &&
+				writer.Write(static_cast<uint32_t>(sizeof(BspNode))) &&
+				writer.Write(static_cast<uint32_t>(sizeof(BspLeaf))) &&
+				writer.Write(static_cast<uint32_t>(sizeof(BspBuildStats))) &&
+				writer.Write(sourceFingerprint) &&
+				writer.Write(HashCollisionGeometry()) &&
+				writer.Write(m_BspTriangleCount) &&
+				writer.Write(m_Settings.Bsp.SplitCandidates) &&
+				writer.Write(m_Settings.Bsp.SplitWeight) &&
+				writer.Write(m_Settings.Bsp.BalanceWeight) &&
+				writer.Write(m_Settings.Bsp.PlaneEpsilon) &&
+				writer.Write(m_Settings.Bsp.MaxDepth) &&
+				m_Bsp.Write(writer);
+
+			if (!written)
+			{
+				output.close();
+				std::filesystem::remove(temporaryPath, error);
+				FT_CORE_WARN("Unable to write BSP cache '{0}'.", cachePath.generic_string());
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporaryPath, cachePath, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+			FT_CORE_WARN("Unable to replace BSP cache '{0}'.", cachePath.generic_string());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool StaticWorld::LoadBspCache(const std::filesystem::path& cachePath, uint64_t sourceFingerprint)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		MappedFile file;
+		if (!file.Open(cachePath))
+			return false;
+
+		BinaryReader reader(file.GetData(), file.GetSize());
+		uint32_t magic = 0;
+		uint32_t formatVersion = 0;
+		uint32_t nodeSize = 0;
+		uint32_t leafSize = 0;
+		uint32_t statsSize = 0;
+		uint64_t cachedFingerprint = 0;
+		uint64_t cachedGeometryHash = 0;
+		uint32_t triangleCount = 0;
+		BspBuildSettings cachedSettings;
+		if (!reader.Read(magic) ||
+			!reader.Read(formatVersion) ||
+			!reader.Read(nodeSize) ||
+			!reader.Read(leafSize) ||
+			!reader.Read(statsSize) ||
+			!reader.Read(cachedFingerprint) ||
+			!reader.Read(cachedGeometryHash) ||
+			!reader.Read(triangleCount) ||
+			!reader.Read(cachedSettings.SplitCandidates) ||
+			!reader.Read(cachedSettings.SplitWeight) ||
+			!reader.Read(cachedSettings.BalanceWeight) ||
+			!reader.Read(cachedSettings.PlaneEpsilon) ||
+			!reader.Read(cachedSettings.MaxDepth))
+			return false;
+
+		if (magic != BspCacheMagic ||
+			formatVersion != BspCacheFormatVersion ||
+			nodeSize != sizeof(BspNode) ||
+			leafSize != sizeof(BspLeaf) ||
+			statsSize != sizeof(BspBuildStats) ||
+			cachedFingerprint != sourceFingerprint ||
+			triangleCount != m_IndexedTriangleCount ||
+			cachedGeometryHash != HashCollisionGeometry() ||
+			cachedSettings.SplitCandidates != m_Settings.Bsp.SplitCandidates ||
+			cachedSettings.SplitWeight != m_Settings.Bsp.SplitWeight ||
+			cachedSettings.BalanceWeight != m_Settings.Bsp.BalanceWeight ||
+			cachedSettings.PlaneEpsilon != m_Settings.Bsp.PlaneEpsilon ||
+			cachedSettings.MaxDepth != m_Settings.Bsp.MaxDepth)
+			return false;
+
+		BspTree bsp;
+		if (!bsp.Read(reader, triangleCount) || reader.GetRemaining() != 0)
+			return false;
+
+		m_Bsp = std::move(bsp);
+		m_BspTriangleCount = triangleCount;
+		m_BspLoadedFromCache = true;
+		UpdateBspStats();
+
+		const auto endTime = std::chrono::steady_clock::now();
+		FT_CORE_INFO(
+			"Loaded static world BSP for '{0}' from cache '{1}': {2} nodes, {3} leaves in {4:.2f} ms.",
+			m_SourceName,
+			cachePath.generic_string(),
+			m_AccelerationStats.BspNodes,
+			m_AccelerationStats.BspLeaves,
+			std::chrono::duration<float, std::milli>(endTime - startTime).count()
+		);
+		return true;
 	}
 
-	Ref<StaticWorld> StaticWorld::CreateFromModel(const Ref<Model>& model, const WorldTransform& transform)
+	Ref<StaticWorld> StaticWorld::CreateFromModel(const Ref<Model>& model, const WorldTransform& transform, const StaticWorldSettings& settings)
 	{
-		Ref<StaticWorld> world = CreateRef<StaticWorld>(model ? model->GetSourcePath() : "");
-		if (model)
-			world->AddModel(model, transform);
+		Ref<StaticWorld> world = CreateRef<StaticWorld>(model ? model->GetSourcePath() : "", settings);
+		if (!model)
+			return world;
+
+		// Models built in code have no fingerprint, so only imported models are cached.
+		const uint64_t sourceFingerprint = model->GetSourceFingerprint();
+		const bool useCache = settings.UseWorldCache && sourceFingerprint != 0 && !model->GetSourcePath().empty();
+		const std::filesystem::path cachePath = useCache ? GetWorldCachePath(model->GetSourcePath(), transform, settings) : std::filesystem::path();
+
+		// Surfaces always come from the model; a warm cache replaces only triangle extraction and the broad-phase build.
+		const uint32_t firstSurface = world->AppendSurfaces(model, transform);
+		if (useCache && world->LoadCache(cachePath, sourceFingerprint))
+		{
+			if (!settings.BuildBsp)
+				return world;
+
+			const std::filesystem::path bspCachePath = GetBspCachePath(cachePath, settings.Bsp);
+			if (world->LoadBspCache(bspCachePath, sourceFingerprint))
+				return world;
+
+			world->BuildBsp();
+			if (world->SaveBspCache(bspCachePath, sourceFingerprint))
+				FT_CORE_INFO("Wrote static world BSP cache for '{0}' to '{1}'.", world->GetSourceName(), bspCachePath.generic_string());
+			return world;
+		}
+
+		// Nothing streams in after this, so the BSP the settings ask for is compiled right away.
+		world->ExtractCollisionTriangles(firstSurface);
+		world->Finalize();
+		if (settings.VerifyBuild)
+			world->VerifyBuild(model, transform);
+		world->UpdateBsp();
+		if (useCache && world->SaveCache(cachePath, sourceFingerprint))
+			FT_CORE_INFO("Wrote static world cache for '{0}' to '{1}'.", world->GetSourceName(), cachePath.generic_string());
+
+		if (useCache && settings.BuildBsp)
+		{
+			const std::filesystem::path bspCachePath = GetBspCachePath(cachePath, settings.Bsp);
+			if (world->SaveBspCache(bspCachePath, sourceFingerprint))
+				FT_CORE_INFO("Wrote static world BSP cache for '{0}' to '{1}'.", world->GetSourceName(), bspCachePath.generic_string());
+		}
 
 		return world;
 	}
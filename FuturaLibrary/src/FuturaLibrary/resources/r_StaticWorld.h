@@ -5,29 +5,77 @@
  *
  *      @author:             Prince Pamintuan
  *      @date:               July 10, 2026
- *      Last Modified on:    July 10, 2026
+ *      Last Modified on:    October 18, 2026
  */
 
 #pragma once
 
 #include "FuturaLibrary/core/c_core.h"
+#include "FuturaLibrary/renderer/r_Frustum.h"
 #include "FuturaLibrary/renderer/r_Material.h"
 #include "FuturaLibrary/renderer/r_Mesh.h"
+#include "FuturaLibrary/resources/r_BoundingVolumeHierarchy.h"
+#include "FuturaLibrary/resources/r_BspTree.h"
 #include "FuturaLibrary/resources/r_Model.h"
+#include "FuturaLibrary/resources/r_PackedSpatialGrid.h"
 
 #include <glm/glm.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <filesystem>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace FuturaLibrary
 {
+	enum class WorldBroadPhase
+	{
+		SpatialGrid,
+		BoundingVolumeHierarchy
+	};
+
+	struct StaticWorldSettings
+	{
+		WorldBroadPhase BroadPhase = WorldBroadPhase::SpatialGrid;
+		// Worker threads for triangle extraction and grid construction; 0 uses every hardware core.
+		uint32_t BuildThreadCount = 0;
+		// Cell size of the finest grid level; 0 derives it from the median triangle extent on the first build.
+		float GridCellSize = 0.0f;
+		// Worker threads for batched queries such as ResolveAABBMovementBatch; 0 uses every hardware core.
+		uint32_t QueryThreadCount = 0;
+		// CreateFromModel reads and writes a .fworld cache beside the .fmodel cache for imported models.
+		bool UseWorldCache = true;
+		// Corners that round to the same point of a lattice this fine share one collision vertex, and a
+		// lattice point reached later joins a vertex within this distance in a neighbouring cell; 0 welds
+		// only identical positions.
+		float WeldTolerance = 0.0001f;
+		// Records the triangle across each collision edge, for contact code that needs to walk the surface.
+		bool BuildEdgeAdjacency = false;
+		// Collapses collision edges shorter than this distance, which closes needle slivers without holes,
+		// and merges coplanar neighbours into fewer triangles, keeping the result within about this distance
+		// of the source; 0 skips simplification.
+		float SimplifyTolerance = 0.0f;
+		// Compiles the collision triangles into a BSP tree for front-to-back surface order and solid
+		// queries. CreateFromModel keeps it in a .fbsp cache beside the .fworld cache.
+		bool BuildBsp = false;
+		BspBuildSettings Bsp;
+		// CreateFromModel checks a freshly extracted world against a serial build without caches and logs
+		// any difference. It costs a second build, so it is meant for tracking down build bugs.
+		bool VerifyBuild = false;
+	};
+
 	struct WorldTransform
 	{
 		glm::mat4 Matrix = glm::mat4(1.0f);
 	};
 
+	struct WorldModelPlacement
+	{
+		Ref<Model> ModelAsset;
+		WorldTransform Transform;
+	};
+
 	struct WorldMaterialRef
 	{
 		std::string Name;
@@ -47,6 +95,7 @@ namespace FuturaLibrary
 		AxisAlignedBounds WorldBounds;
 	};
 
+	// Full-precision collision triangle. The world stores CompactWorldTriangles and decodes these on demand.
 	struct WorldTriangle
 	{
 		glm::vec3 A = glm::vec3(0.0f);
@@ -57,6 +106,66 @@ namespace FuturaLibrary
 		uint32_t SourceSurfaceIndex = 0;
 	};
 
+	// Bounds of one decoded collision triangle, six packed floats for slab and overlap tests.
+	struct WorldTriangleBounds
+	{
+		float MinX = 0.0f;
+		float MinY = 0.0f;
+		float MinZ = 0.0f;
+		float MaxX = 0.0f;
+		float MaxY = 0.0f;
+		float MaxZ = 0.0f;
+	};
+
+	// A welded collision vertex on the 16-bit lattice of the block that owns it.
+	struct CompactWorldVertex
+	{
+		uint16_t X = 0;
+		uint16_t Y = 0;
+		uint16_t Z = 0;
+		uint16_t Reserved = 0;
+	};
+
+	// A collision triangle as three indices into the welded vertex array. Normals and bounds are
+	// recomputed from the decoded corners.
+	struct CompactWorldTriangle
+	{
+		uint32_t Indices[3] = {};
+		uint32_t BlockIndex = 0;
+	};
+
+	// Quantisation frame shared by a run of spatially sorted triangles from one surface and the vertices
+	// they use. Steps are powers of two and origins are multiples of them, so Origin + q * Step is exact
+	// in float. A vertex shared across a block boundary is stored once in each block, snapped to the
+	// coarsest of their lattices so every copy decodes to the same point.
+	struct CollisionTriangleBlock
+	{
+		float OriginX = 0.0f;
+		float OriginY = 0.0f;
+		float OriginZ = 0.0f;
+		float StepX = 1.0f;
+		float StepY = 1.0f;
+		float StepZ = 1.0f;
+		uint32_t SourceSurfaceIndex = 0;
+	};
+
+	// Collision triangles extracted from one surface. Extraction appends a surface's triangles together,
+	// so they always form one run.
+	struct SurfaceTriangleRange
+	{
+		uint32_t FirstTriangle = 0;
+		uint32_t TriangleCount = 0;
+	};
+
+	// The triangle across each edge, where edge i runs from corner i to corner i + 1. Open edges and
+	// edges shared by more than two triangles have no neighbour.
+	struct WorldTriangleAdjacency
+	{
+		static constexpr uint32_t NoNeighbor = 0xffffffffu;
+
+		uint32_t Neighbors[3] = { NoNeighbor, NoNeighbor, NoNeighbor };
+	};
+
 	struct WorldRaycastHit
 	{
 		bool Hit = false;
@@ -66,72 +175,305 @@ namespace FuturaLibrary
 		uint32_t SurfaceIndex = 0;
 	};
 
+	// Result of sweeping a box along a delta. Time is the fraction of the delta the box can travel
+	// while staying a small skin away from the first contact; RemainingDelta is the rest of the
+	// delta with the component into the contact normal removed, ready for the next slide step.
+	struct WorldSweepHit
+	{
+		bool Hit = false;
+		float Time = 1.0f;
+		glm::vec3 Normal = glm::vec3(0.0f, 1.0f, 0.0f);
+		glm::vec3 RemainingDelta = glm::vec3(0.0f);
+		uint32_t SurfaceIndex = 0;
+	};
+
+	struct WorldRayPacket;
+
+	struct WorldRay
+	{
+		glm::vec3 Origin = glm::vec3(0.0f);
+		glm::vec3 Direction = glm::vec3(0.0f, 0.0f, -1.0f);
+		float MaxDistance = 0.0f;
+	};
+
 	struct CollisionQueryStats
 	{
 		float CollisionTimeMs = 0.0f;
+		// Worlds a scene-level query passed to their own broad phase after the top-level cull.
+		uint32_t CandidateWorlds = 0;
 		uint32_t BroadPhaseQueries = 0;
 		uint32_t CandidateSurfaces = 0;
 		uint32_t CandidateTriangles = 0;
 		uint32_t NarrowPhaseTests = 0;
+		uint32_t NarrowPhaseBatches = 0;
 		uint32_t ContactsGenerated = 0;
+		uint32_t SweepQueries = 0;
+		uint32_t ClosestFeatureTests = 0;
+		uint32_t OcclusionQueries = 0;
+		uint32_t OcclusionTests = 0;
+		uint32_t OccludedRays = 0;
+		// QueryCollisionTriangles calls that reused their context's previous grid candidates, and those that walked the grid.
+		uint32_t QueryCacheHits = 0;
+		uint32_t QueryCacheMisses = 0;
+		uint32_t MovementBatches = 0;
+		uint32_t BatchedMovers = 0;
+		// Summed over batches, so with several workers it can exceed the wall-clock CollisionTimeMs.
+		float MovementBatchTimeMs = 0.0f;
+	};
+
+	// Scratch buffers and de-duplication stamps for one caller of StaticWorld queries.
+	// Give each thread or job its own context and queries on a shared world need no locks.
+	// A context can be reused across worlds; its buffers grow to the largest world queried.
+	struct WorldQueryContext
+	{
+		std::vector<uint32_t> CollisionCandidates;
+		std::vector<uint32_t> CollisionMarks;
+		std::vector<uint32_t> SurfaceMarks;
+		uint32_t CollisionStamp = 0;
+		uint32_t SurfaceStamp = 0;
+		// Grid candidates of the last query and the base-level cell range they cover. A following query
+		// over the same cells of the same grid, like a camera idling in place, copies them instead.
+		std::vector<uint32_t> CachedCandidates;
+		glm::ivec3 CachedCellMin = glm::ivec3(0);
+		glm::ivec3 CachedCellMax = glm::ivec3(0);
+		uint32_t CachedCandidateSurfaces = 0;
+		uint64_t CachedGridVersion = 0;
+		// SurfaceMarks values left by MarkVisibleSurfaces: accepted whole, or still to be tested.
+		uint32_t FrustumAcceptStamp = 0;
+		uint32_t FrustumTestStamp = 0;
 	};
 
 	struct WorldAccelerationStats
 	{
+		WorldBroadPhase BroadPhase = WorldBroadPhase::SpatialGrid;
+		// Placements of shared worlds in a scene; every other counter covers each unique world once.
+		uint32_t WorldInstances = 0;
+		uint32_t UniqueWorlds = 0;
 		float CellSize = 0.0f;
+		uint32_t GridLevels = 0;
 		uint32_t OccupiedCells = 0;
+		uint64_t GridMemoryBytes = 0;
+		uint64_t UnpackedGridMemoryBytes = 0;
 		uint32_t IndexedSurfaces = 0;
 		uint32_t IndexedTriangles = 0;
+		// Triangles extracted from the source meshes, how many coplanar merges removed, and how many slivers
+		// edge collapses left with zero area.
+		uint32_t SourceTriangles = 0;
+		uint32_t MergedTriangles = 0;
+		uint32_t SliverTriangles = 0;
+		uint32_t CollisionVertices = 0;
+		uint64_t CollisionMemoryBytes = 0;
+		// What the same triangles would take as WorldTriangles with separate bounds records.
+		uint64_t UncompressedCollisionMemoryBytes = 0;
+		uint32_t BVHNodes = 0;
+		uint32_t BVHLeaves = 0;
+		uint32_t BVHMaxDepth = 0;
+		float BuildTimeMs = 0.0f;
+		bool LoadedFromCache = false;
+		// Zero unless StaticWorldSettings::BuildBsp is set. The build time is the original compile, even
+		// when the tree came from its cache.
+		uint32_t BspNodes = 0;
+		uint32_t BspLeaves = 0;
+		uint32_t BspSolidLeaves = 0;
+		uint32_t BspMaxDepth = 0;
+		float BspBuildTimeMs = 0.0f;
+		bool BspLoadedFromCache = false;
 	};
 
 	class FT_API StaticWorld
 	{
 	public:
 		StaticWorld() = default;
-		explicit StaticWorld(const std::string& sourceName);
+		explicit StaticWorld(const std::string& sourceName, const StaticWorldSettings& settings = {});
 
 		void AddModel(const Ref<Model>& model, const WorldTransform& transform = {});
+		// Stages models without touching the broad phase. Queries ignore staged geometry until
+		// Finalize() indexes it; on the grid only the staged triangles are inserted.
+		void AddModels(const std::vector<WorldModelPlacement>& models);
+		void Finalize();
+		void SetBroadPhase(WorldBroadPhase broadPhase);
 
 		const std::string& GetSourceName() const { return m_SourceName; }
 		const WorldTransform& GetTransform() const { return m_Transform; }
+		const StaticWorldSettings& GetSettings() const { return m_Settings; }
+		WorldBroadPhase GetBroadPhase() const { return m_Settings.BroadPhase; }
 		const std::vector<WorldSurface>& GetSurfaces() const { return m_Surfaces; }
+		// Every surface's world bounds in structure-of-arrays form, indexed like GetSurfaces().
+		const BoundsArrays& GetSurfaceBounds() const { return m_SurfaceBounds; }
 		const std::vector<WorldMaterialRef>& GetMaterials() const { return m_Materials; }
-		const std::vector<WorldTriangle>& GetCollisionTriangles() const { return m_CollisionTriangles; }
+		uint32_t GetCollisionTriangleCount() const { return static_cast<uint32_t>(m_CollisionTriangles.size()); }
+		// Decodes one collision triangle, recomputing its normal and bounds.
+		WorldTriangle GetCollisionTriangle(uint32_t triangleIndex) const;
+		const CompactWorldTriangle& GetCompactCollisionTriangle(uint32_t triangleIndex) const { return m_CollisionTriangles[triangleIndex]; }
+		// Corners only, skipping the normal and bounds GetCollisionTriangle recomputes.
+		void GetCollisionTriangleCorners(uint32_t triangleIndex, glm::vec3& a, glm::vec3& b, glm::vec3& c) const;
+		// Empty for surfaces without collision geometry and for surfaces added since the last build.
+		SurfaceTriangleRange GetSurfaceTriangleRange(uint32_t surfaceIndex) const
+		{
+			return surfaceIndex < m_SurfaceTriangleRanges.size() ? m_SurfaceTriangleRanges[surfaceIndex] : SurfaceTriangleRange{};
+		}
+		uint32_t GetCollisionVertexCount() const { return static_cast<uint32_t>(m_CollisionVertices.size()); }
+		// Farthest a decoded collision corner can sit from the source geometry: the coarsest block's
+		// rounding plus the weld and simplify distances. Occluder rasterization pushes depth back by it.
+		float GetCollisionErrorBound() const { return m_CollisionErrorBound; }
+		// Empty unless StaticWorldSettings::BuildEdgeAdjacency was set; otherwise one entry per triangle.
+		const std::vector<WorldTriangleAdjacency>& GetCollisionTriangleAdjacency() const { return m_CollisionTriangleAdjacency; }
 		const AxisAlignedBounds& GetLocalBounds() const { return m_LocalBounds; }
 		const AxisAlignedBounds& GetWorldBounds() const { return m_WorldBounds; }
 		const WorldAccelerationStats& GetAccelerationStats() const { return m_AccelerationStats; }
+		// Empty unless StaticWorldSettings::BuildBsp was set. Its IsPointSolid and Trace answer solid
+		// queries in world space; triangle indices in its leaves are collision triangle indices.
+		// Finalize leaves the tree stale instead of recompiling it for every streamed chunk; the first
+		// BSP query after new triangles were indexed compiles it under a lock, as does UpdateBsp.
+		const BspTree& GetBsp() const;
+		// Compiles the BSP from the indexed collision triangles now, whatever the settings say.
+		void BuildBsp();
+		// Recompiles a stale BSP and refreshes its counters in the acceleration stats. Call once
+		// streaming settles so the first query does not pay for the compile.
+		void UpdateBsp();
 		bool IsEmpty() const { return m_Surfaces.empty(); }
 		bool HasCollisionMesh() const { return !m_CollisionTriangles.empty(); }
+		bool HasPendingGeometry() const { return m_IndexedSurfaceCount != m_Surfaces.size() || m_IndexedTriangleCount != m_CollisionTriangles.size(); }
 
+		// Queries without a context share the world's default scratch and must stay on one thread.
+		// The overloads taking a WorldQueryContext are safe to call concurrently, one context per caller.
 		WorldRaycastHit Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+		WorldRaycastHit Raycast(WorldQueryContext& context, const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+		// Yes/no visibility test: returns at the first confirmed intersection and skips hit bookkeeping.
+		bool Occluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, CollisionQueryStats* stats = nullptr) const;
+		bool Occluded(WorldQueryContext& context, const glm::vec3& origin, const glm::vec3& direction, float maxDistance, CollisionQueryStats* stats = nullptr) const;
+		// Rays are traced in SIMD-width packets of consecutive entries, so callers should keep
+		// coherent rays (shared origin, similar direction) next to each other in the array.
+		void RaycastBatch(const std::vector<WorldRay>& rays, std::vector<WorldRaycastHit>& hits) const;
+		void RaycastBatch(WorldQueryContext& context, const std::vector<WorldRay>& rays, std::vector<WorldRaycastHit>& hits) const;
 		glm::vec3 ResolveAABBMovement(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& desiredDelta, CollisionQueryStats* stats = nullptr) const;
+		glm::vec3 ResolveAABBMovement(WorldQueryContext& context, const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& desiredDelta, CollisionQueryStats* stats = nullptr) const;
+		// Resolves many boxes at once with the same per-box result as ResolveAABBMovement. Movers are
+		// grouped by the grid cell of their own move box, each group shares one broad-phase query, and
+		// groups run on worker threads. Workers use per-thread scratch, so batches may run concurrently.
+		void ResolveAABBMovementBatch(
+			const std::vector<glm::vec3>& centers,
+			const std::vector<glm::vec3>& halfExtents,
+			const std::vector<glm::vec3>& desiredDeltas,
+			std::vector<glm::vec3>& resolvedDeltas,
+			CollisionQueryStats* stats = nullptr) const;
+		// Continuous test: one broad-phase query over the swept volume, then a slab sweep against
+		// each candidate's bounds. Boxes already deeper than the skin inside a candidate ignore it so they can escape.
+		WorldSweepHit SweepAABB(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& delta, CollisionQueryStats* stats = nullptr) const;
+		WorldSweepHit SweepAABB(WorldQueryContext& context, const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& delta, CollisionQueryStats* stats = nullptr) const;
+		// Exact shape sweeps against the collision triangles, sharing SweepAABB's broad phase and result.
+		// The capsule is the segment [segmentStart, segmentEnd] grown by radius; a sphere is a zero-length capsule.
+		// A segment that already touches a triangle hits it at once when moving into its face.
+		WorldSweepHit SweepSphere(const glm::vec3& center, float radius, const glm::vec3& delta, CollisionQueryStats* stats = nullptr) const;
+		WorldSweepHit SweepSphere(WorldQueryContext& context, const glm::vec3& center, float radius, const glm::vec3& delta, CollisionQueryStats* stats = nullptr) const;
+		WorldSweepHit SweepCapsule(const glm::vec3& segmentStart, const glm::vec3& segmentEnd, float radius, const glm::vec3& delta, CollisionQueryStats* stats = nullptr) const;
+		WorldSweepHit SweepCapsule(WorldQueryContext& context, const glm::vec3& segmentStart, const glm::vec3& segmentEnd, float radius, const glm::vec3& delta, CollisionQueryStats* stats = nullptr) const;
 		void QuerySurfaces(const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates) const;
+		void QuerySurfaces(WorldQueryContext& context, const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates) const;
+		// Surfaces that may intersect a frustum given in this world's space, in surface order. Grid cells,
+		// walked as the octree their Morton keys form, or BVH nodes are rejected or accepted whole first;
+		// only surfaces in cells that straddle a plane are tested on their own bounds.
+		void QueryVisibleSurfaces(const Frustum& frustum, std::vector<uint32_t>& visibleSurfaces, FrustumCullStats* stats = nullptr) const;
+		void QueryVisibleSurfaces(WorldQueryContext& context, const Frustum& frustum, std::vector<uint32_t>& visibleSurfaces, FrustumCullStats* stats = nullptr) const;
+		// QueryVisibleSurfaces in two steps, so the per-surface work can be split across jobs. Marking
+		// walks the cells or nodes once into the context; collecting then reads the marks of any surface
+		// range and appends its visible surfaces in order. Collect calls only read the context, so
+		// several may run at once over disjoint ranges after the mark call has returned.
+		void MarkVisibleSurfaces(WorldQueryContext& context, const Frustum& frustum, FrustumCullStats* stats = nullptr) const;
+		void CollectVisibleSurfaces(const WorldQueryContext& context, const Frustum& frustum, uint32_t firstSurface, uint32_t surfaceCount, std::vector<uint32_t>& visibleSurfaces, FrustumCullStats* stats = nullptr) const;
+		// Surfaces with collision triangles, ordered by the first BSP leaf holding one of their triangles
+		// as the leaves are walked front to back from eye. Empty when no BSP has been built.
+		void QuerySurfacesFrontToBack(const glm::vec3& eye, std::vector<uint32_t>& surfaces) const;
+		void QuerySurfacesFrontToBack(WorldQueryContext& context, const glm::vec3& eye, std::vector<uint32_t>& surfaces) const;
 
-		static Ref<StaticWorld> CreateFromModel(const Ref<Model>& model, const WorldTransform& transform = {});
+		static Ref<StaticWorld> CreateFromModel(const Ref<Model>& model, const WorldTransform& transform = {}, const StaticWorldSettings& settings = {});
 
 	private:
-		struct SpatialCell
-		{
-			std::vector<uint32_t> Surfaces;
-			std::vector<uint32_t> CollisionTriangles;
-		};
+		// Level L of the grid uses cells 2^L times the base size; each triangle lives on the
+		// finest level whose cells are at least as large as its longest bounds axis.
+		static constexpr uint32_t MaxSpatialGridLevels = 12;
+
+		void AppendModel(const Ref<Model>& model, const WorldTransform& transform);
+		uint32_t AppendSurfaces(const Ref<Model>& model, const WorldTransform& transform);
+		void ExtractCollisionTriangles(uint32_t firstSurface);
+		void DecodeTriangleCorners(uint32_t triangleIndex, WorldTriangle& triangle) const;
+		WorldTriangleBounds DecodeTriangleBounds(uint32_t triangleIndex) const;
+		uint32_t GetTriangleSurface(uint32_t triangleIndex) const { return m_CollisionTriangleBlocks[m_CollisionTriangles[triangleIndex].BlockIndex].SourceSurfaceIndex; }
+		void UpdateCollisionMemoryStats();
+		void UpdateCollisionErrorBound();
+		void BuildAccelerationStructure();
+		void UpdateAccelerationStructure();
+		void BuildSpatialGrid(uint32_t firstTriangle);
+		void UpdateSpatialGridStats();
+		void ChooseSpatialGridCellSize(uint32_t firstTriangle);
+		float GetSpatialGridLevelCellSize(uint32_t level) const;
+		uint32_t SelectSpatialGridLevel(const AxisAlignedBounds& bounds) const;
+		void BuildBoundingVolumeHierarchy();
+		void UpdateBVHStats();
+		// Fills the ranges of surfaces from firstSurface on by scanning triangles from firstTriangle on.
+		void UpdateSurfaceTriangleRanges(uint32_t firstSurface, uint32_t firstTriangle);
+		void ResetQueryScratch();
+		// The cache holds the world-space triangles and the finished broad phase for one model placement.
+		bool SaveCache(const std::filesystem::path& cachePath, uint64_t sourceFingerprint) const;
+		bool LoadCache(const std::filesystem::path& cachePath, uint64_t sourceFingerprint);
+		// The BSP cache is keyed on the collision geometry it was compiled from, so it survives only
+		// as long as the triangles it indexes.
+		bool SaveBspCache(const std::filesystem::path& cachePath, uint64_t sourceFingerprint) const;
+		bool LoadBspCache(const std::filesystem::path& cachePath, uint64_t sourceFingerprint);
+		uint64_t HashCollisionGeometry() const;
+		// Logs where this world differs from the same placement built serially without caches, where its
+		// SIMD narrow phase disagrees with scalar bounds tests on the same probes, and where packet
+		// raycasts stop at a different distance from single rays.
+		void VerifyBuild(const Ref<Model>& model, const WorldTransform& transform) const;
+		void UpdateBspStats();
+		// Called with m_BspMutex held.
+		bool IsBspStale() const;
+		void CompileBsp() const;
+		void EnsureBspCompiled() const;
+		uint32_t BeginCollisionQuery(WorldQueryContext& context) const;
+		uint32_t BeginSurfaceQuery(WorldQueryContext& context) const;
+		void BeginFrustumQuery(WorldQueryContext& context) const;
+		void QueryCollisionTriangles(WorldQueryContext& context, const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates, CollisionQueryStats* stats = nullptr) const;
+		uint32_t CountCandidateSurfaces(WorldQueryContext& context, const std::vector<uint32_t>& triangles) const;
+
+		bool TraceRayPacket(WorldQueryContext& context, WorldRayPacket& packet, const AxisAlignedBounds& packetBounds, bool mixedDirections) const;
 
-		void ExtractCollisionTriangles(const WorldSurface& surface);
-		void BuildSpatialGrid();
-		void QueryCollisionTriangles(const AxisAlignedBounds& bounds, std::vector<uint32_t>& candidates, CollisionQueryStats* stats = nullptr) const;
+		template <typename TriangleFunction>
+		void TraverseSpatialGridRay(WorldQueryContext& context, const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleFunction&& triangleFunction) const;
 
 		std::string m_SourceName;
+		StaticWorldSettings m_Settings;
 		WorldTransform m_Transform;
 		std::vector<WorldSurface> m_Surfaces;
+		BoundsArrays m_SurfaceBounds;
 		std::vector<WorldMaterialRef> m_Materials;
-		std::vector<WorldTriangle> m_CollisionTriangles;
-		std::unordered_map<int64_t, SpatialCell> m_SpatialGrid;
-		mutable std::vector<uint32_t> m_CollisionQueryCandidates;
-		mutable std::vector<uint32_t> m_CollisionQueryMarks;
-		mutable std::vector<uint32_t> m_SurfaceQueryMarks;
-		mutable uint32_t m_CollisionQueryStamp = 1;
-		mutable uint32_t m_SurfaceQueryStamp = 1;
-		float m_SpatialGridCellSize = 8.0f;
+		std::vector<CompactWorldVertex> m_CollisionVertices;
+		std::vector<CompactWorldTriangle> m_CollisionTriangles;
+		std::vector<CollisionTriangleBlock> m_CollisionTriangleBlocks;
+		std::vector<WorldTriangleAdjacency> m_CollisionTriangleAdjacency;
+		std::array<PackedSpatialGrid, MaxSpatialGridLevels> m_SpatialGridLevels;
+		uint32_t m_SpatialGridLevelMask = 0;
+		// Unique across every world and rebuild, so a context's cached candidates never match another grid.
+		uint64_t m_SpatialGridVersion = 0;
+		BoundingVolumeHierarchy m_CollisionBVH;
+		// Compiled lazily by const queries, so guarded by m_BspMutex.
+		mutable std::mutex m_BspMutex;
+		mutable BspTree m_Bsp;
+		// Collision triangles the BSP was compiled over, so a broad-phase rebuild can keep it.
+		mutable uint32_t m_BspTriangleCount = 0;
+		mutable bool m_BspLoadedFromCache = false;
+		uint32_t m_IndexedSurfaceCount = 0;
+		// Indexed surfaces that own no collision triangle, so no cell or node reaches them; frustum
+		// queries test these on their own bounds.
+		std::vector<uint32_t> m_UncoveredSurfaces;
+		std::vector<SurfaceTriangleRange> m_SurfaceTriangleRanges;
+		uint32_t m_IndexedTriangleCount = 0;
+		uint32_t m_SourceTriangleCount = 0;
+		uint32_t m_MergedTriangleCount = 0;
+		uint32_t m_SliverTriangleCount = 0;
+		float m_CollisionErrorBound = 0.0f;
+		mutable WorldQueryContext m_DefaultQueryContext;
+		float m_SpatialGridCellSize = 0.0f;
 		WorldAccelerationStats m_AccelerationStats;
 		AxisAlignedBounds m_LocalBounds;
 		AxisAlignedBounds m_WorldBounds;
@@ -0,0 +1,170 @@
+/**
+ *  @file u_BinaryStream.h
+ *
+ *  @brief Declares small binary writer and reader helpers for versioned cache files.
+ *
+ *  BinaryWriter appends raw values and length-prefixed arrays to a file stream.
+ *  BinaryReader walks a byte range, usually a MappedFile, and reports failure
+ *  instead of reading past the end, so truncated caches are rejected cleanly.
+ *  Aligned arrays can be read as spans into the range without copying them.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace FuturaLibrary
+{
+	// Data handed to BinaryReader must start on this boundary for ReadSpan; a MappedFile starts on a page.
+	inline constexpr size_t MaxArrayAlignment = 16;
+
+	class BinaryWriter
+	{
+	public:
+		explicit BinaryWriter(std::ofstream& output)
+			: m_Output(output)
+		{
+		}
+
+		template <typename T>
+		bool Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter only writes trivially copyable values.");
+			m_Output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+			return m_Output.good();
+		}
+
+		// Writes a 64-bit element count followed by the elements as one block.
+		template <typename T>
+		bool WriteArray(const std::vector<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter only writes trivially copyable values.");
+			if (!Write(static_cast<uint64_t>(values.size())))
+				return false;
+
+			if (!values.empty())
+				m_Output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+			return m_Output.good();
+		}
+
+		// Like WriteArray, but zero-pads after the count so the elements start at a multiple of alignof(T)
+		// from the start of the file. BinaryReader::ReadSpan reads them back in place.
+		template <typename T>
+		bool WriteAlignedArray(const std::vector<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter only writes trivially copyable values.");
+			static_assert(alignof(T) <= MaxArrayAlignment, "BinaryWriter pads to at most MaxArrayAlignment bytes.");
+			if (!Write(static_cast<uint64_t>(values.size())))
+				return false;
+
+			const std::streamoff position = m_Output.tellp();
+			if (position < 0)
+				return false;
+
+			static constexpr char padding[MaxArrayAlignment] = {};
+			m_Output.write(padding, static_cast<std::streamsize>((alignof(T) - static_cast<size_t>(position) % alignof(T)) % alignof(T)));
+			if (!values.empty())
+				m_Output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+			return m_Output.good();
+		}
+
+		bool WriteString(const std::string& value)
+		{
+			if (!Write(static_cast<uint64_t>(value.size())))
+				return false;
+
+			m_Output.write(value.data(), static_cast<std::streamsize>(value.size()));
+			return m_Output.good();
+		}
+
+	private:
+		std::ofstream& m_Output;
+	};
+
+	class BinaryReader
+	{
+	public:
+		BinaryReader(const uint8_t* data, size_t size)
+			: m_Data(data), m_Size(data ? size : 0)
+		{
+		}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryReader only reads trivially copyable values.");
+			if (GetRemaining() < sizeof(T))
+				return false;
+
+			std::memcpy(&value, m_Data + m_Offset, sizeof(T));
+			m_Offset += sizeof(T);
+			return true;
+		}
+
+		// Rejects counts that would run past the end of the data before allocating anything.
+		template <typename T>
+		bool ReadArray(std::vector<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryReader only reads trivially copyable values.");
+			uint64_t count = 0;
+			if (!Read(count) || count > GetRemaining() / sizeof(T))
+				return false;
+
+			values.resize(static_cast<size_t>(count));
+			if (count > 0)
+				std::memcpy(values.data(), m_Data + m_Offset, static_cast<size_t>(count) * sizeof(T));
+			m_Offset += static_cast<size_t>(count) * sizeof(T);
+			return true;
+		}
+
+		// Reads an array written by WriteAlignedArray as a view into the data, which must outlive the span.
+		template <typename T>
+		bool ReadSpan(std::span<const T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryReader only reads trivially copyable values.");
+			static_assert(alignof(T) <= MaxArrayAlignment, "BinaryReader aligns to at most MaxArrayAlignment bytes.");
+			uint64_t count = 0;
+			if (!Read(count))
+				return false;
+
+			const size_t padding = (alignof(T) - m_Offset % alignof(T)) % alignof(T);
+			if (GetRemaining() < padding || count > (GetRemaining() - padding) / sizeof(T) ||
+				reinterpret_cast<uintptr_t>(m_Data) % MaxArrayAlignment != 0)
+				return false;
+
+			m_Offset += padding;
+			values = std::span<const T>(reinterpret_cast<const T*>(m_Data + m_Offset), static_cast<size_t>(count));
+			m_Offset += static_cast<size_t>(count) * sizeof(T);
+			return true;
+		}
+
+		bool ReadString(std::string& value)
+		{
+			uint64_t length = 0;
+			if (!Read(length) || length > GetRemaining())
+				return false;
+
+			value.assign(reinterpret_cast<const char*>(m_Data + m_Offset), static_cast<size_t>(length));
+			m_Offset += static_cast<size_t>(length);
+			return true;
+		}
+
+		size_t GetOffset() const { return m_Offset; }
+		size_t GetRemaining() const { return m_Size - m_Offset; }
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		size_t m_Offset = 0;
+	};
+}
@@ -0,0 +1,116 @@
+/**
+ *  @file u_MappedFile.cpp
+ *
+ *  @brief Implements MappedFile with file mappings on Windows and mmap on Linux.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#include "pch.h"
+#include "u_MappedFile.h"
+
+#if defined(FT_PLATFORM_LINUX)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace FuturaLibrary
+{
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+#ifdef FT_PLATFORM_WINDOWS
+	bool MappedFile::Open(const std::filesystem::path& path)
+	{
+		Close();
+
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize = {};
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_Data = static_cast<const uint8_t*>(data);
+		m_Size = static_cast<size_t>(fileSize.QuadPart);
+		m_FileHandle = file;
+		m_MappingHandle = mapping;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle)
+			CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+		if (m_FileHandle)
+			CloseHandle(static_cast<HANDLE>(m_FileHandle));
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_FileHandle = nullptr;
+		m_MappingHandle = nullptr;
+	}
+#elif defined(FT_PLATFORM_LINUX)
+	bool MappedFile::Open(const std::filesystem::path& path)
+	{
+		Close();
+
+		const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file < 0)
+			return false;
+
+		struct stat fileStatus = {};
+		if (fstat(file, &fileStatus) != 0 || fileStatus.st_size <= 0)
+		{
+			close(file);
+			return false;
+		}
+
+		// The mapping keeps its own reference to the file, so the descriptor can be closed right away.
+		void* data = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (data == MAP_FAILED)
+			return false;
+
+		m_Data = static_cast<const uint8_t*>(data);
+		m_Size = static_cast<size_t>(fileStatus.st_size);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			munmap(const_cast<uint8_t*>(m_Data), m_Size);
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+#endif
+}
@@ -0,0 +1,46 @@
+/**
+ *  @file u_MappedFile.h
+ *
+ *  @brief Declares a read-only memory-mapped file.
+ *
+ *  Pages are faulted in by the OS as they are touched, so opening a large cache
+ *  costs one system call and readers only pay for the bytes they actually use.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include "FuturaLibrary/core/c_core.h"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace FuturaLibrary
+{
+	class FT_API MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Empty or missing files fail to open; the previous mapping, if any, is released first.
+		bool Open(const std::filesystem::path& path);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+	};
+}
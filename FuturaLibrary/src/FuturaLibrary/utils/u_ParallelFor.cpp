@@ -0,0 +1,107 @@
+/**
+ *  @file u_ParallelFor.cpp
+ *
+ *  @brief Implements the persistent WorkerPool behind ParallelForChunks.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#include "pch.h"
+#include "u_ParallelFor.h"
+
+namespace FuturaLibrary
+{
+	WorkerPool& WorkerPool::Get()
+	{
+		static WorkerPool s_Pool;
+		return s_Pool;
+	}
+
+	WorkerPool::WorkerPool()
+	{
+		const uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		m_Workers.reserve(hardwareThreads - 1);
+		for (uint32_t i = 1; i < hardwareThreads; i++)
+			m_Workers.emplace_back([this]() { WorkerLoop(); });
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+		}
+
+		m_WorkAvailable.notify_all();
+		for (std::thread& worker : m_Workers)
+			worker.join();
+	}
+
+	bool WorkerPool::ClaimTask(Batch& batch, uint32_t& taskIndex)
+	{
+		if (batch.NextTask >= batch.TaskCount)
+			return false;
+
+		taskIndex = batch.NextTask++;
+		// The last claim takes the batch out of the queue, so no thread looks at it again.
+		if (batch.NextTask == batch.TaskCount)
+			m_Batches.erase(std::find(m_Batches.begin(), m_Batches.end(), &batch));
+		return true;
+	}
+
+	void WorkerPool::Run(uint32_t taskCount, TaskFunction task, void* userData)
+	{
+		if (taskCount == 0)
+			return;
+
+		Batch batch;
+		batch.Task = task;
+		batch.UserData = userData;
+		batch.TaskCount = taskCount;
+		batch.PendingTasks = taskCount;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Batches.push_back(&batch);
+		if (taskCount > 2)
+			m_WorkAvailable.notify_all();
+		else
+			m_WorkAvailable.notify_one();
+
+		// The batch lives on this stack frame, so the caller works through it too and only returns
+		// after the last task, wherever it ran, has reported back under the lock.
+		uint32_t taskIndex = 0;
+		while (ClaimTask(batch, taskIndex))
+		{
+			lock.unlock();
+			task(userData, taskIndex);
+			lock.lock();
+			batch.PendingTasks--;
+		}
+
+		m_BatchFinished.wait(lock, [&batch]() { return batch.PendingTasks == 0; });
+	}
+
+	void WorkerPool::WorkerLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		while (true)
+		{
+			m_WorkAvailable.wait(lock, [this]() { return m_Stopping || !m_Batches.empty(); });
+			if (m_Stopping)
+				return;
+
+			Batch& batch = *m_Batches.front();
+			uint32_t taskIndex = 0;
+			if (!ClaimTask(batch, taskIndex))
+				continue;
+
+			lock.unlock();
+			batch.Task(batch.UserData, taskIndex);
+			lock.lock();
+			if (--batch.PendingTasks == 0)
+				m_BatchFinished.notify_all();
+		}
+	}
+}
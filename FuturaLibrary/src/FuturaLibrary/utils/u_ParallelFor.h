@@ -0,0 +1,107 @@
+/**
+ *  @file u_ParallelFor.h
+ *
+ *  @brief Declares a persistent worker pool and a fork-join helper that splits an index range across it.
+ *
+ *  Chunk boundaries depend only on the item and chunk counts, never on thread
+ *  timing. Callers that write one output per chunk and merge the outputs in
+ *  chunk order therefore get the same result on every run and every machine.
+ *  The pool's threads start once and sleep between jobs, so per-frame work
+ *  does not pay for thread creation.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include "FuturaLibrary/core/c_core.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FuturaLibrary
+{
+	// One thread per hardware core minus the caller, started on first use and joined at exit.
+	// Run may be called from several threads at once and from inside a running task: the caller
+	// claims tasks of its own batch too, so a batch always finishes even when every worker is busy.
+	class FT_API WorkerPool
+	{
+	public:
+		using TaskFunction = void (*)(void* userData, uint32_t taskIndex);
+
+		static WorkerPool& Get();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		// Calls task(userData, i) once for every i in [0, taskCount) and returns when all have finished.
+		void Run(uint32_t taskCount, TaskFunction task, void* userData);
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+	private:
+		struct Batch
+		{
+			TaskFunction Task = nullptr;
+			void* UserData = nullptr;
+			uint32_t TaskCount = 0;
+			uint32_t NextTask = 0;
+			uint32_t PendingTasks = 0;
+		};
+
+		WorkerPool();
+		~WorkerPool();
+
+		// Called with m_Mutex held; returns false once every task of the batch has been handed out.
+		bool ClaimTask(Batch& batch, uint32_t& taskIndex);
+		void WorkerLoop();
+
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		std::condition_variable m_BatchFinished;
+		// Batches with unclaimed tasks, oldest first.
+		std::deque<Batch*> m_Batches;
+		std::vector<std::thread> m_Workers;
+		bool m_Stopping = false;
+	};
+
+	// requestedThreads == 0 means one thread per hardware core.
+	inline uint32_t GetParallelChunkCount(size_t itemCount, size_t minItemsPerChunk, uint32_t requestedThreads = 0)
+	{
+		uint32_t threadCount = requestedThreads > 0 ? requestedThreads : std::thread::hardware_concurrency();
+		threadCount = std::max(threadCount, 1u);
+
+		const size_t usefulChunks = std::max<size_t>(itemCount / std::max<size_t>(minItemsPerChunk, 1), 1);
+		return static_cast<uint32_t>(std::min<size_t>(threadCount, usefulChunks));
+	}
+
+	// Calls chunkFunction(chunkIndex, begin, end) for chunkCount contiguous slices of [0, itemCount) on
+	// the worker pool; the call returns once every chunk has finished. A single chunk runs inline on
+	// the calling thread. Otherwise any chunk may run on any thread, including the caller.
+	template <typename ChunkFunction>
+	void ParallelForChunks(size_t itemCount, uint32_t chunkCount, ChunkFunction&& chunkFunction)
+	{
+		chunkCount = std::max(chunkCount, 1u);
+		if (chunkCount == 1)
+		{
+			chunkFunction(0u, static_cast<size_t>(0), itemCount);
+			return;
+		}
+
+		auto runChunk = [&chunkFunction, itemCount, chunkCount](uint32_t chunkIndex)
+		{
+			chunkFunction(chunkIndex, itemCount * chunkIndex / chunkCount, itemCount * (chunkIndex + 1) / chunkCount);
+		};
+
+		WorkerPool::Get().Run(chunkCount, [](void* userData, uint32_t chunkIndex)
+		{
+			(*static_cast<decltype(runChunk)*>(userData))(chunkIndex);
+		}, &runChunk);
+	}
+}
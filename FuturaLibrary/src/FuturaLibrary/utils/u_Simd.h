@@ -0,0 +1,282 @@
+/**
+ *  @file u_Simd.h
+ *
+ *  @brief Declares a thin float-lane wrapper over AVX2, SSE2, or plain scalar code.
+ *
+ *  Collision and culling kernels are written once against SimdFloat. The lane
+ *  count is fixed at compile time: 8 when the build targets AVX2 (/arch:AVX2 or
+ *  -mavx2), 4 with SSE2 (every x64 build), and a 4-lane scalar fallback
+ *  otherwise. Define FT_DISABLE_SIMD to force the scalar path when checking
+ *  that both paths produce the same answers.
+ *
+ *      @author:             Prince Pamintuan
+ *      @date:               October 18, 2026
+ *      Last Modified on:    October 18, 2026
+ */
+
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(FT_DISABLE_SIMD)
+	#if defined(__AVX2__)
+		#define FT_SIMD_AVX2
+		#include <immintrin.h>
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define FT_SIMD_SSE
+		#include <emmintrin.h>
+	#endif
+#endif
+
+namespace FuturaLibrary
+{
+#if defined(FT_SIMD_AVX2)
+	constexpr uint32_t SimdWidth = 8;
+
+	struct SimdFloat
+	{
+		__m256 Value;
+	};
+
+	inline SimdFloat SimdSet(float value) { return { _mm256_set1_ps(value) }; }
+	inline SimdFloat SimdSetBits(uint32_t bits) { return { _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(bits))) }; }
+	inline SimdFloat SimdLoad(const float* values) { return { _mm256_loadu_ps(values) }; }
+	inline void SimdStore(float* output, SimdFloat value) { _mm256_storeu_ps(output, value.Value); }
+	inline SimdFloat SimdGather(const float* base, const uint32_t* indices)
+	{
+		const __m256i offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices));
+		return { _mm256_i32gather_ps(base, offsets, 4) };
+	}
+
+	// Element offsets for gathers from records of `stride` floats; load once, gather several fields.
+	struct SimdGatherIndices
+	{
+		__m256i Value;
+	};
+
+	inline SimdGatherIndices SimdLoadGatherIndices(const uint32_t* indices, uint32_t stride)
+	{
+		const __m256i loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices));
+		return { _mm256_mullo_epi32(loaded, _mm256_set1_epi32(static_cast<int>(stride))) };
+	}
+	inline SimdFloat SimdGather(const float* base, SimdGatherIndices indices) { return { _mm256_i32gather_ps(base, indices.Value, 4) }; }
+
+	// Raw 32-bit words, for records that pack 16-bit fields or indices next to their floats.
+	struct SimdWords
+	{
+		__m256i Value;
+	};
+
+	inline SimdWords SimdGatherWords(const void* base, SimdGatherIndices indices) { return { _mm256_i32gather_epi32(static_cast<const int*>(base), indices.Value, 4) }; }
+	inline SimdFloat SimdLowHalfToFloat(SimdWords words) { return { _mm256_cvtepi32_ps(_mm256_and_si256(words.Value, _mm256_set1_epi32(0xffff))) }; }
+	inline SimdFloat SimdHighHalfToFloat(SimdWords words) { return { _mm256_cvtepi32_ps(_mm256_srli_epi32(words.Value, 16)) }; }
+	inline SimdGatherIndices SimdWordsToGatherIndices(SimdWords words, uint32_t stride) { return { _mm256_mullo_epi32(words.Value, _mm256_set1_epi32(static_cast<int>(stride))) }; }
+
+	inline SimdFloat operator+(SimdFloat a, SimdFloat b) { return { _mm256_add_ps(a.Value, b.Value) }; }
+	inline SimdFloat operator-(SimdFloat a, SimdFloat b) { return { _mm256_sub_ps(a.Value, b.Value) }; }
+	inline SimdFloat operator*(SimdFloat a, SimdFloat b) { return { _mm256_mul_ps(a.Value, b.Value) }; }
+	inline SimdFloat operator/(SimdFloat a, SimdFloat b) { return { _mm256_div_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdMin(SimdFloat a, SimdFloat b) { return { _mm256_min_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdMax(SimdFloat a, SimdFloat b) { return { _mm256_max_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdAbs(SimdFloat a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.Value) }; }
+
+	inline SimdFloat SimdLess(SimdFloat a, SimdFloat b) { return { _mm256_cmp_ps(a.Value, b.Value, _CMP_LT_OQ) }; }
+	inline SimdFloat SimdLessEqual(SimdFloat a, SimdFloat b) { return { _mm256_cmp_ps(a.Value, b.Value, _CMP_LE_OQ) }; }
+	inline SimdFloat SimdGreater(SimdFloat a, SimdFloat b) { return { _mm256_cmp_ps(a.Value, b.Value, _CMP_GT_OQ) }; }
+	inline SimdFloat SimdGreaterEqual(SimdFloat a, SimdFloat b) { return { _mm256_cmp_ps(a.Value, b.Value, _CMP_GE_OQ) }; }
+
+	inline SimdFloat SimdAnd(SimdFloat a, SimdFloat b) { return { _mm256_and_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdOr(SimdFloat a, SimdFloat b) { return { _mm256_or_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdSelect(SimdFloat mask, SimdFloat whenTrue, SimdFloat whenFalse) { return { _mm256_blendv_ps(whenFalse.Value, whenTrue.Value, mask.Value) }; }
+	inline uint32_t SimdMoveMask(SimdFloat mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask.Value)); }
+
+#elif defined(FT_SIMD_SSE)
+	constexpr uint32_t SimdWidth = 4;
+
+	struct SimdFloat
+	{
+		__m128 Value;
+	};
+
+	inline SimdFloat SimdSet(float value) { return { _mm_set1_ps(value) }; }
+	inline SimdFloat SimdSetBits(uint32_t bits) { return { _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(bits))) }; }
+	inline SimdFloat SimdLoad(const float* values) { return { _mm_loadu_ps(values) }; }
+	inline void SimdStore(float* output, SimdFloat value) { _mm_storeu_ps(output, value.Value); }
+	inline SimdFloat SimdGather(const float* base, const uint32_t* indices)
+	{
+		return { _mm_setr_ps(base[indices[0]], base[indices[1]], base[indices[2]], base[indices[3]]) };
+	}
+
+	struct SimdGatherIndices
+	{
+		uint32_t Value[4];
+	};
+
+	inline SimdGatherIndices SimdLoadGatherIndices(const uint32_t* indices, uint32_t stride)
+	{
+		return { { indices[0] * stride, indices[1] * stride, indices[2] * stride, indices[3] * stride } };
+	}
+	inline SimdFloat SimdGather(const float* base, SimdGatherIndices indices) { return SimdGather(base, indices.Value); }
+
+	struct SimdWords
+	{
+		uint32_t Value[4];
+	};
+
+	inline SimdWords SimdGatherWords(const void* base, SimdGatherIndices indices)
+	{
+		SimdWords words;
+		for (uint32_t i = 0; i < 4; i++)
+			std::memcpy(&words.Value[i], static_cast<const uint32_t*>(base) + indices.Value[i], sizeof(uint32_t));
+		return words;
+	}
+	inline SimdFloat SimdLowHalfToFloat(SimdWords words)
+	{
+		const __m128i loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words.Value));
+		return { _mm_cvtepi32_ps(_mm_and_si128(loaded, _mm_set1_epi32(0xffff))) };
+	}
+	inline SimdFloat SimdHighHalfToFloat(SimdWords words)
+	{
+		const __m128i loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words.Value));
+		return { _mm_cvtepi32_ps(_mm_srli_epi32(loaded, 16)) };
+	}
+	inline SimdGatherIndices SimdWordsToGatherIndices(SimdWords words, uint32_t stride)
+	{
+		return { { words.Value[0] * stride, words.Value[1] * stride, words.Value[2] * stride, words.Value[3] * stride } };
+	}
+
+	inline SimdFloat operator+(SimdFloat a, SimdFloat b) { return { _mm_add_ps(a.Value, b.Value) }; }
+	inline SimdFloat operator-(SimdFloat a, SimdFloat b) { return { _mm_sub_ps(a.Value, b.Value) }; }
+	inline SimdFloat operator*(SimdFloat a, SimdFloat b) { return { _mm_mul_ps(a.Value, b.Value) }; }
+	inline SimdFloat operator/(SimdFloat a, SimdFloat b) { return { _mm_div_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdMin(SimdFloat a, SimdFloat b) { return { _mm_min_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdMax(SimdFloat a, SimdFloat b) { return { _mm_max_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdAbs(SimdFloat a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.Value) }; }
+
+	inline SimdFloat SimdLess(SimdFloat a, SimdFloat b) { return { _mm_cmplt_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdLessEqual(SimdFloat a, SimdFloat b) { return { _mm_cmple_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdGreater(SimdFloat a, SimdFloat b) { return { _mm_cmpgt_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdGreaterEqual(SimdFloat a, SimdFloat b) { return { _mm_cmpge_ps(a.Value, b.Value) }; }
+
+	inline SimdFloat SimdAnd(SimdFloat a, SimdFloat b) { return { _mm_and_ps(a.Value, b.Value) }; }
+	inline SimdFloat SimdOr(SimdFloat a, SimdFloat b) { return { _mm_or_ps(a.Value, b.Value) }; }
+	// SSE2 has no blendv, so select with the and/andnot/or idiom.
+	inline SimdFloat SimdSelect(SimdFloat mask, SimdFloat whenTrue, SimdFloat whenFalse)
+	{
+		return { _mm_or_ps(_mm_and_ps(mask.Value, whenTrue.Value), _mm_andnot_ps(mask.Value, whenFalse.Value)) };
+	}
+	inline uint32_t SimdMoveMask(SimdFloat mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask.Value)); }
+
+#else
+	constexpr uint32_t SimdWidth = 4;
+
+	struct SimdFloat
+	{
+		float Value[4];
+	};
+
+	namespace SimdDetail
+	{
+		inline float MaskLane(bool value) { return std::bit_cast<float>(value ? 0xffffffffu : 0u); }
+		inline uint32_t Bits(float value) { return std::bit_cast<uint32_t>(value); }
+
+		template <typename Function>
+		SimdFloat Map(SimdFloat a, SimdFloat b, Function function)
+		{
+			SimdFloat result;
+			for (uint32_t i = 0; i < 4; i++)
+				result.Value[i] = function(a.Value[i], b.Value[i]);
+			return result;
+		}
+	}
+
+	inline SimdFloat SimdSet(float value) { return { { value, value, value, value } }; }
+	inline SimdFloat SimdSetBits(uint32_t bits) { return SimdSet(std::bit_cast<float>(bits)); }
+	inline SimdFloat SimdLoad(const float* values) { return { { values[0], values[1], values[2], values[3] } }; }
+	inline void SimdStore(float* output, SimdFloat value)
+	{
+		for (uint32_t i = 0; i < 4; i++)
+			output[i] = value.Value[i];
+	}
+	inline SimdFloat SimdGather(const float* base, const uint32_t* indices)
+	{
+		return { { base[indices[0]], base[indices[1]], base[indices[2]], base[indices[3]] } };
+	}
+
+	struct SimdGatherIndices
+	{
+		uint32_t Value[4];
+	};
+
+	inline SimdGatherIndices SimdLoadGatherIndices(const uint32_t* indices, uint32_t stride)
+	{
+		return { { indices[0] * stride, indices[1] * stride, indices[2] * stride, indices[3] * stride } };
+	}
+	inline SimdFloat SimdGather(const float* base, SimdGatherIndices indices) { return SimdGather(base, indices.Value); }
+
+	struct SimdWords
+	{
+		uint32_t Value[4];
+	};
+
+	inline SimdWords SimdGatherWords(const void* base, SimdGatherIndices indices)
+	{
+		SimdWords words;
+		for (uint32_t i = 0; i < 4; i++)
+			std::memcpy(&words.Value[i], static_cast<const uint32_t*>(base) + indices.Value[i], sizeof(uint32_t));
+		return words;
+	}
+	inline SimdFloat SimdLowHalfToFloat(SimdWords words)
+	{
+		return { { static_cast<float>(words.Value[0] & 0xffffu), static_cast<float>(words.Value[1] & 0xffffu), static_cast<float>(words.Value[2] & 0xffffu), static_cast<float>(words.Value[3] & 0xffffu) } };
+	}
+	inline SimdFloat SimdHighHalfToFloat(SimdWords words)
+	{
+		return { { static_cast<float>(words.Value[0] >> 16), static_cast<float>(words.Value[1] >> 16), static_cast<float>(words.Value[2] >> 16), static_cast<float>(words.Value[3] >> 16) } };
+	}
+	inline SimdGatherIndices SimdWordsToGatherIndices(SimdWords words, uint32_t stride)
+	{
+		return { { words.Value[0] * stride, words.Value[1] * stride, words.Value[2] * stride, words.Value[3] * stride } };
+	}
+
+	inline SimdFloat operator+(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return x + y; }); }
+	inline SimdFloat operator-(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return x - y; }); }
+	inline SimdFloat operator*(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return x * y; }); }
+	inline SimdFloat operator/(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return x / y; }); }
+	// Match the SSE operand order: when either lane is NaN the second operand wins.
+	inline SimdFloat SimdMin(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return x < y ? x : y; }); }
+	inline SimdFloat SimdMax(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+	inline SimdFloat SimdAbs(SimdFloat a) { return SimdDetail::Map(a, a, [](float x, float) { return std::abs(x); }); }
+
+	inline SimdFloat SimdLess(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return SimdDetail::MaskLane(x < y); }); }
+	inline SimdFloat SimdLessEqual(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return SimdDetail::MaskLane(x <= y); }); }
+	inline SimdFloat SimdGreater(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return SimdDetail::MaskLane(x > y); }); }
+	inline SimdFloat SimdGreaterEqual(SimdFloat a, SimdFloat b) { return SimdDetail::Map(a, b, [](float x, float y) { return SimdDetail::MaskLane(x >= y); }); }
+
+	inline SimdFloat SimdAnd(SimdFloat a, SimdFloat b)
+	{
+		return SimdDetail::Map(a, b, [](float x, float y) { return std::bit_cast<float>(SimdDetail::Bits(x) & SimdDetail::Bits(y)); });
+	}
+	inline SimdFloat SimdOr(SimdFloat a, SimdFloat b)
+	{
+		return SimdDetail::Map(a, b, [](float x, float y) { return std::bit_cast<float>(SimdDetail::Bits(x) | SimdDetail::Bits(y)); });
+	}
+	inline SimdFloat SimdSelect(SimdFloat mask, SimdFloat whenTrue, SimdFloat whenFalse)
+	{
+		SimdFloat result;
+		for (uint32_t i = 0; i < 4; i++)
+			result.Value[i] = SimdDetail::Bits(mask.Value[i]) != 0 ? whenTrue.Value[i] : whenFalse.Value[i];
+		return result;
+	}
+	inline uint32_t SimdMoveMask(SimdFloat mask)
+	{
+		uint32_t bits = 0;
+		for (uint32_t i = 0; i < 4; i++)
+			bits |= (SimdDetail::Bits(mask.Value[i]) >> 31) << i;
+		return bits;
+	}
+#endif
+}